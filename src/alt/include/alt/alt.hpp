@@ -0,0 +1,534 @@
+#pragma once
+
+#include <graph/static_graph.hpp>
+#include <graph/dijkstra.hpp>
+#include <graph/bidirectional_dijkstra.hpp>
+#include <graph/multi_source_dijkstra.hpp>
+#include <graph/detail/ComplementGraph.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+// ALT: A* search with landmarks and the triangle inequality (Goldberg, Harrelson).
+// The distances from and to a few landmarks give lower bounds of the distance between any two
+// vertices, the bounds are the potentials of an A* search. The search is dijkstra on the weights
+// reduced by the potentials, so any visitor and queue of graph::dijkstra work unchanged.
+namespace alt {
+	enum class LandmarkSelection : char {
+		// uniformly random vertices
+		random,
+		// every next landmark is the vertex farthest from the chosen ones
+		farthest,
+		// Goldberg and Werneck: the leaf of the shortest path tree branch the chosen landmarks bound worst
+		avoid
+	};
+
+	// Distances from every landmark to every vertex and back, kept per vertex:
+	// From(v)[i] is the distance from landmark i to v, To(v)[i] the distance from v to landmark i.
+	// A vertex a landmark does not reach (or does not reach the landmark) gets the largest distance of
+	// the landmark's column instead of infinity, the bounds stay valid and the potentials stay consistent
+	template <typename Graph, typename IndexMap>
+	class LandmarkTables {
+	public:
+		using Vertex = typename graph::graph_traits<Graph>::vertex_descriptor;
+		using Distance = uint32_t;
+
+		LandmarkTables(const IndexMap& index, size_t verticesCount, size_t landmarksCount)
+			: index(index),
+			  landmarksCount(landmarksCount),
+			  from(verticesCount * landmarksCount, 0),
+			  to(verticesCount * landmarksCount, 0) {
+			landmarks.reserve(landmarksCount);
+		}
+
+		const std::vector<Vertex>& Landmarks() const {
+			return landmarks;
+		}
+
+		size_t LandmarksCount() const {
+			return landmarks.size();
+		}
+
+		const Distance* From(const Vertex& v) const {
+			return &from[get(index, v) * landmarksCount];
+		}
+
+		const Distance* To(const Vertex& v) const {
+			return &to[get(index, v) * landmarksCount];
+		}
+
+		// Lower bound of the distance from u to v, when v is reachable from u
+		Distance LowerBound(const Vertex& u, const Vertex& v) const {
+			int64_t bound = 0;
+			const Distance* fromU = From(u);
+			const Distance* fromV = From(v);
+			const Distance* toU = To(u);
+			const Distance* toV = To(v);
+			for (size_t i = 0; i < landmarks.size(); ++i) {
+				// d(u, L) <= d(u, v) + d(v, L)
+				bound = std::max<int64_t>(bound, int64_t(toU[i]) - toV[i]);
+				// d(L, v) <= d(L, u) + d(u, v)
+				bound = std::max<int64_t>(bound, int64_t(fromV[i]) - fromU[i]);
+			}
+			return static_cast<Distance>(bound);
+		}
+
+		// Sets the columns of the next landmarks from the trees grown by the searches,
+		// lane i of the searches is the tree of landmarks[i]
+		template <typename ForwardSearch, typename BackwardSearch>
+		void Add(const Graph& graph, const ForwardSearch& forward, const BackwardSearch& backward,
+		         const std::vector<Vertex>& batch) {
+			auto first = landmarks.size();
+			for (size_t lane = 0; lane < batch.size(); ++lane) {
+				Distance maxFrom = 0, maxTo = 0;
+				for (const auto& v : graphUtil::Range(vertices(graph))) {
+					if (forward.GetDistance(v, lane) != Infinity)
+						maxFrom = std::max(maxFrom, forward.GetDistance(v, lane));
+					if (backward.GetDistance(v, lane) != Infinity)
+						maxTo = std::max(maxTo, backward.GetDistance(v, lane));
+				}
+				for (const auto& v : graphUtil::Range(vertices(graph))) {
+					auto offset = get(index, v) * landmarksCount + first + lane;
+					from[offset] = std::min(forward.GetDistance(v, lane), maxFrom);
+					to[offset] = std::min(backward.GetDistance(v, lane), maxTo);
+				}
+			}
+			landmarks.insert(landmarks.end(), batch.begin(), batch.end());
+		}
+
+	private:
+		static constexpr Distance Infinity = std::numeric_limits<Distance>::max();
+
+		IndexMap index;
+		size_t landmarksCount;
+		std::vector<Vertex> landmarks;
+		std::vector<Distance> from;
+		std::vector<Distance> to;
+	};
+
+	namespace detail {
+		// Grows the landmark trees, four landmarks per pass over the graph and over its inverse
+		template <typename Graph, typename WeightMap, typename IndexMap>
+		class LandmarkTablesBuilder {
+		public:
+			using Vertex = typename graph::graph_traits<Graph>::vertex_descriptor;
+			using InvertedGraph = graph::ComplementGraph<Graph>;
+			static constexpr size_t Lanes = 4;
+
+			LandmarkTablesBuilder(Graph& graph, const WeightMap& weight, const IndexMap& index)
+				: graph(graph),
+				  invertedGraph(graph),
+				  forward(graph, weight, index),
+				  backward(invertedGraph, weight, index) {}
+
+			void Add(LandmarkTables<Graph, IndexMap>& tables, const std::vector<Vertex>& landmarks) {
+				for (size_t first = 0; first < landmarks.size(); first += Lanes) {
+					batch.assign(landmarks.begin() + first,
+					             landmarks.begin() + std::min(landmarks.size(), first + Lanes));
+					forward.Run(batch);
+					backward.Run(batch);
+					tables.Add(graph, forward, backward, batch);
+				}
+			}
+
+			// the tree of the last forward pass, lane 0 is the first vertex of the batch
+			const graph::MultiSourceDijkstra<Graph, WeightMap, IndexMap, Lanes>& Forward() const {
+				return forward;
+			}
+
+			graph::MultiSourceDijkstra<Graph, WeightMap, IndexMap, Lanes>& Forward() {
+				return forward;
+			}
+
+		private:
+			Graph& graph;
+			InvertedGraph invertedGraph;
+			graph::MultiSourceDijkstra<Graph, WeightMap, IndexMap, Lanes> forward;
+			graph::MultiSourceDijkstra<InvertedGraph, WeightMap, IndexMap, Lanes> backward;
+			std::vector<Vertex> batch;
+		};
+
+		template <typename Graph, typename WeightMap, typename IndexMap, typename Generator>
+		void SelectFarthest(Graph& graph, LandmarkTables<Graph, IndexMap>& tables,
+		                    LandmarkTablesBuilder<Graph, WeightMap, IndexMap>& builder,
+		                    size_t count, Generator& generator) {
+			using Vertex = typename graph::graph_traits<Graph>::vertex_descriptor;
+			using Distance = typename LandmarkTables<Graph, IndexMap>::Distance;
+			std::uniform_int_distribution<Vertex> vertexDistribution(0, num_vertices(graph) - 1);
+			// the first landmark is the vertex farthest from a random start
+			auto& search = builder.Forward();
+			search.Run({vertexDistribution(generator)});
+			auto farthest = [&](auto&& distance) {
+				Vertex best = vertexDistribution(generator);
+				Distance bestDistance = 0;
+				for (const auto& v : graphUtil::Range(vertices(graph))) {
+					auto d = distance(v);
+					if (d != std::numeric_limits<Distance>::max() && d > bestDistance) {
+						best = v;
+						bestDistance = d;
+					}
+				}
+				return best;
+			};
+			builder.Add(tables, {farthest([&](const Vertex& v) { return search.GetDistance(v, 0); })});
+			while (tables.LandmarksCount() < count) {
+				builder.Add(tables, {farthest([&](const Vertex& v) {
+					const Distance* from = tables.From(v);
+					return *std::min_element(from, from + tables.LandmarksCount());
+				})});
+			}
+		}
+
+		template <typename Graph, typename WeightMap, typename IndexMap, typename Generator>
+		void SelectAvoid(Graph& graph, IndexMap& index, LandmarkTables<Graph, IndexMap>& tables,
+		                 LandmarkTablesBuilder<Graph, WeightMap, IndexMap>& builder,
+		                 size_t count, Generator& generator) {
+			using Vertex = typename graph::graph_traits<Graph>::vertex_descriptor;
+			using Distance = typename LandmarkTables<Graph, IndexMap>::Distance;
+			const Distance infinity = std::numeric_limits<Distance>::max();
+			auto verticesCount = num_vertices(graph);
+			std::uniform_int_distribution<Vertex> vertexDistribution(0, verticesCount - 1);
+			std::vector<uint8_t> isLandmark(verticesCount, 0);
+			std::vector<Vertex> order(verticesCount);
+			std::vector<uint64_t> size(verticesCount);
+			std::vector<uint32_t> childrenOffsets(verticesCount + 1);
+			std::vector<Vertex> children(verticesCount);
+			std::vector<uint8_t> hasLandmark(verticesCount);
+			auto& search = builder.Forward();
+
+			while (tables.LandmarksCount() < count) {
+				auto root = vertexDistribution(generator);
+				search.Run({root});
+				// the weight of a vertex is the gap between its distance from the root and the lower bound
+				// of the chosen landmarks, the size of a vertex sums the weights of its subtree
+				size_t reached = 0;
+				for (const auto& v : graphUtil::Range(vertices(graph))) {
+					auto vIndex = get(index, v);
+					size[vIndex] = 0;
+					if (search.GetDistance(v, 0) == infinity)
+						continue;
+					order[reached++] = v;
+					auto bound = tables.LowerBound(root, v);
+					size[vIndex] = search.GetDistance(v, 0) - std::min(bound, search.GetDistance(v, 0));
+				}
+				std::fill(childrenOffsets.begin(), childrenOffsets.end(), 0);
+				for (size_t i = 0; i < reached; ++i) {
+					if (order[i] != root)
+						++childrenOffsets[get(index, search.GetPredecessor(order[i], 0)) + 1];
+				}
+				for (size_t i = 0; i < verticesCount; ++i) {
+					childrenOffsets[i + 1] += childrenOffsets[i];
+				}
+				auto fill = childrenOffsets;
+				for (size_t i = 0; i < reached; ++i) {
+					if (order[i] != root)
+						children[fill[get(index, search.GetPredecessor(order[i], 0))]++] = order[i];
+				}
+				// the tree from the root level by level, then the subtrees are summed up from the leaves;
+				// a subtree with a landmark in it is bounded well already and gets size 0
+				order[0] = root;
+				for (size_t head = 0, tail = 1; head < tail; ++head) {
+					auto vIndex = get(index, order[head]);
+					for (auto i = childrenOffsets[vIndex]; i < childrenOffsets[vIndex + 1]; ++i) {
+						order[tail++] = children[i];
+					}
+				}
+				std::fill(hasLandmark.begin(), hasLandmark.end(), 0);
+				for (size_t i = reached; i-- > 0;) {
+					auto vIndex = get(index, order[i]);
+					hasLandmark[vIndex] |= isLandmark[vIndex];
+					if (hasLandmark[vIndex])
+						size[vIndex] = 0;
+					if (order[i] == root)
+						continue;
+					auto parentIndex = get(index, search.GetPredecessor(order[i], 0));
+					size[parentIndex] += size[vIndex];
+					hasLandmark[parentIndex] |= hasLandmark[vIndex];
+				}
+
+				// down from the root along the largest subtrees
+				Vertex current = root;
+				if (size[get(index, root)] == 0) {
+					// the landmarks bound all the tree, a random vertex is as good as any
+					current = order[vertexDistribution(generator) % reached];
+				}
+				while (size[get(index, current)] != 0) {
+					auto cIndex = get(index, current);
+					Vertex next = current;
+					uint64_t nextSize = 0;
+					for (auto i = childrenOffsets[cIndex]; i < childrenOffsets[cIndex + 1]; ++i) {
+						if (size[get(index, children[i])] > nextSize) {
+							next = children[i];
+							nextSize = size[get(index, children[i])];
+						}
+					}
+					if (next == current)
+						break;
+					current = next;
+				}
+				if (isLandmark[get(index, current)])
+					continue;
+				isLandmark[get(index, current)] = 1;
+				builder.Add(tables, {current});
+			}
+		}
+	}
+
+	// Selects count landmarks and computes their distance tables. The graph needs its in links,
+	// the distances to the landmarks are computed on its inverse
+	template <typename Graph, typename WeightMap, typename IndexMap>
+	LandmarkTables<Graph, IndexMap> alt_preprocess(Graph& graph, WeightMap& weight, IndexMap& index,
+	                                               size_t count, LandmarkSelection selection,
+	                                               uint32_t seed = 5489u) {
+		using Vertex = typename graph::graph_traits<Graph>::vertex_descriptor;
+		count = std::min<size_t>(count, num_vertices(graph));
+		LandmarkTables<Graph, IndexMap> tables(index, num_vertices(graph), count);
+		detail::LandmarkTablesBuilder<Graph, WeightMap, IndexMap> builder(graph, weight, index);
+		std::mt19937 generator(seed);
+		switch (selection) {
+		case LandmarkSelection::random: {
+			std::vector<Vertex> all;
+			all.reserve(num_vertices(graph));
+			for (const auto& v : graphUtil::Range(vertices(graph))) {
+				all.push_back(v);
+			}
+			std::shuffle(all.begin(), all.end(), generator);
+			all.resize(count);
+			builder.Add(tables, all);
+			break;
+		}
+		case LandmarkSelection::farthest:
+			detail::SelectFarthest(graph, tables, builder, count, generator);
+			break;
+		case LandmarkSelection::avoid:
+			detail::SelectAvoid(graph, index, tables, builder, count, generator);
+			break;
+		}
+		return tables;
+	}
+
+	// The potentials of one query, computed on the first use and kept until the next Reset.
+	// The unidirectional search uses pi_t(v), the lower bound of the distance from v to t.
+	// The bidirectional one uses the average pi_t(v) - pi_s(v), which keeps both searches consistent;
+	// it is not halved, the reduced weights are doubled instead, so everything stays integral.
+	template <typename Tables>
+	class LandmarkPotential {
+	public:
+		using Vertex = typename Tables::Vertex;
+
+		explicit LandmarkPotential(const Tables& tables, size_t verticesCount)
+			: tables(tables),
+			  values(verticesCount),
+			  iterationIds(verticesCount, 0),
+			  currentIterationId(0),
+			  bidirectional(false) {}
+
+		void Reset(const Vertex& s, const Vertex& t, bool bidirectional) {
+			this->s = s;
+			this->t = t;
+			this->bidirectional = bidirectional;
+			if (currentIterationId == std::numeric_limits<uint32_t>::max()) {
+				currentIterationId = 0;
+				std::fill(iterationIds.begin(), iterationIds.end(), 0);
+			}
+			++currentIterationId;
+		}
+
+		bool IsBidirectional() const {
+			return bidirectional;
+		}
+
+		// potentials are indexed by the vertex index
+		int64_t operator()(const Vertex& v, size_t vIndex) {
+			if (iterationIds[vIndex] == currentIterationId)
+				return values[vIndex];
+			iterationIds[vIndex] = currentIterationId;
+			int64_t value = tables.LowerBound(v, t);
+			if (bidirectional)
+				value -= tables.LowerBound(s, v);
+			values[vIndex] = value;
+			return value;
+		}
+
+	private:
+		const Tables& tables;
+		std::vector<int64_t> values;
+		std::vector<uint32_t> iterationIds;
+		uint32_t currentIterationId;
+		Vertex s;
+		Vertex t;
+		bool bidirectional;
+	};
+
+	// Weight map of the search with potentials: w(u, v) - p(u) + p(v), doubled w for the
+	// bidirectional search. The same map serves both directions, the backward search walks the edges
+	// in reverse with the negated potential, which gives the same value. The potentials are consistent,
+	// so the reduced weights are never negative.
+	template <typename Graph, typename WeightMap, typename IndexMap, typename Potential>
+	class ReducedWeightMap {
+	public:
+		using key_type = typename graph::graph_traits<Graph>::edge_descriptor;
+		using value_type = uint32_t;
+		using reference = value_type;
+		using category = boost::readable_property_map_tag;
+
+		ReducedWeightMap(const Graph& graph, const WeightMap& weight, const IndexMap& index, Potential& potential)
+			: graph(&graph),
+			  weight(weight),
+			  index(index),
+			  potential(&potential) {}
+
+		value_type operator[](const key_type& edge) const {
+			auto u = source(edge, *graph);
+			auto v = target(edge, *graph);
+			int64_t scale = potential->IsBidirectional() ? 2 : 1;
+			int64_t reduced = scale * get(weight, edge) + (*potential)(v, get(index, v)) - (*potential)(u, get(index, u));
+			assert(reduced >= 0);
+			return static_cast<value_type>(reduced);
+		}
+
+	private:
+		const Graph* graph;
+		WeightMap weight;
+		IndexMap index;
+		Potential* potential;
+	};
+
+	template <typename Graph, typename WeightMap, typename IndexMap, typename Potential>
+	inline uint32_t get(const ReducedWeightMap<Graph, WeightMap, IndexMap, Potential>& pMap,
+	                    const typename ReducedWeightMap<Graph, WeightMap, IndexMap, Potential>::key_type& key) {
+		return pMap[key];
+	}
+
+	// A* from s to t: dijkstra on the reduced weights until t is settled. The distance of t is the real one,
+	// the distances of the other settled vertices are reduced by the potentials. The predecessors are exact
+	template <typename Graph, typename PredecessorMap, typename DistanceMap, typename WeightMap,
+	          typename IndexMap, typename ColorMap, typename Tables>
+	void alt_query(Graph& graph,
+	               const typename graph::graph_traits<Graph>::vertex_descriptor& s,
+	               const typename graph::graph_traits<Graph>::vertex_descriptor& t,
+	               PredecessorMap& predecessor, DistanceMap& distance, WeightMap& weight,
+	               IndexMap& index, ColorMap& color, LandmarkPotential<Tables>& potential) {
+		using Potential = LandmarkPotential<Tables>;
+		potential.Reset(s, t, false);
+		ReducedWeightMap<Graph, WeightMap, IndexMap, Potential> reducedWeight(graph, weight, index, potential);
+		graph::TargetDijkstraVisitor<Graph> visitor(t);
+		graph::dijkstra(graph, s, predecessor, distance, reducedWeight, index, color, visitor);
+		graph::EnsureVertexInitialization(graph, t, predecessor, distance, index, color, visitor);
+		auto reduced = get(distance, t);
+		if (reduced != graph::InfinityDistance<DistanceMap>())
+			put(distance, t, static_cast<uint32_t>(reduced + potential(s, get(index, s)) - potential(t, get(index, t))));
+	}
+
+	// Bidirectional A* with the average potentials, the stopping criterion of graph::bidirectional_dijkstra
+	// holds for the reduced distances. The distance and the path to t are written like by bidirectional_dijkstra
+	template <typename Graph, typename PredecessorMapF, typename PredecessorMapB,
+	          typename DistanceMapF, typename DistanceMapB, typename WeightMap,
+	          typename IndexMap, typename ColorMapF, typename ColorMapB, typename Tables,
+	          typename DijkstraVisitorF = graph::DefaultDijkstraVisitor<Graph>,
+	          typename DijkstraVisitorB = graph::DefaultDijkstraVisitor<Graph>>
+	void bidirectional_alt_query(Graph& graph,
+	                             const typename graph::graph_traits<Graph>::vertex_descriptor& s,
+	                             const typename graph::graph_traits<Graph>::vertex_descriptor& t,
+	                             PredecessorMapF& predecessorF, PredecessorMapB& predecessorB,
+	                             DistanceMapF& distanceF, DistanceMapB& distanceB, WeightMap& weight,
+	                             IndexMap& index, ColorMapF& colorF, ColorMapB& colorB,
+	                             LandmarkPotential<Tables>& potential,
+	                             DijkstraVisitorF& visitorF, DijkstraVisitorB& visitorB) {
+		using Potential = LandmarkPotential<Tables>;
+		potential.Reset(s, t, true);
+		ReducedWeightMap<Graph, WeightMap, IndexMap, Potential> reducedWeight(graph, weight, index, potential);
+		// the distance of t is written only when a path is found
+		put(distanceF, t, graph::InfinityDistance<DistanceMapF>());
+		graph::bidirectional_dijkstra(graph, s, t, predecessorF, predecessorB, distanceF, distanceB,
+		                              reducedWeight, index, colorF, colorB, visitorF, visitorB);
+		auto reduced = get(distanceF, t);
+		if (reduced != graph::InfinityDistance<DistanceMapF>())
+			put(distanceF, t, static_cast<uint32_t>(
+				(reduced + potential(s, get(index, s)) - potential(t, get(index, t))) / 2));
+	}
+
+	// The queries on a shared graph, the search state is kept in the contexts and the potentials
+	template <typename Graph, typename WeightMap, typename IndexMap, typename Tables,
+	          typename DistanceType, typename QueuePolicy>
+	void alt_query(const Graph& graph,
+	               const typename graph::graph_traits<Graph>::vertex_descriptor& s,
+	               const typename graph::graph_traits<Graph>::vertex_descriptor& t,
+	               WeightMap& weight, IndexMap& index, LandmarkPotential<Tables>& potential,
+	               graph::QueryContext<Graph, DistanceType, QueuePolicy>& context) {
+		using Potential = LandmarkPotential<Tables>;
+		potential.Reset(s, t, false);
+		ReducedWeightMap<Graph, WeightMap, IndexMap, Potential> reducedWeight(graph, weight, index, potential);
+		graph::dijkstra(graph, s, reducedWeight, index, context, graph::TargetDijkstraVisitor<Graph, QueuePolicy>(t));
+		if (context.IsReached(t)) {
+			auto reduced = get(context.Distance(), t);
+			put(context.Distance(), t, static_cast<DistanceType>(
+				reduced + potential(s, get(index, s)) - potential(t, get(index, t))));
+		}
+	}
+
+	template <typename Graph, typename WeightMap, typename IndexMap, typename Tables,
+	          typename DistanceType, typename QueuePolicy>
+	void bidirectional_alt_query(const Graph& graph,
+	                             const typename graph::graph_traits<Graph>::vertex_descriptor& s,
+	                             const typename graph::graph_traits<Graph>::vertex_descriptor& t,
+	                             WeightMap& weight, IndexMap& index, LandmarkPotential<Tables>& potential,
+	                             graph::QueryContext<Graph, DistanceType, QueuePolicy>& forward,
+	                             graph::QueryContext<Graph, DistanceType, QueuePolicy>& backward) {
+		using Potential = LandmarkPotential<Tables>;
+		using DistanceMap = typename graph::QueryContext<Graph, DistanceType, QueuePolicy>::DistanceMap;
+		potential.Reset(s, t, true);
+		ReducedWeightMap<Graph, WeightMap, IndexMap, Potential> reducedWeight(graph, weight, index, potential);
+		put(forward.Distance(), t, graph::InfinityDistance<DistanceMap>());
+		graph::bidirectional_dijkstra(graph, s, t, reducedWeight, index, forward, backward);
+		auto reduced = get(forward.Distance(), t);
+		if (reduced != graph::InfinityDistance<DistanceMap>())
+			put(forward.Distance(), t, static_cast<DistanceType>(
+				(reduced + potential(s, get(index, s)) - potential(t, get(index, t))) / 2));
+	}
+
+	// Engine of graph::BatchQueryExecutor, see graph/batch_query.hpp, runs the bidirectional query
+	template <typename Graph, typename WeightMap, typename IndexMap, typename Tables,
+	          typename QueuePolicy = graph::queue::DijkstraQueuePolicy>
+	class ALTQueryEngine {
+		using SearchContext = graph::QueryContext<Graph, uint32_t, QueuePolicy>;
+	public:
+		using Vertex = typename graph::graph_traits<Graph>::vertex_descriptor;
+		using Distance = uint32_t;
+		struct Context {
+			SearchContext Forward;
+			SearchContext Backward;
+			LandmarkPotential<Tables> Potential;
+		};
+
+		ALTQueryEngine(const Graph& graph, const WeightMap& weight, const IndexMap& index, const Tables& tables)
+			: graph(graph),
+			  weight(weight),
+			  index(index),
+			  tables(tables) {}
+
+		Context CreateContext() const {
+			return Context{SearchContext(graph, index), SearchContext(graph, index),
+			               LandmarkPotential<Tables>(tables, num_vertices(graph))};
+		}
+
+		Distance Query(Context& context, const Vertex& s, const Vertex& t) const {
+			bidirectional_alt_query(graph, s, t, weight, index, context.Potential,
+			                        context.Forward, context.Backward);
+			return get(context.Forward.Distance(), t);
+		}
+
+		void Path(Context& context, const Vertex& s, const Vertex& t, std::vector<Vertex>& path) const {
+			context.Forward.Path(s, t, path);
+		}
+
+	private:
+		const Graph& graph;
+		WeightMap weight;
+		IndexMap index;
+		const Tables& tables;
+	};
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <util/statistics.h>
+#include <alt/alt.hpp>
+
+using util::statistics::GeneralStatistics;
+
+// found by the argument lookup from the statistics fields
+namespace alt {
+
+std::ostream& operator<<(std::ostream& osm, const LandmarkSelection& arg) {
+    switch (arg) {
+    case LandmarkSelection::random:
+        osm << "random";
+        break;
+    case LandmarkSelection::farthest:
+        osm << "farthest";
+        break;
+    case LandmarkSelection::avoid:
+        osm << "avoid";
+        break;
+    default:
+        osm << "Unknown selection";
+        break;
+    };
+    return osm;
+}
+
+} //alt
+
+namespace util {
+namespace statistics {
+
+enum class ALTNames:char {
+    source,
+    target,
+    distance,
+    landmarks,
+    selection
+};
+
+std::ostream& operator<<(std::ostream& osm, const ALTNames& arg) {
+    switch (arg) {
+    case ALTNames::source:
+        osm << "source";
+        break;
+    case ALTNames::target:
+        osm << "target";
+        break;
+    case ALTNames::distance:
+        osm << "distance";
+        break;
+    case ALTNames::landmarks:
+        osm << "landmarks";
+        break;
+    case ALTNames::selection:
+        osm << "selection";
+        break;
+
+    default:
+        osm << "Unknown column";
+        break;
+    };
+    return osm;
+};
+
+struct ALTMetricStatistics : GeneralStatistics {
+    ALTMetricStatistics(const GeneralStatistics& base, size_t landmarks, alt::LandmarkSelection selection)
+        :GeneralStatistics(base), landmarks(ALTNames::landmarks, landmarks),
+        selection(ALTNames::selection, selection) {};
+    StatisticsField<ALTNames, size_t> landmarks;
+    StatisticsField<ALTNames, alt::LandmarkSelection> selection;
+};
+
+
+std::ostream& operator<<(std::ostream& osm, const ALTMetricStatistics& arg) {
+    osm << static_cast<GeneralStatistics>(arg) << '\t' << arg.landmarks << '\t' <<
+        arg.selection;
+    return osm;
+};
+
+struct ALTQueryStatistic : ALTMetricStatistics {
+    ALTQueryStatistic(const ALTMetricStatistics& base,
+        size_t source, size_t target, size_t distance)
+        :ALTMetricStatistics(base), source(ALTNames::source,source),
+        target(ALTNames::target,target),distance(ALTNames::distance,distance) {};
+    StatisticsField<ALTNames,size_t> source;
+    StatisticsField<ALTNames,size_t> target;
+    StatisticsField<ALTNames,size_t> distance;
+};
+
+
+std::ostream& operator<<(std::ostream& osm, const ALTQueryStatistic& arg) {
+    osm << static_cast<ALTMetricStatistics>(arg) << '\t' << arg.source << '\t' <<
+        arg.target << '\t' << arg.distance;
+    return osm;
+};
+
+
+
+} //statistic
+} //util
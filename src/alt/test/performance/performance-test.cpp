@@ -0,0 +1,171 @@
+#include <type_traits>
+#include <utility>
+#include <cassert>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <graph/io.hpp>
+#include <graph/bidirectional_dijkstra.hpp>
+#include <graph/batch_query.hpp>
+#include <alt/alt.hpp>
+#include <test.h>
+
+using namespace std;
+using namespace graph;
+using namespace alt;
+using namespace util::statistics;
+
+struct distanceF_t {};
+struct distanceB_t {};
+struct colorF_t {};
+struct colorB_t {};
+struct predecessorF_t {};
+struct predecessorB_t {};
+struct weight_t {};
+
+std::string baseFileName(const std::string& path) {
+    std::string str = path.substr(path.find_last_of("/\\") + 1);
+    std::string::size_type const p(str.find_last_of('.'));
+    std::string base = str.substr(0, p);
+    return base;
+}
+
+char* globalPathToFiles = nullptr;
+
+class DdsgGraphAlgorithm : public ::testing::TestWithParam<tuple<const char*, size_t, LandmarkSelection>> {
+protected:
+    DdsgGraphAlgorithm()
+        :m_ddsgVecBackInserter(m_ddsgVec), m_path(globalPathToFiles),
+        m_fileName(get<0>(GetParam())), m_baseName(baseFileName(m_fileName)),
+        m_landmarks(get<1>(GetParam())), m_selection(get<2>(GetParam())) {};
+    virtual void SetUp() {
+        if (read_ddsg<Property<weight_t, uint32_t>>(m_ddsgVecBackInserter, m_numOfNodes, m_numOfEdges,
+                (m_path + "/" + m_fileName).c_str()))
+            FAIL();
+        std::sort(m_ddsgVec.begin(), m_ddsgVec.end(),
+            [&](DdsgVecType::value_type left, DdsgVecType::value_type right) {
+            return left.first.first < right.first.first;
+        });
+        m_statistics.open("statistics", std::ofstream::out | std::ofstream::app);
+    };
+    virtual void TearDown() {
+        m_statistics.close();
+    }
+    using DdsgVecType = std::vector<std::pair<std::pair<size_t, size_t>, Properties<Property<weight_t, uint32_t>>>>;
+    DdsgVecType m_ddsgVec;
+    back_insert_iterator<DdsgVecType> m_ddsgVecBackInserter;
+    string m_path;
+    string m_fileName;
+    string m_baseName;
+    size_t m_landmarks;
+    LandmarkSelection m_selection;
+    size_t m_numOfNodes;
+    size_t m_numOfEdges;
+    ofstream m_statistics;
+};
+
+TEST_P(DdsgGraphAlgorithm, ALT) {
+    using Graph = GenerateBiDijkstraGraph<predecessorF_t, predecessorB_t, distanceF_t, distanceB_t,
+        weight_t, vertex_index_t, colorF_t, colorB_t, Properties<>, Properties<>>::type;
+    using Vertex = graph_traits<Graph>::vertex_descriptor;
+    std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+    Graph graph(m_ddsgVec.begin(), m_ddsgVec.end(), m_numOfNodes, m_numOfEdges);
+    auto predecessorF = graph::get(predecessorF_t(), graph);
+    auto predecessorB = graph::get(predecessorB_t(), graph);
+    auto distanceF = graph::get(distanceF_t(), graph);
+    auto distanceB = graph::get(distanceB_t(), graph);
+    auto weight = graph::get(weight_t(), graph);
+    auto vertex_index = graph::get(vertex_index_t(), graph);
+    auto colorF = graph::get(colorF_t(), graph);
+    auto colorB = graph::get(colorB_t(), graph);
+
+    start = std::chrono::high_resolution_clock::now();
+    auto tables = alt_preprocess(graph, weight, vertex_index, m_landmarks, m_selection);
+    end = std::chrono::high_resolution_clock::now();
+    ALTMetricStatistics statistics(
+        GeneralStatistics(m_baseName, Algorithm::ALT, Phase::metric, Metric::time,
+            m_numOfNodes, m_numOfEdges,
+            chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0),
+        m_landmarks, m_selection);
+    m_statistics << statistics << endl;
+
+    stringstream ss;
+    ss << m_path << "/" << m_baseName << "/" << m_baseName << ".ppsp";
+    ifstream verificationFile;
+    verificationFile.open(ss.str());
+    if (!verificationFile.is_open()) {
+        cerr << "Verification file " << ss.str() << " is not found." << endl;
+        FAIL();
+    };
+    size_t src, tgt, dis;
+    vector<pair<Vertex, Vertex>> queries;
+    vector<uint32_t> expected;
+
+    LandmarkPotential<decltype(tables)> potential(tables, num_vertices(graph));
+    DefaultDijkstraVisitor<Graph> visitorF;
+    DefaultDijkstraVisitor<Graph> visitorB;
+    while (verificationFile >> src >> tgt >> dis) {
+        queries.push_back(make_pair(src, tgt));
+        expected.push_back(dis);
+
+        start = std::chrono::high_resolution_clock::now();
+        alt_query(graph, Vertex(src), Vertex(tgt), predecessorF, distanceF, weight, vertex_index, colorF,
+            potential);
+        end = std::chrono::high_resolution_clock::now();
+        EXPECT_EQ(dis, get(distanceF, tgt));
+        ALTQueryStatistic unidirectional(
+            ALTMetricStatistics(
+                GeneralStatistics(m_baseName, Algorithm::ALT, Phase::query, Metric::time,
+                    m_numOfNodes, m_numOfEdges,
+                    chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0),
+                m_landmarks, m_selection),
+            src, tgt, get(distanceF, tgt));
+        m_statistics << unidirectional << endl;
+
+        start = std::chrono::high_resolution_clock::now();
+        bidirectional_alt_query(graph, Vertex(src), Vertex(tgt), predecessorF, predecessorB,
+            distanceF, distanceB, weight, vertex_index, colorF, colorB, potential, visitorF, visitorB);
+        end = std::chrono::high_resolution_clock::now();
+        EXPECT_EQ(dis, get(distanceF, tgt));
+        ALTQueryStatistic bidirectional(
+            ALTMetricStatistics(
+                GeneralStatistics(m_baseName, Algorithm::ALT, Phase::query, Metric::time,
+                    m_numOfNodes, m_numOfEdges,
+                    chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0),
+                m_landmarks, m_selection),
+            src, tgt, get(distanceF, tgt));
+        m_statistics << bidirectional << endl;
+    }
+    verificationFile.close();
+
+    // the same queries in one batch on all cores
+    const Graph& sharedGraph = graph;
+    using Engine = ALTQueryEngine<Graph, decltype(weight), decltype(vertex_index), decltype(tables)>;
+    BatchQueryExecutor<Engine> executor(Engine(sharedGraph, weight, vertex_index, tables));
+    auto result = executor.Run(queries);
+    BatchQueryStatistics batchStatistics(
+        GeneralStatistics(m_baseName, Algorithm::ALT, Phase::query, Metric::time,
+            m_numOfNodes, m_numOfEdges, result.WallTime / 1000000, 0),
+        executor.ThreadsCount(), result.Throughput(), result.Latencies);
+    m_statistics << batchStatistics << endl;
+    cout << batchStatistics << endl;
+    EXPECT_EQ(expected, result.Distances);
+};
+
+
+INSTANTIATE_TEST_CASE_P(CommandLine, DdsgGraphAlgorithm,
+    ::testing::Combine(::testing::Values("deu.ddsg"), ::testing::Values(size_t(16)),
+        ::testing::Values(LandmarkSelection::random, LandmarkSelection::farthest, LandmarkSelection::avoid)));
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc >= 2) globalPathToFiles = argv[1];
+    else {
+        cerr << "Path to the folder with .ddsg graphs is required" << endl;
+        return 1;
+    };
+
+    return RUN_ALL_TESTS();
+};
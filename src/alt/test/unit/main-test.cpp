@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <graph/static_graph.hpp>
+#include <graph/bidirectional_dijkstra.hpp>
+#include <alt/alt.hpp>
+#include <util/random_graph.h>
+
+using namespace std;
+using namespace graph;
+using namespace alt;
+
+struct distance_t {};
+struct distanceB_t {};
+struct color_t {};
+struct colorB_t {};
+struct predecessor_t {};
+struct predecessorB_t {};
+struct weight_t {};
+
+using Graph = GenerateBiDijkstraGraph<predecessor_t, predecessorB_t, distance_t, distanceB_t,
+    weight_t, vertex_index_t, color_t, colorB_t, Properties<>, Properties<>>::type;
+using Vertex = graph_traits<Graph>::vertex_descriptor;
+
+// A strongly connected ring with random chords, a few vertices only leave it and a few only enter it
+std::unique_ptr<Graph> MakeGraph(size_t n) {
+    util::WeightedEdges<weight_t> input;
+    mt19937 generator(29);
+    uniform_int_distribution<size_t> vertexDistribution(0, n - 11);
+    uniform_int_distribution<uint32_t> weightDistribution(1, 100);
+    auto weightOf = [&](size_t, mt19937& generator) { return weightDistribution(generator); };
+    util::AddRing(input, n - 10, generator, weightOf);
+    util::AddRandomEdges(input, n - 10, 2 * n, generator, weightOf);
+    auto addEdge = [&](size_t from, size_t to) {
+        input.push_back(make_pair(make_pair(from, to),
+            graph::make_properties(Property<weight_t, uint32_t>(weightDistribution(generator)))));
+    };
+    for (size_t v = n - 10; v < n - 5; ++v) {
+        addEdge(vertexDistribution(generator), v);
+    }
+    for (size_t v = n - 5; v < n; ++v) {
+        addEdge(v, vertexDistribution(generator));
+    }
+    std::stable_sort(input.begin(), input.end(), [](const auto& left, const auto& right) {
+        return left.first.first < right.first.first;
+    });
+    return std::make_unique<Graph>(input.begin(), input.end(), n, input.size());
+}
+
+TEST(ALT, QueriesMatchDijkstra) {
+    const size_t n = 800;
+    auto graph = MakeGraph(n);
+    auto& g = *graph;
+    auto predecessor = graph::get(predecessor_t(), g);
+    auto predecessorB = graph::get(predecessorB_t(), g);
+    auto distance = graph::get(distance_t(), g);
+    auto distanceB = graph::get(distanceB_t(), g);
+    auto weight = graph::get(weight_t(), g);
+    auto index = graph::get(vertex_index_t(), g);
+    auto color = graph::get(color_t(), g);
+    auto colorB = graph::get(colorB_t(), g);
+
+    vector<vector<uint32_t>> expected(n);
+    DefaultDijkstraVisitor<Graph> visitor;
+    for (Vertex s = 0; s < n; s += 23) {
+        dijkstra(g, s, predecessor, distance, weight, index, color, visitor);
+        for (Vertex t = 0; t < n; ++t) {
+            EnsureVertexInitialization(g, t, predecessor, distance, index, color, visitor);
+            expected[s].push_back(graph::get(distance, t));
+        }
+    }
+
+    for (auto selection : {LandmarkSelection::random, LandmarkSelection::farthest, LandmarkSelection::avoid}) {
+        auto tables = alt_preprocess(g, weight, index, 6, selection);
+        EXPECT_EQ(6, tables.LandmarksCount());
+        LandmarkPotential<decltype(tables)> potential(tables, n);
+        QueryContext<Graph> forward(g);
+        QueryContext<Graph> backward(g);
+        DefaultDijkstraVisitor<Graph> visitorF;
+        DefaultDijkstraVisitor<Graph> visitorB;
+        for (Vertex s = 0; s < n; s += 23) {
+            for (Vertex t = 0; t < n; t += 7) {
+                auto d = expected[s][t];
+                if (d != InfinityDistance<decltype(distance)>()) {
+                    EXPECT_LE(tables.LowerBound(s, t), d);
+                }
+
+                alt_query(g, s, t, predecessor, distance, weight, index, color, potential);
+                EXPECT_EQ(d, graph::get(distance, t));
+                bidirectional_alt_query(g, s, t, predecessor, predecessorB, distance, distanceB, weight,
+                    index, color, colorB, potential, visitorF, visitorB);
+                EXPECT_EQ(d, graph::get(distance, t));
+
+                alt_query(static_cast<const Graph&>(g), s, t, weight, index, potential, forward);
+                EXPECT_EQ(d, forward.IsReached(t) ? graph::get(forward.Distance(), t) : InfinityDistance<decltype(distance)>());
+                bidirectional_alt_query(static_cast<const Graph&>(g), s, t, weight, index, potential,
+                    forward, backward);
+                EXPECT_EQ(d, graph::get(forward.Distance(), t));
+                if (d != InfinityDistance<decltype(distance)>()) {
+                    // the path is a shortest one
+                    vector<Vertex> path;
+                    forward.Path(s, t, path);
+                    uint32_t length = 0;
+                    for (size_t i = 0; i + 1 < path.size(); ++i) {
+                        uint32_t best = InfinityDistance<decltype(distance)>();
+                        for (auto e : graphUtil::Range(out_edges(path[i], g))) {
+                            if (target(e, g) == path[i + 1])
+                                best = std::min(best, graph::get(weight, e));
+                        }
+                        length += best;
+                    }
+                    EXPECT_EQ(d, length);
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
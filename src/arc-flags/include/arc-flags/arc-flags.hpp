@@ -5,6 +5,7 @@
 #include <cstdio>
 #include <graph/static_graph.hpp>
 #include <graph/dijkstra.hpp>
+#include <graph/multi_source_dijkstra.hpp>
 #include <arc-flags/Bitset.hpp>
 #include <graph/io/FileReader.hpp>
 #include <graph/graph.hpp>
@@ -16,15 +17,17 @@ namespace arcflags {
 	template <typename PredecessorMapTag, class DisanceMapTag, typename WeightMapTag,
 			  typename IndexMapTag, typename ColorMapTag, typename ArcFlagsMapTag,
 			  typename PartitionMapTag, size_t N,
-			  typename BundledVertexProperties, typename BundledEdgeProperties>
+			  typename BundledVertexProperties, typename BundledEdgeProperties,
+			  typename Layout = graph::ColumnLayoutTag, typename Links = graph::BidirectionalLinksTag>
 	struct GenerateArcFlagsGraph {};
 
 	template <typename PredecessorMapTag, class DisanceMapTag, typename WeightMapTag,
 			  typename IndexMapTag, typename ColorMapTag, typename ArcFlagsMapTag,
-			  typename PartitionMapTag, size_t N, typename... P1s, typename... P2s>
+			  typename PartitionMapTag, size_t N, typename... P1s, typename... P2s,
+			  typename Layout, typename Links>
 	struct GenerateArcFlagsGraph<PredecessorMapTag, DisanceMapTag, WeightMapTag,
 								 IndexMapTag, ColorMapTag, ArcFlagsMapTag, PartitionMapTag, N,
-								 graph::Properties<P1s...>, graph::Properties<P2s...>> {
+								 graph::Properties<P1s...>, graph::Properties<P2s...>, Layout, Links> {
 		using type = graph::StaticGraph<
 			graph::Properties<
 				graph::Property<PredecessorMapTag,
@@ -36,7 +39,9 @@ namespace arcflags {
 			graph::Properties<
 				graph::Property<WeightMapTag, uint32_t>,
 				graph::Property<ArcFlagsMapTag, bitset::Bitset<N>>,
-				P2s...>>;
+				P2s...>,
+			Layout,
+			Links>;
 	};
 
 	// read partitionining from a file
@@ -115,7 +120,9 @@ namespace arcflags {
 	}
 
 
-	// uses dijkstra, therefore should have at least all property maps used by dijkstra
+	// uses dijkstra, therefore should have at least all property maps used by dijkstra.
+	// The searches run on the ComplementGraph, so the graph needs its in links: a forward-only
+	// query graph is copied from the preprocessed one, see ForwardStaticGraph
 	template <size_t N, typename Graph, typename PredecessorMap, typename DistanceMap,
 			  typename WeightMap, typename IndexMap, typename ColorMap, typename PartitionMap,
 			  typename ArcFlagsMap>
@@ -168,14 +175,55 @@ namespace arcflags {
 		//printf("%d\n", borderCnt);
 	};
 
-	template <typename Graph, typename ArcFlagsMap, typename PartitionMap>
-	struct ArcflagsQueryDijkstraVisitor : public graph::DefaultDijkstraVisitor<Graph> {
+	// arcflags_preprocess growing the trees of Lanes boundary vertices at once with graph::MultiSourceDijkstra,
+	// one pass over the graph sets the flags of all the cells of the batch. Needs no search property maps.
+	template <size_t N, size_t Lanes = 16, typename Graph, typename WeightMap, typename IndexMap,
+			  typename PartitionMap, typename ArcFlagsMap>
+	void arcflags_preprocess_batched(Graph& graph, WeightMap& weight, IndexMap& index,
+									 PartitionMap& partition, ArcFlagsMap& arcflags) {
+		using InvertedGraph = graph::ComplementGraph<Graph>;
+		using Vertex = typename graph::graph_traits<Graph>::vertex_descriptor;
+		InvertedGraph invertedGraph(graph);
+		std::vector<Vertex> borderVertices;
+		for (const auto& v : graphUtil::Range(graph::vertices(invertedGraph))) {
+			auto vPartIndex = get(partition, v);
+			auto borderVertex = false;
+			for (const auto& edge : graphUtil::Range(graph::out_edges(v, invertedGraph))) {
+				if (get(partition, target(edge, invertedGraph)) == vPartIndex) {
+					auto& bitset = get(arcflags, edge);
+					bitset.SetBit(vPartIndex);
+				}
+				else {
+					borderVertex = true;
+				}
+			}
+			if (borderVertex)
+				borderVertices.push_back(v);
+		}
+
+		graph::MultiSourceDijkstra<InvertedGraph, WeightMap, IndexMap, Lanes> search(invertedGraph, weight, index);
+		std::vector<Vertex> sources;
+		for (size_t first = 0; first < borderVertices.size(); first += Lanes) {
+			sources.assign(borderVertices.begin() + first,
+						   borderVertices.begin() + std::min(borderVertices.size(), first + Lanes));
+			search.Run(sources);
+			search.ForEachTreeEdge([&](const auto& edge, auto mask) {
+				auto& bitset = get(arcflags, edge);
+				for (; mask != 0; mask &= mask - 1) {
+					bitset.SetBit(get(partition, sources[__builtin_ctz(mask)]));
+				}
+			});
+		}
+	};
+
+	template <typename Graph, typename ArcFlagsMap, typename PartitionMap,
+			  typename QueuePolicy = graph::queue::DijkstraQueuePolicy>
+	struct ArcflagsQueryDijkstraVisitor : public graph::DefaultDijkstraVisitor<Graph, QueuePolicy> {
 		ArcflagsQueryDijkstraVisitor(const ArcFlagsMap& arcflags, size_t targetPart)
 			: arcflags(arcflags),
 			  targetPart(targetPart) { }
 
-		bool should_relax(const typename graph::graph_traits<Graph>::edge_descriptor& edge, Graph& graph) {
-			auto to = target(edge, graph);
+		bool should_relax(const typename graph::graph_traits<Graph>::edge_descriptor& edge, const Graph& graph) {
 			auto& bitset = get(arcflags, edge);
 			return bitset.GetBit(targetPart);
 		}
@@ -203,4 +251,55 @@ namespace arcflags {
 						ArcFlagsMap& arcflags, ArcFlagsVisitor&& visitor) {
 		graph::dijkstra(graph, s, predecessor, distance, weight, index, color, visitor);
 	};
+
+	// The query on a shared graph, the search state is kept in the context
+	template <typename Graph, typename WeightMap, typename IndexMap, typename PartitionMap,
+			  typename ArcFlagsMap, typename DistanceType, typename QueuePolicy>
+	void arcflags_query(const Graph& graph,
+						const typename graph::graph_traits<Graph>::vertex_descriptor& s,
+						const typename graph::graph_traits<Graph>::vertex_descriptor& t,
+						WeightMap& weight, IndexMap& index, PartitionMap& partition, ArcFlagsMap& arcflags,
+						graph::QueryContext<Graph, DistanceType, QueuePolicy>& context) {
+		graph::dijkstra(graph, s, weight, index, context,
+						ArcflagsQueryDijkstraVisitor<Graph, ArcFlagsMap, PartitionMap, QueuePolicy>(arcflags, get(partition, t)));
+	};
+
+	// Engine of graph::BatchQueryExecutor, see graph/batch_query.hpp
+	template <typename Graph, typename WeightMap, typename IndexMap, typename PartitionMap, typename ArcFlagsMap,
+			  typename QueuePolicy = graph::queue::DijkstraQueuePolicy>
+	class ArcFlagsQueryEngine {
+	public:
+		using Vertex = typename graph::graph_traits<Graph>::vertex_descriptor;
+		using Distance = uint32_t;
+		using Context = graph::QueryContext<Graph, Distance, QueuePolicy>;
+
+		ArcFlagsQueryEngine(const Graph& graph, const WeightMap& weight, const IndexMap& index,
+							const PartitionMap& partition, const ArcFlagsMap& arcflags)
+			: graph(graph),
+			  weight(weight),
+			  index(index),
+			  partition(partition),
+			  arcflags(arcflags) {}
+
+		Context CreateContext() const {
+			return Context(graph, index);
+		}
+
+		Distance Query(Context& context, const Vertex& s, const Vertex& t) const {
+			arcflags_query(graph, s, t, weight, index, partition, arcflags, context);
+			return context.IsReached(t) ? get(context.Distance(), t)
+										: graph::InfinityDistance<typename Context::DistanceMap>();
+		}
+
+		void Path(Context& context, const Vertex& s, const Vertex& t, std::vector<Vertex>& path) const {
+			context.Path(s, t, path);
+		}
+
+	private:
+		const Graph& graph;
+		WeightMap weight;
+		IndexMap index;
+		PartitionMap partition;
+		ArcFlagsMap arcflags;
+	};
 };
@@ -20,7 +20,8 @@ namespace arcflags
 	          typename ColorMapFTag, typename ColorMapBTag,
 	          typename ArcFlagsMapFTag, typename ArcFlagsMapBTag,
 	          typename PartitionMapTag, size_t N,
-	          typename BundledVertexProperties, typename BundledEdgeProperties>
+	          typename BundledVertexProperties, typename BundledEdgeProperties,
+	          typename Layout = graph::ColumnLayoutTag>
 	struct GenerateBiArcFlagsGraph
 	{
 	};
@@ -31,14 +32,14 @@ namespace arcflags
 	          typename ColorMapFTag, typename ColorMapBTag,
 	          typename ArcFlagsMapFTag, typename ArcFlagsMapBTag,
 	          typename PartitionMapTag, size_t N,
-	          typename... P1s, typename... P2s>
+	          typename... P1s, typename... P2s, typename Layout>
 	struct GenerateBiArcFlagsGraph<PredecessorMapFTag, PredecessorMapBTag,
 	                             DistanceMapFTag, DistanceMapBTag,
 	                             WeightMapTag, IndexMapTag,
 	                             ColorMapFTag, ColorMapBTag,
 	                             ArcFlagsMapFTag, ArcFlagsMapBTag,
 	                             PartitionMapTag, N,
-	                             graph::Properties<P1s...>, graph::Properties<P2s...>>
+	                             graph::Properties<P1s...>, graph::Properties<P2s...>, Layout>
 	{
 		using type = graph::StaticGraph<
 			graph::Properties<
@@ -56,7 +57,8 @@ namespace arcflags
 				graph::Property<WeightMapTag, uint32_t>,
 				graph::Property<ArcFlagsMapFTag, bitset::Bitset<N>>,
 				graph::Property<ArcFlagsMapBTag, bitset::Bitset<N>>,
-				P2s...>>;
+				P2s...>,
+			Layout>;
 	};
 
 	template <size_t N, typename Graph, typename ArcFlagsMapF, typename ArcFlagsMapB>
@@ -13,6 +13,8 @@
 #include <graph/io.hpp>
 #include <arc-flags/arc-flags.hpp>
 #include <arc-flags/bidirectionalArcflags.hpp>
+#include <graph/batch_query.hpp>
+#include <graph/search_counters.hpp>
 #include <fstream>
 #include <test.h>
 
@@ -128,6 +130,22 @@ TEST_P(DdsgGraphAlgorithm, ArcFlags) {
 	cout << "Reducing arc-flags by " << m_filter * 100 << "%" << endl;
 	arcflags_reduce_greedy<N::value>(graph, arc_flags, m_filter);
 
+	// queries never look at the in edges
+	using QueryGraph = GenerateArcFlagsGraph<predecessor_t, distance_t, weight_t,
+		vertex_index_t, color_t, arc_flags_t, partition_t, N::value,
+		Properties<>, Properties<>, ColumnLayoutTag, ForwardLinksTag>::type;
+	QueryGraph queryGraph(graph);
+	auto queryPredecessor = graph::get(predecessor_t(), queryGraph);
+	auto queryDistance = graph::get(distance_t(), queryGraph);
+	auto queryWeight = graph::get(weight_t(), queryGraph);
+	auto queryVertexIndex = graph::get(vertex_index_t(), queryGraph);
+	auto queryColor = graph::get(color_t(), queryGraph);
+	auto queryPartition = graph::get(partition_t(), queryGraph);
+	auto queryArcFlags = graph::get(arc_flags_t(), queryGraph);
+	// the same queries with the search state outside of the graph
+	const QueryGraph& sharedGraph = queryGraph;
+	QueryContext<QueryGraph> context(sharedGraph);
+
 	cout << "Running queries..." << endl;
     ifstream verificationFile;    
     ss.str(string());
@@ -142,24 +160,99 @@ TEST_P(DdsgGraphAlgorithm, ArcFlags) {
     while (verificationFile >> src >> tgt >> dis) {
         cout << "Running ArcFlags query from " << src << " to " << tgt << endl;
         start = std::chrono::high_resolution_clock::now();
-		auto visitor = CreateDefaultArcFlagsVisitor(graph, graph_traits<Graph>::vertex_descriptor(tgt), partition, arc_flags);
-        arcflags_query<N::value>(graph,
-            graph_traits<Graph>::vertex_descriptor(src),
-            graph_traits<Graph>::vertex_descriptor(tgt),
-            predecessor, distance, weight, vertex_index,
-            color, partition, arc_flags, visitor);
+		CountingDijkstraVisitor<QueryGraph, ArcflagsQueryDijkstraVisitor<QueryGraph,
+			decltype(queryArcFlags), decltype(queryPartition)>> visitor(queryArcFlags, get(queryPartition, tgt));
+        arcflags_query<N::value>(queryGraph,
+            graph_traits<QueryGraph>::vertex_descriptor(src),
+            graph_traits<QueryGraph>::vertex_descriptor(tgt),
+            queryPredecessor, queryDistance, queryWeight, queryVertexIndex,
+            queryColor, queryPartition, queryArcFlags, visitor);
         end = std::chrono::high_resolution_clock::now();
-        ArcFlagsQueryStatistic statistics(
-            ArcFlagsMetricStatistics(
-                GeneralStatistics(m_baseName, Algorithm::arcFlags, Phase::query, Metric::time,
-                    m_numOfNodes, m_numOfEdges,
-                    chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0),
-                N::value, m_filter), src, tgt, get(distance, tgt)
-            );
+        SearchSpaceStatistics<ArcFlagsQueryStatistic> statistics(
+            ArcFlagsQueryStatistic(
+                ArcFlagsMetricStatistics(
+                    GeneralStatistics(m_baseName, Algorithm::arcFlags, Phase::query, Metric::time,
+                        m_numOfNodes, m_numOfEdges,
+                        chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0),
+                    N::value, m_filter), src, tgt, get(queryDistance, tgt)),
+            visitor.GetCounters());
         m_statistics << statistics << endl;
-        EXPECT_EQ(dis, get(distance, tgt));
+        EXPECT_EQ(dis, get(queryDistance, tgt));
+        arcflags_query(sharedGraph,
+            graph_traits<QueryGraph>::vertex_descriptor(src),
+            graph_traits<QueryGraph>::vertex_descriptor(tgt),
+            queryWeight, queryVertexIndex, queryPartition, queryArcFlags, context);
+        EXPECT_EQ(dis, get(context.Distance(), tgt));
     }
     verificationFile.close();
+
+    // the same queries in one batch on all cores
+    vector<pair<graph_traits<QueryGraph>::vertex_descriptor, graph_traits<QueryGraph>::vertex_descriptor>> queries;
+    vector<uint32_t> expected;
+    verificationFile.open(ss.str());
+    while (verificationFile >> src >> tgt >> dis) {
+        queries.push_back(make_pair(src, tgt));
+        expected.push_back(dis);
+    }
+    verificationFile.close();
+    using Engine = ArcFlagsQueryEngine<QueryGraph, decltype(queryWeight), decltype(queryVertexIndex),
+        decltype(queryPartition), decltype(queryArcFlags)>;
+    BatchQueryExecutor<Engine> executor(
+        Engine(sharedGraph, queryWeight, queryVertexIndex, queryPartition, queryArcFlags));
+    auto result = executor.Run(queries);
+    BatchQueryStatistics batchStatistics(
+        GeneralStatistics(m_baseName, Algorithm::arcFlags, Phase::query, Metric::time,
+            m_numOfNodes, m_numOfEdges, result.WallTime / 1000000, 0),
+        executor.ThreadsCount(), result.Throughput(), result.Latencies);
+    m_statistics << batchStatistics << endl;
+    cout << batchStatistics << endl;
+    EXPECT_EQ(expected, result.Distances);
+};
+
+TEST_P(DdsgGraphAlgorithm, ArcFlagsBatchedPreprocessing) {
+    using Graph = GenerateArcFlagsGraph<predecessor_t, distance_t, weight_t,
+        vertex_index_t, color_t, arc_flags_t, partition_t, N::value,
+        Properties<>, Properties< >> ::type;
+    Graph graph(m_ddsgVec.begin(), m_ddsgVec.end(), m_numOfNodes, m_numOfEdges);
+    auto weight = graph::get(weight_t(), graph);
+    auto vertex_index = graph::get(vertex_index_t(), graph);
+    auto partition = graph::get(partition_t(), graph);
+    auto arc_flags = graph::get(arc_flags_t(), graph);
+    stringstream ss;
+    ss << m_path << "/" << m_baseName << "/tmppartition" << N::value;
+    if (read_partitioning<N::value, partition_t>(graph, ss.str().c_str())) {
+        FAIL();
+    };
+
+    cout << "Building arc-flags, 16 trees per pass..." << endl;
+    auto start = std::chrono::high_resolution_clock::now();
+    arcflags_preprocess_batched<N::value, 16>(graph, weight, vertex_index, partition, arc_flags);
+    auto end = std::chrono::high_resolution_clock::now();
+    ArcFlagsMetricStatistics statistics(
+        GeneralStatistics(m_baseName, Algorithm::arcFlags, Phase::metric, Metric::time,
+            m_numOfNodes, m_numOfEdges,
+            chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0), N::value, m_filter);
+    m_statistics << statistics << endl;
+    cout << statistics << endl;
+
+    const Graph& sharedGraph = graph;
+    QueryContext<Graph> context(sharedGraph);
+    ifstream verificationFile;
+    ss.str(string());
+    ss << m_path << "/" << m_baseName << "/" << m_baseName << ".ppsp";
+    verificationFile.open(ss.str());
+    if (!verificationFile.is_open()) {
+        cerr << "Verification file " << ss.str() << " is not found." << endl;
+        FAIL();
+    };
+    size_t src, tgt, dis;
+    while (verificationFile >> src >> tgt >> dis) {
+        arcflags_query(sharedGraph,
+            graph_traits<Graph>::vertex_descriptor(src),
+            graph_traits<Graph>::vertex_descriptor(tgt),
+            weight, vertex_index, partition, arc_flags, context);
+        EXPECT_EQ(dis, get(context.Distance(), tgt));
+    }
 };
 
 //TEST_P(DdsgGraphAlgorithm, BidirectionalArcFlags) {
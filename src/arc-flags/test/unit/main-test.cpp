@@ -1,9 +1,79 @@
 #include <gtest/gtest.h>
+#include <random>
+#include <vector>
 #include <graph/static_graph.hpp>
 #include <arc-flags/arc-flags.hpp>
+#include <util/random_graph.h>
 
+using namespace std;
+using namespace graph;
+using namespace arcflags;
+
+struct distance_t {};
+struct color_t {};
+struct predecessor_t {};
+struct weight_t {};
+struct partition_t {};
+struct arc_flags_t {};
+
+TEST(ArcFlags, BatchedPreprocessingAnswersQueries) {
+    const size_t N = 8;
+    using Graph = GenerateArcFlagsGraph<predecessor_t, distance_t, weight_t,
+        vertex_index_t, color_t, arc_flags_t, partition_t, N,
+        Properties<>, Properties<>>::type;
+    using Vertex = graph_traits<Graph>::vertex_descriptor;
+
+    const size_t n = 600;
+    util::WeightedEdges<weight_t> input;
+    mt19937 generator(43);
+    uniform_int_distribution<uint32_t> weightDistribution(1, 50);
+    auto weightOf = [&](size_t, mt19937& generator) { return weightDistribution(generator); };
+    // a ring keeps the graph connected
+    util::AddRing(input, n, generator, weightOf);
+    util::AddRandomEdges(input, n, 2 * n, generator, weightOf);
+    std::stable_sort(input.begin(), input.end(), [](const auto& left, const auto& right) {
+        return left.first.first < right.first.first;
+    });
+    Graph classic(input.begin(), input.end(), n, input.size());
+    Graph batched(input.begin(), input.end(), n, input.size());
+    for (auto* g : {&classic, &batched}) {
+        auto partition = graph::get(partition_t(), *g);
+        for (auto v : graphUtil::Range(vertices(*g))) graph::put(partition, v, static_cast<char>(v * N / n));
+    }
+
+    auto predecessor = graph::get(predecessor_t(), classic);
+    auto distance = graph::get(distance_t(), classic);
+    auto weight = graph::get(weight_t(), classic);
+    auto index = graph::get(vertex_index_t(), classic);
+    auto color = graph::get(color_t(), classic);
+    auto partition = graph::get(partition_t(), classic);
+    auto arcFlags = graph::get(arc_flags_t(), classic);
+    arcflags_preprocess<N>(classic, predecessor, distance, weight, index, color, partition, arcFlags);
+
+    auto batchedWeight = graph::get(weight_t(), batched);
+    auto batchedIndex = graph::get(vertex_index_t(), batched);
+    auto batchedPartition = graph::get(partition_t(), batched);
+    auto batchedArcFlags = graph::get(arc_flags_t(), batched);
+    arcflags_preprocess_batched<N, 16>(batched, batchedWeight, batchedIndex, batchedPartition, batchedArcFlags);
+
+    QueryContext<Graph> context(classic);
+    QueryContext<Graph> batchedContext(batched);
+    DefaultDijkstraVisitor<Graph> visitor;
+    for (Vertex s = 0; s < n; s += 37) {
+        dijkstra(classic, s, predecessor, distance, weight, index, color, visitor);
+        for (Vertex t = 0; t < n; t += 13) {
+            EnsureVertexInitialization(classic, t, predecessor, distance, index, color, visitor);
+            auto expected = graph::get(distance, t);
+            arcflags_query(static_cast<const Graph&>(classic), s, t, weight, index, partition, arcFlags, context);
+            EXPECT_EQ(expected, graph::get(context.Distance(), t));
+            arcflags_query(static_cast<const Graph&>(batched), s, t, batchedWeight, batchedIndex,
+                batchedPartition, batchedArcFlags, batchedContext);
+            EXPECT_EQ(expected, graph::get(batchedContext.Distance(), t));
+        }
+    }
+}
 
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}
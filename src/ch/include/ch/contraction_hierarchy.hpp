@@ -1,8 +1,18 @@
 #pragma once
 
 #include <graph/dijkstra.hpp>
+#include <graph/search_counters.hpp>
 #include <graph/dynamic_graph.hpp>
 #include <boost/graph/two_bit_color_map.hpp>
+#include <graph/detail/util/ThreadPool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ch {
 
@@ -52,23 +62,300 @@ struct GenerateCHGraph<PredecessorMapTag, DisanceMapFTag, DisanceMapBTag, Weight
     >;
 };
 
+// The middle vertex in the unpack map of an original edge
+template <typename UnPackMap>
+constexpr typename UnPackMap::value_type NoMiddleVertex() {
+    return std::numeric_limits<typename UnPackMap::value_type>::max();
+}
+
+// What the contraction of a vertex would do to the remaining graph
+struct ContractionEffect {
+    // shortcuts the contraction adds
+    size_t shortcuts;
+    // edges between the vertex and the remaining vertices, each direction counts
+    size_t removedEdges;
+    // neighbours contracted before the vertex
+    size_t deletedNeighbours;
+};
+
+// The vertex with the smallest priority is contracted next
+
+// Edge difference and deleted neighbours: few shortcuts, the contracted vertices spread over the graph
 template <typename Graph>
 class ShortCutOrderStrategy {
 public:
-    typename graph::graph_traits<Graph>::vertex_descriptor
-        next(Graph& graph) {};
+    int64_t priority(const ContractionEffect& effect) const {
+        return int64_t(effect.shortcuts) - int64_t(effect.removedEdges) + int64_t(effect.deletedNeighbours);
+    }
 };
 
+// The deleted neighbours weigh more, the hierarchy grows flatter and the search spaces,
+// the hub labels of the vertices, stay smaller
 template <typename Graph>
 class HLOrderStrategy {
 public:
+    int64_t priority(const ContractionEffect& effect) const {
+        return int64_t(effect.shortcuts) - int64_t(effect.removedEdges) + 4 * int64_t(effect.deletedNeighbours);
+    }
+};
+
+namespace detail {
+
+// Witness search of a contraction: dijkstra over the forward edges of the remaining vertices,
+// it avoids the contracted vertex and stops after settledLimit vertices or past maxDistance
+template <typename Graph, typename DirectionMap, typename DistanceMap, typename IndexMap,
+    typename QueuePolicy = graph::queue::DijkstraQueuePolicy>
+struct WitnessSearchVisitor :public graph::DefaultDijkstraVisitor<Graph, QueuePolicy> {
+    using Vertex = typename graph::graph_traits<Graph>::vertex_descriptor;
+
+    WitnessSearchVisitor(const DirectionMap& direction, const IndexMap& index, const std::vector<char>& contracted)
+        :direction(direction), index(index), contracted(contracted) {};
+
+    void Reset(const Vertex& avoided, uint32_t maxDistance, size_t settledLimit, const DistanceMap& distance) {
+        this->avoided = avoided;
+        this->maxDistance = maxDistance;
+        this->settledLimit = settledLimit;
+        this->distance = &distance;
+        settled = 0;
+        lastDistance = 0;
+    }
+
+    void examine_vertex(const Vertex& v, const Graph&) {
+        ++settled;
+        lastDistance = get(*distance, v);
+    }
+
+    bool should_relax(const typename graph::graph_traits<Graph>::edge_descriptor& e, const Graph& graph) {
+        auto to = target(e, graph);
+        return get(direction, e) != DirectionBit::backward && to != avoided && !contracted[get(index, to)];
+    }
 
-    typename graph::graph_traits<Graph>::vertex_descriptor
-        next(Graph& graph) {};
+    bool should_continue() {
+        return settled < settledLimit && lastDistance <= maxDistance;
+    }
+
+    DirectionMap direction;
+    IndexMap index;
+    const std::vector<char>& contracted;
+    const DistanceMap* distance;
+    Vertex avoided;
+    uint32_t maxDistance;
+    size_t settledLimit;
+    size_t settled;
+    uint32_t lastDistance;
 };
 
+// Contracts the vertices of the graph: a contracted vertex stays in the graph, the searches skip it,
+// and the shortcuts between its remaining neighbours are added as new edges. Every edge is kept at both
+// of its ends like in the .ddsg graphs, with the forward bit at the source and the backward bit at the
+// target, so the shortcut u->w via v is the edge u->w forward and the edge w->u backward.
+// Simulate only reads the graph and runs its witness searches in the context of the given worker, so the
+// workers simulate at once; Contract changes the graph and runs alone.
+template <typename Graph, typename WeightMap, typename IndexMap, typename UnPackMap, typename DirectionMap>
+class Contractor {
+public:
+    using Vertex = typename graph::graph_traits<Graph>::vertex_descriptor;
+
+    struct Arc {
+        Vertex To;
+        uint32_t Weight;
+    };
+
+    struct Shortcut {
+        Vertex From;
+        Vertex To;
+        uint32_t Weight;
+        Vertex Middle;
+    };
 
-// uses dijkstra, therefore should have at least all property maps used by dijkstra
+    Contractor(Graph& graph, WeightMap& weight, IndexMap& index, UnPackMap& unpack, DirectionMap& direction,
+        size_t dijLimit, size_t workersCount = 1)
+        :graph(graph), weight(weight), index(index), unpack(unpack), direction(direction),
+        dijLimit(std::max<size_t>(dijLimit, 1)),
+        contracted(num_vertices(graph), 0), deletedNeighbours(num_vertices(graph), 0),
+        neighbourStamps(num_vertices(graph), 0), contractedCount(0) {
+        workers.reserve(workersCount);
+        for (size_t worker = 0; worker < workersCount; ++worker) {
+            workers.emplace_back(graph, index, direction, contracted);
+        }
+    };
+
+    // The shortcuts the contraction of v needs now, appended to shortcuts
+    ContractionEffect Simulate(const Vertex& v, std::vector<Shortcut>& shortcuts, size_t worker = 0) {
+        auto& state = workers[worker];
+        const Graph& sharedGraph = graph;
+        CollectArcs(v, state.Incoming, state.Outgoing);
+        size_t added = 0;
+        for (const auto& in : state.Incoming) {
+            uint32_t maxOut = 0;
+            bool anyTarget = false;
+            for (const auto& out : state.Outgoing) {
+                if (out.To == in.To)
+                    continue;
+                anyTarget = true;
+                maxOut = std::max(maxOut, out.Weight);
+            }
+            if (!anyTarget)
+                continue;
+            state.Witness.Reset(v, in.Weight + maxOut, dijLimit, state.Search.Distance());
+            graph::dijkstra(sharedGraph, in.To, weight, index, state.Search, state.Witness);
+            for (const auto& out : state.Outgoing) {
+                if (out.To == in.To)
+                    continue;
+                // a tentative distance is the length of a path as well
+                if (!state.Search.IsReached(out.To) ||
+                    get(state.Search.Distance(), out.To) > in.Weight + out.Weight) {
+                    shortcuts.push_back(Shortcut{in.To, out.To, in.Weight + out.Weight, v});
+                    ++added;
+                }
+            }
+        }
+        return ContractionEffect{added, state.Incoming.size() + state.Outgoing.size(),
+            deletedNeighbours[get(index, v)]};
+    }
+
+    // Adds the shortcuts and takes v out of the remaining graph
+    template <typename Iterator>
+    void Contract(const Vertex& v, Iterator shortcutsBegin, Iterator shortcutsEnd) {
+        for (auto shortcut = shortcutsBegin; shortcut != shortcutsEnd; ++shortcut) {
+            AddEdge(shortcut->From, shortcut->To, shortcut->Weight, DirectionBit::forward, shortcut->Middle);
+            AddEdge(shortcut->To, shortcut->From, shortcut->Weight, DirectionBit::backward, shortcut->Middle);
+        }
+        contracted[get(index, v)] = 1;
+        auto& state = workers.front();
+        CollectArcs(v, state.Incoming, state.Outgoing);
+        // a neighbour over an incoming and an outgoing arc is deleted once, the stamp marks it
+        ++contractedCount;
+        for (const auto& arcs : {&state.Incoming, &state.Outgoing}) {
+            for (const auto& arc : *arcs) {
+                auto& stamp = neighbourStamps[get(index, arc.To)];
+                if (stamp == contractedCount)
+                    continue;
+                stamp = contractedCount;
+                ++deletedNeighbours[get(index, arc.To)];
+            }
+        }
+    }
+
+    void Contract(const Vertex& v, const std::vector<Shortcut>& shortcuts) {
+        Contract(v, shortcuts.begin(), shortcuts.end());
+    }
+
+    bool IsContracted(const Vertex& v) const {
+        return contracted[get(index, v)] != 0;
+    }
+
+    // the remaining vertices next to v over an edge of any direction, v is not among them
+    template <typename Function>
+    void ForEachRemainingNeighbour(const Vertex& v, Function&& function) const {
+        for (const auto& e : graphUtil::Range(out_edges(v, graph))) {
+            auto to = target(e, graph);
+            if (to != v && !contracted[get(index, to)])
+                function(to);
+        }
+    }
+
+private:
+    using Context = graph::QueryContext<Graph>;
+    using Visitor = WitnessSearchVisitor<Graph, DirectionMap, typename Context::DistanceMap, IndexMap>;
+
+    // the witness search state of one worker
+    struct WorkerState {
+        WorkerState(const Graph& graph, const IndexMap& index, const DirectionMap& direction,
+            const std::vector<char>& contracted)
+            :Search(graph, index), Witness(direction, index, contracted) {};
+
+        Context Search;
+        Visitor Witness;
+        std::vector<Arc> Incoming;
+        std::vector<Arc> Outgoing;
+    };
+
+    // the lightest edges between v and each of its remaining neighbours, both directions
+    void CollectArcs(const Vertex& v, std::vector<Arc>& incoming, std::vector<Arc>& outgoing) const {
+        incoming.clear();
+        outgoing.clear();
+        for (const auto& e : graphUtil::Range(out_edges(v, graph))) {
+            auto to = target(e, graph);
+            if (to == v || contracted[get(index, to)])
+                continue;
+            auto edgeDirection = get(direction, e);
+            if (edgeDirection != DirectionBit::backward)
+                outgoing.push_back(Arc{to, get(weight, e)});
+            if (edgeDirection != DirectionBit::forward)
+                incoming.push_back(Arc{to, get(weight, e)});
+        }
+        Lightest(incoming);
+        Lightest(outgoing);
+    }
+
+    static void Lightest(std::vector<Arc>& arcs) {
+        std::sort(arcs.begin(), arcs.end(), [](const Arc& left, const Arc& right) {
+            return left.To < right.To || (left.To == right.To && left.Weight < right.Weight);
+        });
+        arcs.erase(std::unique(arcs.begin(), arcs.end(), [](const Arc& left, const Arc& right) {
+            return left.To == right.To;
+        }), arcs.end());
+    }
+
+    void AddEdge(const Vertex& from, const Vertex& to, uint32_t edgeWeight, DirectionBit edgeDirection,
+        const Vertex& middle) {
+        auto e = add_edge(from, to, graph).first;
+        put(weight, e, edgeWeight);
+        put(direction, e, edgeDirection);
+        put(unpack, e, middle);
+    }
+
+    Graph& graph;
+    WeightMap& weight;
+    IndexMap& index;
+    UnPackMap& unpack;
+    DirectionMap& direction;
+    size_t dijLimit;
+    std::vector<char> contracted;
+    std::vector<size_t> deletedNeighbours;
+    // the neighbours counted by the contraction number contractedCount carry it
+    std::vector<size_t> neighbourStamps;
+    size_t contractedCount;
+    std::vector<WorkerState> workers;
+};
+
+// Ties of the priorities are broken by a hash of the vertex, so the local minima spread over the graph
+template <typename Vertex>
+inline uint64_t TieBreak(const Vertex& v) {
+    uint64_t x = uint64_t(v) + 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Calls function(worker, i) for every i in [0, count) on the workers of the pool, blocks of i are
+// handed out on demand
+template <typename Function>
+void ParallelFor(graphUtil::ThreadPool& pool, size_t count, Function&& function) {
+    const size_t blockSize = 64;
+    std::atomic<size_t> nextBlock(0);
+    pool.Run([&](size_t worker) {
+        for (size_t block = nextBlock++ * blockSize; block < count; block = nextBlock++ * blockSize) {
+            auto blockEnd = std::min(count, block + blockSize);
+            for (auto i = block; i < blockEnd; ++i) {
+                function(worker, i);
+            }
+        }
+    });
+}
+
+} // detail
+
+// Contracts the vertices in rounds, the order map gets the rank of every vertex (0 is contracted first)
+// and the shortcuts are added to the graph with their middle vertex in the unpack map. A round contracts
+// every remaining vertex whose priority is the smallest within two hops: no two of them are neighbours
+// or share a neighbour, so their witness searches run at once on the threads of the pool, each thread
+// with its own search context and shortcut buffer. The buffers are merged into the graph in the order
+// of the vertices and the priorities of the remaining neighbours are updated in parallel, the result
+// does not depend on threadsCount. The witness searches settle at most dijLimit vertices, a witness
+// they miss only costs a redundant shortcut.
+// The predecessor, distance and color maps are not used, the searches keep their state in contexts.
 template <typename Graph, typename PredecessorMap, typename DistanceMap,
     typename WeightMap, typename IndexMap, typename ColorMap, typename UnPackMap,
     typename VertexOrderMap, typename DirectionMap,
@@ -76,30 +363,467 @@ template <typename Graph, typename PredecessorMap, typename DistanceMap,
     void ch_preprocess(Graph& graph, PredecessorMap& predecessor, DistanceMap& distance,
         WeightMap& weight, IndexMap& index, ColorMap& color, UnPackMap& unpack,
         VertexOrderMap& order, DirectionMap& direction, size_t dijLimit,
-        OrderStrategy&& strategy = OrderStrategy()) {};
+        OrderStrategy&& strategy = OrderStrategy(),
+        size_t threadsCount = graphUtil::DefaultThreadsCount()) {
+        using Vertex = typename graph::graph_traits<Graph>::vertex_descriptor;
+        using ContractorType = detail::Contractor<Graph, WeightMap, IndexMap, UnPackMap, DirectionMap>;
+        using Shortcut = typename ContractorType::Shortcut;
+
+        for (const auto& v : graphUtil::Range(vertices(graph))) {
+            for (const auto& e : graphUtil::Range(out_edges(v, graph))) {
+                put(unpack, e, NoMiddleVertex<UnPackMap>());
+            }
+        }
+        graphUtil::ThreadPool pool(threadsCount);
+        ContractorType contractor(graph, weight, index, unpack, direction, dijLimit, pool.Size());
+        std::vector<std::vector<Shortcut>> buffers(pool.Size());
+        std::vector<int64_t> priorities(num_vertices(graph));
+        std::vector<Vertex> remaining;
+        for (const auto& v : graphUtil::Range(vertices(graph))) {
+            remaining.push_back(v);
+        }
+        auto updatePriorities = [&](const std::vector<Vertex>& updated) {
+            detail::ParallelFor(pool, updated.size(), [&](size_t worker, size_t i) {
+                auto v = updated[i];
+                priorities[get(index, v)] = strategy.priority(contractor.Simulate(v, buffers[worker], worker));
+                buffers[worker].clear();
+            });
+        };
+        updatePriorities(remaining);
+
+        auto less = [&](const Vertex& left, const Vertex& right) {
+            auto leftPriority = priorities[get(index, left)];
+            auto rightPriority = priorities[get(index, right)];
+            return leftPriority < rightPriority || (leftPriority == rightPriority &&
+                (detail::TieBreak(left) < detail::TieBreak(right) ||
+                (detail::TieBreak(left) == detail::TieBreak(right) && left < right)));
+        };
+        std::vector<char> selected(num_vertices(graph), 0);
+        std::vector<char> affected(num_vertices(graph), 0);
+        std::vector<Vertex> independent;
+        std::vector<Vertex> neighbours;
+        std::vector<Shortcut> shortcuts;
+        typename VertexOrderMap::value_type rank = 0;
+        while (!remaining.empty()) {
+            detail::ParallelFor(pool, remaining.size(), [&](size_t, size_t i) {
+                auto v = remaining[i];
+                bool minimum = true;
+                contractor.ForEachRemainingNeighbour(v, [&](const Vertex& x) {
+                    if (!minimum || less(x, v)) {
+                        minimum = false;
+                        return;
+                    }
+                    contractor.ForEachRemainingNeighbour(x, [&](const Vertex& y) {
+                        if (y != v && less(y, v))
+                            minimum = false;
+                    });
+                });
+                selected[get(index, v)] = minimum;
+            });
+            independent.clear();
+            for (const auto& v : remaining) {
+                if (selected[get(index, v)])
+                    independent.push_back(v);
+            }
+
+            detail::ParallelFor(pool, independent.size(), [&](size_t worker, size_t i) {
+                contractor.Simulate(independent[i], buffers[worker], worker);
+            });
+            // the vertices are contracted in the order of their ids, a vertex simulated by one worker
+            // keeps the order of its shortcuts
+            shortcuts.clear();
+            for (auto& buffer : buffers) {
+                shortcuts.insert(shortcuts.end(), buffer.begin(), buffer.end());
+                buffer.clear();
+            }
+            std::stable_sort(shortcuts.begin(), shortcuts.end(), [](const Shortcut& left, const Shortcut& right) {
+                return left.Middle < right.Middle;
+            });
 
-template <typename Graph, typename DirectionMap, typename WeightMap>
-struct IncreaseWeightOfIncommingEdgeVisitor:public graph::DefaultDijkstraVisitor<Graph> {
-    IncreaseWeightOfIncommingEdgeVisitor(DirectionMap& direction, WeightMap weight)
-        :direction(direction),weight(weight) {};
-    void examine_edge(const typename graph::graph_traits<Graph>::edge_descriptor& e, const Graph& graph) {
-        if (get(direction, e) == DirectionBit::backward)
-            graph::put(weight, e, 10000000);
+            neighbours.clear();
+            auto shortcutsBegin = shortcuts.begin();
+            for (const auto& v : independent) {
+                auto shortcutsEnd = std::find_if(shortcutsBegin, shortcuts.end(), [&](const Shortcut& shortcut) {
+                    return shortcut.Middle != v;
+                });
+                contractor.Contract(v, shortcutsBegin, shortcutsEnd);
+                shortcutsBegin = shortcutsEnd;
+                put(order, v, rank++);
+                contractor.ForEachRemainingNeighbour(v, [&](const Vertex& x) {
+                    if (!affected[get(index, x)]) {
+                        affected[get(index, x)] = 1;
+                        neighbours.push_back(x);
+                    }
+                });
+            }
+            for (const auto& x : neighbours) {
+                affected[get(index, x)] = 0;
+            }
+            updatePriorities(neighbours);
+            remaining.erase(std::remove_if(remaining.begin(), remaining.end(), [&](const Vertex& v) {
+                return contractor.IsContracted(v);
+            }), remaining.end());
+        }
+    };
+
+namespace detail {
+
+// One direction of the query: the forward search relaxes the forward edges and the backward search
+// the backward edges, both only up to vertices of a higher rank. With stalling a settled vertex v
+// relaxes nothing when a reached higher neighbour x has an edge x->v (v->x for the backward search)
+// that makes v shorter: the shortest path to v does not go up to v, so no shortest path continues from it.
+template <typename Graph, typename WeightMap, typename IndexMap, typename OrderMap,
+    typename DirectionMap, typename DistanceMap, typename QueuePolicy = graph::queue::DijkstraQueuePolicy>
+struct CHUpwardVisitor :public graph::DefaultDijkstraVisitor<Graph, QueuePolicy> {
+    using Vertex = typename graph::graph_traits<Graph>::vertex_descriptor;
+
+    CHUpwardVisitor(const WeightMap& weight, const IndexMap& index, const OrderMap& order,
+        const DirectionMap& direction, const DistanceMap& distance, DirectionBit skipped, bool stalling)
+        :weight(weight), index(index), order(order), direction(direction), distance(distance),
+        skipped(skipped), stalling(stalling), stalled(false) {};
+
+    void examine_vertex(const Vertex& v, const Graph& graph) {
+        stalled = stalling && IsStalled(v, graph);
     }
-    DirectionMap direction;
+
+    bool should_relax(const typename graph::graph_traits<Graph>::edge_descriptor& e, const Graph& graph) {
+        return !stalled && get(direction, e) != skipped &&
+            get(order, target(e, graph)) > get(order, source(e, graph));
+    }
+
+    bool IsStalled(const Vertex& v, const Graph& graph) const {
+        auto vDistance = get(distance, v);
+        for (const auto& e : graphUtil::Range(out_edges(v, graph))) {
+            auto x = target(e, graph);
+            // the edges of the other direction lead down to v
+            if (get(direction, e) == Opposite() || get(order, x) <= get(order, v) ||
+                !this->Stored.VertexInitializer.IsInitialized(x, index))
+                continue;
+            auto xDistance = get(distance, x);
+            if (xDistance < vDistance && vDistance - xDistance > get(weight, e))
+                return true;
+        }
+        return false;
+    }
+
+    DirectionBit Opposite() const {
+        return skipped == DirectionBit::backward ? DirectionBit::forward : DirectionBit::backward;
+    }
+
     WeightMap weight;
+    IndexMap index;
+    OrderMap order;
+    DirectionMap direction;
+    DistanceMap distance;
+    DirectionBit skipped;
+    bool stalling;
+    bool stalled;
 };
 
-template <typename Graph, typename PredecessorMap, typename DistanceFMap,
-    typename DistanceBMap, typename WeightMap, typename IndexMap, typename ColorMap, typename UnPackMap,
-    typename VertexOrderMap, typename DirectionMap, typename CHVisitor = DefaultCHVisitor<Graph>>
-    void ch_query(Graph& graph, 
+} // detail
+
+// Bidirectional query on the hierarchy: a forward search up from s and a backward search up from t,
+// the searches meet at the highest vertex of the shortest path. A direction stops once its smallest
+// queued distance reaches the shortest path found so far. The searches only read the graph, the state
+// is kept in the contexts: the distance and the path to t, with shortcuts, are written to the forward
+// context, the distance is InfinityDistance when t is not reachable. The work of both searches is added
+// to counters, see graph/search_counters.hpp.
+template <typename Graph, typename WeightMap, typename IndexMap, typename OrderMap, typename DirectionMap,
+    typename DistanceType, typename QueuePolicy, typename Counters>
+    void ch_query(const Graph& graph,
         const typename graph::graph_traits<Graph>::vertex_descriptor& s,
         const typename graph::graph_traits<Graph>::vertex_descriptor& t,
-        PredecessorMap& predecessor, DistanceFMap& distanceF, DistanceBMap& distanceB,
-        WeightMap& weight, IndexMap& index, ColorMap& color, UnPackMap& unpack,
-        VertexOrderMap& order, DirectionMap& direction, CHVisitor&& visitor = CHVisitor()) {
-        IncreaseWeightOfIncommingEdgeVisitor<Graph,DirectionMap,WeightMap> dijVisitor(direction, weight);
-        graph::dijkstra(graph, s, predecessor, distanceF, weight, index, color, dijVisitor);
+        WeightMap& weight, IndexMap& index, OrderMap& order, DirectionMap& direction,
+        graph::QueryContext<Graph, DistanceType, QueuePolicy>& forward,
+        graph::QueryContext<Graph, DistanceType, QueuePolicy>& backward,
+        bool stalling, Counters& counters) {
+        using Vertex = typename graph::graph_traits<Graph>::vertex_descriptor;
+        using Context = graph::QueryContext<Graph, DistanceType, QueuePolicy>;
+        using DistanceMap = typename Context::DistanceMap;
+        using UpwardVisitor = detail::CHUpwardVisitor<Graph, WeightMap, IndexMap, OrderMap,
+            DirectionMap, DistanceMap, QueuePolicy>;
+        using Visitor = graph::CountingDijkstraVisitor<Graph, UpwardVisitor, Counters>;
+
+        Visitor visitorF(weight, index, order, direction, forward.Distance(), DirectionBit::backward, stalling);
+        Visitor visitorB(weight, index, order, direction, backward.Distance(), DirectionBit::forward, stalling);
+        graph::detail::StoredDataLoan<typename Context::SharedDataStorage> loanF(forward.Stored, visitorF.Stored);
+        graph::detail::StoredDataLoan<typename Context::SharedDataStorage> loanB(backward.Stored, visitorB.Stored);
+        visitorF.Initialize(graph);
+        visitorB.Initialize(graph);
+        auto& queueF = visitorF.Stored.Queue;
+        auto& queueB = visitorB.Stored.Queue;
+        graph::init_first_vertex(graph, s, forward.Predecessor(), forward.Distance(), index,
+            forward.Color(), visitorF, queueF);
+        graph::init_first_vertex(graph, t, backward.Predecessor(), backward.Distance(), index,
+            backward.Color(), visitorB, queueB);
+
+        auto mu = graph::InfinityDistance<DistanceMap>();
+        auto transitNode = t;
+        // the vertex settled in one direction and reached in the other is on a path from s to t
+        auto meet = [&](const Vertex& v, Context& settledIn, Context& reachedIn, Visitor& reachedVisitor) {
+            if (!reachedVisitor.Stored.VertexInitializer.IsInitialized(v, index))
+                return;
+            auto reachedDistance = get(reachedIn.Distance(), v);
+            if (reachedDistance == graph::InfinityDistance<DistanceMap>())
+                return;
+            if (get(settledIn.Distance(), v) + reachedDistance < mu) {
+                mu = get(settledIn.Distance(), v) + reachedDistance;
+                transitNode = v;
+            }
+        };
+
+        bool forwardIsNext = false;
+        while (true) {
+            bool forwardActive = !queueF.IsEmpty() && queueF.PeekMin().Distance < mu;
+            bool backwardActive = !queueB.IsEmpty() && queueB.PeekMin().Distance < mu;
+            if (!forwardActive && !backwardActive)
+                break;
+            forwardIsNext = forwardActive && (!backwardActive || !forwardIsNext);
+            if (forwardIsNext) {
+                auto v = queueF.PeekMin().Vertex;
+                graph::dijkstra_iteration(graph, forward.Predecessor(), forward.Distance(), weight, index,
+                    forward.Color(), visitorF);
+                meet(v, forward, backward, visitorB);
+            }
+            else {
+                auto v = queueB.PeekMin().Vertex;
+                graph::dijkstra_iteration(graph, backward.Predecessor(), backward.Distance(), weight, index,
+                    backward.Color(), visitorB);
+                meet(v, backward, forward, visitorF);
+            }
+        }
+        counters += visitorF.GetCounters();
+        counters += visitorB.GetCounters();
+
+        graph::EnsureVertexInitialization(graph, t, forward.Predecessor(), forward.Distance(), index,
+            forward.Color(), visitorF);
+        put(forward.Distance(), t, mu);
+        if (mu == graph::InfinityDistance<DistanceMap>())
+            return;
+        // the backward tree path from the transit node to t, t included
+        for (Vertex v = transitNode; v != t;) {
+            Vertex next = get(backward.Predecessor(), v);
+            put(forward.Predecessor(), next, v);
+            v = next;
+        }
     };
-};
\ No newline at end of file
+
+template <typename Graph, typename WeightMap, typename IndexMap, typename OrderMap, typename DirectionMap,
+    typename DistanceType, typename QueuePolicy>
+    void ch_query(const Graph& graph,
+        const typename graph::graph_traits<Graph>::vertex_descriptor& s,
+        const typename graph::graph_traits<Graph>::vertex_descriptor& t,
+        WeightMap& weight, IndexMap& index, OrderMap& order, DirectionMap& direction,
+        graph::QueryContext<Graph, DistanceType, QueuePolicy>& forward,
+        graph::QueryContext<Graph, DistanceType, QueuePolicy>& backward,
+        bool stalling = false) {
+        graph::NoSearchCounters counters;
+        ch_query(graph, s, t, weight, index, order, direction, forward, backward, stalling, counters);
+    };
+
+// Turns the path of a CH query, its hops may be shortcuts, into the vertices of the original graph.
+// The hop u->w is the lightest edge from u to w: the edge at u with the forward bit or the edge at w
+// with the backward bit, so the hierarchy and the search graph (ch/search_graph.hpp) are unpacked alike.
+// A shortcut is replaced by its two halves through the middle vertex, on an explicit stack: the halves
+// were the lightest edges when the middle vertex was contracted and no edge touches it afterwards.
+// With a cache capacity the expansions of the shortcut hops of the query paths are kept, least recently
+// used first out, until they hold that many vertices. A shortcut met again on any level of an expansion
+// is copied from the cache. One unpacker serves one thread, e.g. one per context of CHQueryEngine.
+template <typename Graph, typename WeightMap, typename UnPackMap, typename DirectionMap>
+class PathUnpacker {
+public:
+    using Vertex = typename graph::graph_traits<Graph>::vertex_descriptor;
+
+    PathUnpacker(const Graph& graph, const WeightMap& weight, const UnPackMap& unpack,
+        const DirectionMap& direction, size_t cacheCapacity = 0)
+        :graph(graph), weight(weight), unpack(unpack), direction(direction),
+        cacheCapacity(cacheCapacity), cachedVertices(0), hits(0), misses(0) {};
+
+    // unpacked gets the first vertex of path and the inner vertices and the end of every hop
+    void Unpack(const std::vector<Vertex>& path, std::vector<Vertex>& unpacked) {
+        unpacked.clear();
+        if (path.empty())
+            return;
+        unpacked.push_back(path.front());
+        for (size_t i = 1; i < path.size(); ++i) {
+            UnpackHop(path[i - 1], path[i], unpacked);
+        }
+    }
+
+    // the hops found in the cache and the shortcut hops of the paths that were not
+    size_t CacheHits() const {
+        return hits;
+    }
+
+    size_t CacheMisses() const {
+        return misses;
+    }
+
+private:
+    struct Hop {
+        Vertex From;
+        Vertex To;
+        // the expansion of the hop starts at this position of the output, it is cached when the
+        // marker is taken from the stack
+        size_t Begin;
+        bool Marker;
+    };
+
+    struct CacheEntry {
+        uint64_t Key;
+        std::vector<Vertex> Vertices;
+    };
+
+    // the vertex ids are below 2^32
+    static uint64_t Key(const Vertex& from, const Vertex& to) {
+        return (uint64_t(from) << 32) | uint64_t(to);
+    }
+
+    void UnpackHop(const Vertex& from, const Vertex& to, std::vector<Vertex>& unpacked) {
+        stack.clear();
+        stack.push_back(Hop{from, to, 0, false});
+        bool top = true;
+        while (!stack.empty()) {
+            auto hop = stack.back();
+            stack.pop_back();
+            if (hop.Marker) {
+                Store(Key(hop.From, hop.To), unpacked.begin() + hop.Begin, unpacked.end());
+                continue;
+            }
+            auto middle = Middle(hop.From, hop.To);
+            if (middle == NoMiddleVertex<UnPackMap>()) {
+                unpacked.push_back(hop.To);
+                top = false;
+                continue;
+            }
+            if (cacheCapacity > 0 && Load(Key(hop.From, hop.To), unpacked)) {
+                top = false;
+                continue;
+            }
+            if (top && cacheCapacity > 0) {
+                ++misses;
+                stack.push_back(Hop{hop.From, hop.To, unpacked.size(), true});
+            }
+            top = false;
+            // the first half is unpacked first
+            stack.push_back(Hop{Vertex(middle), hop.To, 0, false});
+            stack.push_back(Hop{hop.From, Vertex(middle), 0, false});
+        }
+    }
+
+    // the middle vertex of the lightest edge from u to w
+    typename UnPackMap::value_type Middle(const Vertex& u, const Vertex& w) const {
+        auto lightest = std::numeric_limits<uint32_t>::max();
+        auto middle = NoMiddleVertex<UnPackMap>();
+        for (const auto& e : graphUtil::Range(out_edges(u, graph))) {
+            if (target(e, graph) == w && get(direction, e) != DirectionBit::backward && get(weight, e) < lightest) {
+                lightest = get(weight, e);
+                middle = get(unpack, e);
+            }
+        }
+        for (const auto& e : graphUtil::Range(out_edges(w, graph))) {
+            if (target(e, graph) == u && get(direction, e) != DirectionBit::forward && get(weight, e) < lightest) {
+                lightest = get(weight, e);
+                middle = get(unpack, e);
+            }
+        }
+        return middle;
+    }
+
+    bool Load(uint64_t key, std::vector<Vertex>& unpacked) {
+        auto entry = cacheIndex.find(key);
+        if (entry == cacheIndex.end())
+            return false;
+        ++hits;
+        cache.splice(cache.begin(), cache, entry->second);
+        unpacked.insert(unpacked.end(), entry->second->Vertices.begin(), entry->second->Vertices.end());
+        return true;
+    }
+
+    template <typename Iterator>
+    void Store(uint64_t key, Iterator begin, Iterator end) {
+        size_t size = static_cast<size_t>(end - begin);
+        if (size > cacheCapacity || cacheIndex.count(key) != 0)
+            return;
+        while (cachedVertices + size > cacheCapacity) {
+            cachedVertices -= cache.back().Vertices.size();
+            cacheIndex.erase(cache.back().Key);
+            cache.pop_back();
+        }
+        cache.push_front(CacheEntry{key, std::vector<Vertex>(begin, end)});
+        cacheIndex[key] = cache.begin();
+        cachedVertices += size;
+    }
+
+    const Graph& graph;
+    WeightMap weight;
+    UnPackMap unpack;
+    DirectionMap direction;
+    std::vector<Hop> stack;
+    size_t cacheCapacity;
+    size_t cachedVertices;
+    // the most recently used expansion first
+    std::list<CacheEntry> cache;
+    std::unordered_map<uint64_t, typename std::list<CacheEntry>::iterator> cacheIndex;
+    size_t hits;
+    size_t misses;
+};
+
+// The vertices of the original graph on the path of a CH query, e.g. the Path of the forward context
+template <typename Graph, typename WeightMap, typename UnPackMap, typename DirectionMap>
+    void ch_unpack(const Graph& graph, const WeightMap& weight, const UnPackMap& unpack,
+        const DirectionMap& direction,
+        const std::vector<typename graph::graph_traits<Graph>::vertex_descriptor>& path,
+        std::vector<typename graph::graph_traits<Graph>::vertex_descriptor>& unpacked) {
+        PathUnpacker<Graph, WeightMap, UnPackMap, DirectionMap> unpacker(graph, weight, unpack, direction);
+        unpacker.Unpack(path, unpacked);
+    };
+
+// Engine of graph::BatchQueryExecutor, see graph/batch_query.hpp, the paths are unpacked to the
+// original edges with a PathUnpacker per context, cacheCapacity vertices of cached expansions each
+template <typename Graph, typename WeightMap, typename IndexMap, typename UnPackMap, typename OrderMap,
+    typename DirectionMap, typename QueuePolicy = graph::queue::DijkstraQueuePolicy>
+class CHQueryEngine {
+    using SearchContext = graph::QueryContext<Graph, uint32_t, QueuePolicy>;
+    using Unpacker = PathUnpacker<Graph, WeightMap, UnPackMap, DirectionMap>;
+public:
+    using Vertex = typename graph::graph_traits<Graph>::vertex_descriptor;
+    using Distance = uint32_t;
+    struct Context {
+        SearchContext Forward;
+        SearchContext Backward;
+        Unpacker PathUnpacker;
+        std::vector<Vertex> Hops;
+    };
+
+    CHQueryEngine(const Graph& graph, const WeightMap& weight, const IndexMap& index, const UnPackMap& unpack,
+        const OrderMap& order, const DirectionMap& direction, bool stalling = false, size_t cacheCapacity = 0)
+        :graph(graph), weight(weight), index(index), unpack(unpack), order(order), direction(direction),
+        stalling(stalling), cacheCapacity(cacheCapacity) {};
+
+    Context CreateContext() const {
+        return Context{SearchContext(graph, index), SearchContext(graph, index),
+            Unpacker(graph, weight, unpack, direction, cacheCapacity), std::vector<Vertex>()};
+    }
+
+    Distance Query(Context& context, const Vertex& s, const Vertex& t) const {
+        ch_query(graph, s, t, weight, index, order, direction, context.Forward, context.Backward, stalling);
+        return get(context.Forward.Distance(), t);
+    }
+
+    void Path(Context& context, const Vertex& s, const Vertex& t, std::vector<Vertex>& path) const {
+        context.Forward.Path(s, t, context.Hops);
+        context.PathUnpacker.Unpack(context.Hops, path);
+    }
+
+private:
+    const Graph& graph;
+    WeightMap weight;
+    IndexMap index;
+    UnPackMap unpack;
+    OrderMap order;
+    DirectionMap direction;
+    bool stalling;
+    size_t cacheCapacity;
+};
+};
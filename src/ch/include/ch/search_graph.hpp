@@ -0,0 +1,121 @@
+#pragma once
+
+#include <ch/contraction_hierarchy.hpp>
+#include <graph/static_graph.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace ch {
+
+template <typename WeightMapTag, typename UnPackMapTag, typename DirectionMapTag>
+struct GenerateCHSearchGraph {
+    using type = graph::ForwardStaticGraph<
+        graph::Properties<>,
+        graph::Properties<
+            graph::Property<WeightMapTag, uint32_t>,
+            graph::Property<UnPackMapTag, uint32_t>,
+            graph::Property<DirectionMapTag, DirectionBit>>,
+        graph::ColumnLayoutTag>;
+};
+
+// Query-only copy of a contracted hierarchy: the vertices are renumbered by rank and every vertex keeps
+// only the edges to higher vertices, the upward out-edges (forward bit) and the downward in-edges
+// (backward bit, the edge x->v is stored at v as v->x). Parallel edges keep the lightest one per
+// direction, one edge with the both bit when they agree. The weights, the middle vertices (ranks) and
+// the directions are columns of the CSR graph. The ranks serve as the order map of ch_query, which runs
+// on GetGraph() with its vertex index as the order: translate the query with Rank and the path with Original.
+template <typename WeightMapTag, typename UnPackMapTag, typename DirectionMapTag>
+class CHSearchGraph {
+public:
+    using Graph = typename GenerateCHSearchGraph<WeightMapTag, UnPackMapTag, DirectionMapTag>::type;
+    using Vertex = typename graph::graph_traits<Graph>::vertex_descriptor;
+
+    template <typename Hierarchy, typename WeightMap, typename UnPackMap, typename OrderMap, typename DirectionMap>
+    CHSearchGraph(const Hierarchy& hierarchy, const WeightMap& weight, const UnPackMap& unpack,
+        const OrderMap& order, const DirectionMap& direction)
+        :ranks(num_vertices(hierarchy)), originals(num_vertices(hierarchy)) {
+        using Properties = typename Graph::edge_bundled;
+        // (higher neighbour, direction, weight, middle) of the edges of one vertex
+        using Arc = std::tuple<Vertex, DirectionBit, uint32_t, Vertex>;
+        const Vertex noMiddle = std::numeric_limits<Vertex>::max();
+
+        for (const auto& v : graphUtil::Range(vertices(hierarchy))) {
+            ranks[v] = static_cast<Vertex>(get(order, v));
+            originals[ranks[v]] = v;
+        }
+        // every edge of the hierarchy is stored at both of its ends and only one of them goes up
+        typename Graph::Builder builder(static_cast<Vertex>(num_vertices(hierarchy)),
+            static_cast<typename Graph::edges_size_type>(num_edges(hierarchy) / 2));
+        auto addEdge = [&](const Vertex& from, const Arc& arc, DirectionBit arcDirection) {
+            builder.AddEdge(from, std::get<0>(arc), Properties(
+                graph::Property<WeightMapTag, uint32_t>(std::get<2>(arc)),
+                graph::Property<UnPackMapTag, uint32_t>(std::get<3>(arc)),
+                graph::Property<DirectionMapTag, DirectionBit>(arcDirection)));
+        };
+        std::vector<Arc> arcs;
+        for (const auto& v : graphUtil::Range(vertices(hierarchy))) {
+            arcs.clear();
+            for (const auto& e : graphUtil::Range(out_edges(v, hierarchy))) {
+                auto x = ranks[target(e, hierarchy)];
+                if (x <= ranks[v])
+                    continue;
+                auto middle = get(unpack, e) == NoMiddleVertex<UnPackMap>() ? noMiddle : ranks[get(unpack, e)];
+                if (get(direction, e) != DirectionBit::backward)
+                    arcs.push_back(Arc(x, DirectionBit::forward, get(weight, e), middle));
+                if (get(direction, e) != DirectionBit::forward)
+                    arcs.push_back(Arc(x, DirectionBit::backward, get(weight, e), middle));
+            }
+            // the lightest arc of every neighbour and direction comes first
+            std::sort(arcs.begin(), arcs.end());
+            for (size_t i = 0; i < arcs.size();) {
+                const Arc* forward = nullptr;
+                const Arc* backward = nullptr;
+                for (auto x = std::get<0>(arcs[i]); i < arcs.size() && std::get<0>(arcs[i]) == x; ++i) {
+                    auto& lightest = std::get<1>(arcs[i]) == DirectionBit::forward ? forward : backward;
+                    if (lightest == nullptr)
+                        lightest = &arcs[i];
+                }
+                if (forward != nullptr && backward != nullptr && std::get<2>(*forward) == std::get<2>(*backward) &&
+                    std::get<3>(*forward) == std::get<3>(*backward)) {
+                    addEdge(ranks[v], *forward, DirectionBit::both);
+                    continue;
+                }
+                if (forward != nullptr)
+                    addEdge(ranks[v], *forward, DirectionBit::forward);
+                if (backward != nullptr)
+                    addEdge(ranks[v], *backward, DirectionBit::backward);
+            }
+        }
+        searchGraph = builder.Build();
+    }
+
+    const Graph& GetGraph() const {
+        return *searchGraph;
+    }
+
+    // the property maps are taken from a non const graph
+    Graph& GetGraph() {
+        return *searchGraph;
+    }
+
+    // the vertex of the search graph of a vertex of the hierarchy
+    Vertex Rank(size_t v) const {
+        return ranks[v];
+    }
+
+    // the vertex of the hierarchy of a vertex of the search graph
+    size_t Original(const Vertex& rank) const {
+        return originals[rank];
+    }
+
+private:
+    std::unique_ptr<Graph> searchGraph;
+    std::vector<Vertex> ranks;
+    std::vector<size_t> originals;
+};
+
+}
@@ -14,7 +14,8 @@ enum class CHNames:char {
     distance,
     dij_limit,
     priority,
-    stalling
+    stalling,
+    threads
 };
 
 std::ostream& operator<<(std::ostream& osm, const CHNames& arg) {
@@ -37,6 +38,9 @@ std::ostream& operator<<(std::ostream& osm, const CHNames& arg) {
     case CHNames::stalling:
         osm << "stalling";
         break;
+    case CHNames::threads:
+        osm << "threads";
+        break;
 
     default:
         osm << "Unknown column";
@@ -80,6 +84,17 @@ std::ostream& operator<<(std::ostream& osm, const CHMetricStatistics& arg) {
     return osm;
 };
 
+struct ParallelCHMetricStatistics : CHMetricStatistics {
+    ParallelCHMetricStatistics(const CHMetricStatistics& base, size_t threads)
+        :CHMetricStatistics(base), threads(CHNames::threads, threads) {};
+    StatisticsField<CHNames, size_t> threads;
+};
+
+std::ostream& operator<<(std::ostream& osm, const ParallelCHMetricStatistics& arg) {
+    osm << static_cast<CHMetricStatistics>(arg) << '\t' << arg.threads;
+    return osm;
+};
+
 struct CHQueryStatistic : CHMetricStatistics {
     CHQueryStatistic(const CHMetricStatistics& base,
         size_t source, size_t target, size_t distance, bool stalling)
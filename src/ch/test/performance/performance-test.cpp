@@ -9,6 +9,9 @@
 #include <gtest/gtest.h>
 #include <graph/io.hpp>
 #include <ch/contraction_hierarchy.hpp>
+#include <ch/search_graph.hpp>
+#include <graph/batch_query.hpp>
+#include <graph/search_counters.hpp>
 #include <test.h>
 
 #include <gtest/gtest.h>
@@ -112,32 +115,151 @@ TEST_P(DdsgGraphAlgorithm, CH) {
     };
     size_t src, tgt, dis;
 
-    DefaultCHVisitor<Graph> visitor;
+    const Graph& sharedGraph = graph;
+    QueryContext<Graph> forward(sharedGraph);
+    QueryContext<Graph> backward(sharedGraph);
+    SearchCounters counters;
     while (verificationFile >> src >> tgt >> dis) {
         cout << "Running CH query from " << src << " to " << tgt << endl;
+        counters.Reset();
         start = std::chrono::high_resolution_clock::now();
-        ch_query(graph,
+        ch_query(sharedGraph,
             graph_traits<Graph>::vertex_descriptor(src),
             graph_traits<Graph>::vertex_descriptor(tgt),
-            predecessor, distanceF, distanceB, weight, vertex_index, color, unpack, order, direction,visitor);
+            weight, vertex_index, order, direction, forward, backward, m_stalling, counters);
         end = std::chrono::high_resolution_clock::now();
-        CHQueryStatistic statistics(
-            CHMetricStatistics(
-                GeneralStatistics(m_baseName, Algorithm::CH, Phase::query, Metric::time,
-                    m_numOfNodes, m_numOfEdges,
-                    chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0),
-                m_numSteps, CHPriority::shortcut), 
-            src, tgt, get(distanceF, tgt), m_stalling
-            );
+        auto distance = get(forward.Distance(), tgt);
+        SearchSpaceStatistics<CHQueryStatistic> statistics(
+            CHQueryStatistic(
+                CHMetricStatistics(
+                    GeneralStatistics(m_baseName, Algorithm::CH, Phase::query, Metric::time,
+                        m_numOfNodes, m_numOfEdges,
+                        chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0),
+                    m_numSteps, CHPriority::shortcut),
+                src, tgt, distance, m_stalling),
+            counters);
         m_statistics << statistics << endl;
-        EXPECT_EQ(dis, get(distanceF, tgt));
+        EXPECT_EQ(dis, distance);
     }    
     verificationFile.close();
+
+    // the same queries in one batch on all cores
+    vector<pair<graph_traits<Graph>::vertex_descriptor, graph_traits<Graph>::vertex_descriptor>> queries;
+    vector<uint32_t> expected;
+    verificationFile.open(ss.str());
+    while (verificationFile >> src >> tgt >> dis) {
+        queries.push_back(make_pair(src, tgt));
+        expected.push_back(dis);
+    }
+    verificationFile.close();
+    using Engine = CHQueryEngine<Graph, decltype(weight), decltype(vertex_index), decltype(unpack),
+        decltype(order), decltype(direction)>;
+    BatchQueryExecutor<Engine> executor(Engine(sharedGraph, weight, vertex_index, unpack, order, direction,
+        m_stalling));
+    auto result = executor.Run(queries);
+    BatchQueryStatistics batchStatistics(
+        GeneralStatistics(m_baseName, Algorithm::CH, Phase::query, Metric::time,
+            m_numOfNodes, m_numOfEdges, result.WallTime / 1000000, 0),
+        executor.ThreadsCount(), result.Throughput(), result.Latencies);
+    m_statistics << batchStatistics << endl;
+    cout << batchStatistics << endl;
+    EXPECT_EQ(expected, result.Distances);
+
+    // the same batch on the query-only copy of the hierarchy
+    using SearchGraph = CHSearchGraph<weight_t, unpack_t, direction_t>;
+    start = std::chrono::high_resolution_clock::now();
+    SearchGraph search(graph, weight, unpack, order, direction);
+    end = std::chrono::high_resolution_clock::now();
+    cout << "search graph: " << search.GetGraph().EdgesCount() << " edges of " << num_edges(graph) << " in "
+        << chrono::duration_cast<chrono::milliseconds>(end - start).count() << " ms" << endl;
+    auto searchWeight = graph::get(weight_t(), search.GetGraph());
+    auto searchIndex = graph::get(vertex_index_t(), search.GetGraph());
+    auto searchUnpack = graph::get(unpack_t(), search.GetGraph());
+    auto searchDirection = graph::get(direction_t(), search.GetGraph());
+    vector<pair<SearchGraph::Vertex, SearchGraph::Vertex>> rankQueries;
+    for (const auto& query : queries) {
+        rankQueries.push_back(make_pair(search.Rank(query.first), search.Rank(query.second)));
+    }
+    using SearchEngine = CHQueryEngine<SearchGraph::Graph, decltype(searchWeight), decltype(searchIndex),
+        decltype(searchUnpack), decltype(searchIndex), decltype(searchDirection)>;
+    const SearchGraph::Graph& sharedSearchGraph = search.GetGraph();
+    BatchQueryExecutor<SearchEngine> searchExecutor(SearchEngine(sharedSearchGraph, searchWeight, searchIndex,
+        searchUnpack, searchIndex, searchDirection, m_stalling));
+    auto searchResult = searchExecutor.Run(rankQueries);
+    BatchQueryStatistics searchBatchStatistics(
+        GeneralStatistics(m_baseName, Algorithm::CH, Phase::query, Metric::time,
+            m_numOfNodes, m_numOfEdges, searchResult.WallTime / 1000000, 0),
+        searchExecutor.ThreadsCount(), searchResult.Throughput(), searchResult.Latencies);
+    m_statistics << searchBatchStatistics << endl;
+    cout << searchBatchStatistics << endl;
+    EXPECT_EQ(expected, searchResult.Distances);
+
+    // the path queries with the paths unpacked to the original edges, without and with the cache
+    for (size_t cacheCapacity : {size_t(0), size_t(1) << 20}) {
+        BatchQueryExecutor<SearchEngine> pathExecutor(SearchEngine(sharedSearchGraph, searchWeight, searchIndex,
+            searchUnpack, searchIndex, searchDirection, m_stalling, cacheCapacity));
+        auto pathResult = pathExecutor.Run(rankQueries, true);
+        BatchQueryStatistics pathBatchStatistics(
+            GeneralStatistics(m_baseName, Algorithm::CH, Phase::query, Metric::time,
+                m_numOfNodes, m_numOfEdges, pathResult.WallTime / 1000000, 0),
+            pathExecutor.ThreadsCount(), pathResult.Throughput(), pathResult.Latencies);
+        m_statistics << pathBatchStatistics << endl;
+        cout << "unpacked paths, cache of " << cacheCapacity << " vertices: " << pathBatchStatistics << endl;
+        EXPECT_EQ(expected, pathResult.Distances);
+    }
 };
 
 
+TEST_P(DdsgGraphAlgorithm, CHScaling) {
+    using Graph = GenerateCHGraph<predecessor_t, distanceF_t, distanceB_t, weight_t,
+        vertex_index_t, color_t, unpack_t, vertex_order_t, direction_t,
+        Properties<>, Properties<>, Properties<>> ::type;
+    // the queries do not change the contraction
+    if (m_stalling)
+        return;
+
+    // strong scaling: the same contraction on 1, 2, 4, ... threads up to the hardware threads
+    std::vector<size_t> threadCounts;
+    for (size_t threadsCount = 1; threadsCount < graphUtil::DefaultThreadsCount(); threadsCount *= 2)
+        threadCounts.push_back(threadsCount);
+    threadCounts.push_back(graphUtil::DefaultThreadsCount());
+    uint64_t sequentialTime = 0;
+    size_t sequentialEdges = 0;
+    for (size_t threadsCount : threadCounts) {
+        Graph graph(m_ddsgVec.begin(), m_ddsgVec.end(), m_numOfNodes, m_numOfEdges);
+        auto predecessor = graph::get(predecessor_t(), graph);
+        auto distanceF = graph::get(distanceF_t(), graph);
+        auto weight = graph::get(weight_t(), graph);
+        auto vertex_index = graph::get(vertex_index_t(), graph);
+        auto color = graph::get(color_t(), graph);
+        auto unpack = graph::get(unpack_t(), graph);
+        auto order = graph::get(vertex_order_t(), graph);
+        auto direction = graph::get(direction_t(), graph);
+        auto start = std::chrono::high_resolution_clock::now();
+        ch_preprocess<Graph>(graph, predecessor, distanceF, weight, vertex_index,
+            color, unpack, order, direction, m_numSteps, ShortCutOrderStrategy<Graph>(), threadsCount);
+        auto end = std::chrono::high_resolution_clock::now();
+        uint64_t time = chrono::duration_cast<chrono::milliseconds>(end - start).count();
+        ParallelCHMetricStatistics statistics(
+            CHMetricStatistics(
+                GeneralStatistics(m_baseName, Algorithm::CH, Phase::metric, Metric::time,
+                    m_numOfNodes, m_numOfEdges, time, 0),
+                m_numSteps, CHPriority::shortcut),
+            threadsCount);
+        m_statistics << statistics << endl;
+        // the rounds do not depend on the threads
+        if (threadsCount == 1) {
+            sequentialTime = time;
+            sequentialEdges = num_edges(graph);
+        }
+        EXPECT_EQ(sequentialEdges, num_edges(graph));
+        cout << "contraction on " << threadsCount << " threads: " << time << " ms, "
+            << num_edges(graph) << " edges, speedup " << (time == 0 ? 0 : double(sequentialTime) / time) << endl;
+    }
+};
+
 INSTANTIATE_TEST_CASE_P(CommandLine, DdsgGraphAlgorithm,
-    ::testing::Combine(::testing::Values("deu.ddsg"), ::testing::Values(20), ::testing::Values(false)));
+    ::testing::Combine(::testing::Values("deu.ddsg"), ::testing::Values(20), ::testing::Bool()));
 
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
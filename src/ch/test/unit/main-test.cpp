@@ -1,8 +1,362 @@
 #include <gtest/gtest.h>
+#include <random>
+#include <vector>
 #include <graph/dynamic_graph.hpp>
 #include <graph/static_graph.hpp>
+#include <graph/search_counters.hpp>
+#include <ch/contraction_hierarchy.hpp>
+#include <ch/search_graph.hpp>
+
+using namespace std;
+using namespace graph;
+using namespace ch;
+
+struct distanceF_t {};
+struct distanceB_t {};
+struct color_t {};
+struct predecessor_t {};
+struct weight_t {};
+struct unpack_t {};
+struct vertex_order_t {};
+struct direction_t {};
+
+using Graph = GenerateCHGraph<predecessor_t, distanceF_t, distanceB_t, weight_t,
+    vertex_index_t, color_t, unpack_t, vertex_order_t, direction_t,
+    Properties<>, Properties<>, Properties<>>::type;
+using Vertex = graph_traits<Graph>::vertex_descriptor;
+using EdgeList = vector<pair<pair<size_t, size_t>,
+    Properties<Property<weight_t, uint32_t>, Property<direction_t, DirectionBit>>>>;
+
+// Every edge at both of its ends like read_ddsg does: a ring of two-way roads with random
+// two-way and one-way chords
+EdgeList MakeEdges(size_t n, uint32_t seed) {
+    EdgeList edges;
+    mt19937 generator(seed);
+    uniform_int_distribution<size_t> vertexDistribution(0, n - 1);
+    uniform_int_distribution<uint32_t> weightDistribution(1, 100);
+    auto addEdge = [&](size_t u, size_t v, bool oneWay) {
+        auto w = weightDistribution(generator);
+        edges.push_back(make_pair(make_pair(u, v), graph::make_properties(Property<weight_t, uint32_t>(w),
+            Property<direction_t, DirectionBit>(oneWay ? DirectionBit::forward : DirectionBit::both))));
+        edges.push_back(make_pair(make_pair(v, u), graph::make_properties(Property<weight_t, uint32_t>(w),
+            Property<direction_t, DirectionBit>(oneWay ? DirectionBit::backward : DirectionBit::both))));
+    };
+    for (size_t v = 0; v < n; ++v) {
+        addEdge(v, (v + 1) % n, false);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        auto u = vertexDistribution(generator);
+        auto v = vertexDistribution(generator);
+        if (u != v)
+            addEdge(u, v, i % 3 == 0);
+    }
+    std::stable_sort(edges.begin(), edges.end(), [](const auto& left, const auto& right) {
+        return left.first.first < right.first.first;
+    });
+    return edges;
+}
+
+// Plain dijkstra over the forward edges, the distances of the original graph
+template <typename DirectionMap>
+struct SkipBackwardEdgesVisitor : public DefaultDijkstraVisitor<Graph> {
+    SkipBackwardEdgesVisitor(const DirectionMap& direction) :direction(direction) {};
+    bool should_relax(const graph_traits<Graph>::edge_descriptor& e, const Graph&) {
+        return get(direction, e) != DirectionBit::backward;
+    }
+    DirectionMap direction;
+};
+
+TEST(CH, ContractionKeepsDistances) {
+    const size_t n = 400;
+    auto edges = MakeEdges(n, 7);
+    Graph original(edges.begin(), edges.end(), n, edges.size());
+    Graph graph(edges.begin(), edges.end(), n, edges.size());
+    auto predecessor = graph::get(predecessor_t(), graph);
+    auto distance = graph::get(distanceF_t(), graph);
+    auto weight = graph::get(weight_t(), graph);
+    auto index = graph::get(vertex_index_t(), graph);
+    auto color = graph::get(color_t(), graph);
+    auto unpack = graph::get(unpack_t(), graph);
+    auto order = graph::get(vertex_order_t(), graph);
+    auto direction = graph::get(direction_t(), graph);
+    ch_preprocess(graph, predecessor, distance, weight, index, color, unpack, order, direction, 50);
+
+    // the order is a permutation
+    vector<char> ranked(n, 0);
+    for (auto v : graphUtil::Range(vertices(graph))) {
+        ASSERT_LT(graph::get(order, v), n);
+        EXPECT_FALSE(ranked[graph::get(order, v)]);
+        ranked[graph::get(order, v)] = 1;
+    }
+    // a shortcut replaces two lighter edges through a vertex contracted before both ends
+    size_t shortcuts = 0;
+    for (auto u : graphUtil::Range(vertices(graph))) {
+        for (auto e : graphUtil::Range(out_edges(u, graph))) {
+            auto middle = graph::get(unpack, e);
+            if (middle == NoMiddleVertex<decltype(unpack)>())
+                continue;
+            ++shortcuts;
+            auto w = target(e, graph);
+            EXPECT_LT(graph::get(order, middle), graph::get(order, u));
+            EXPECT_LT(graph::get(order, middle), graph::get(order, w));
+            // the edge from u to w for the forward bit, from w to u for the backward bit
+            auto from = graph::get(direction, e) == DirectionBit::forward ? u : w;
+            auto to = from == u ? w : u;
+            uint32_t first = numeric_limits<uint32_t>::max(), second = numeric_limits<uint32_t>::max();
+            for (auto me : graphUtil::Range(out_edges(middle, graph))) {
+                if (target(me, graph) == from && graph::get(direction, me) != DirectionBit::forward)
+                    first = min(first, graph::get(weight, me));
+                if (target(me, graph) == to && graph::get(direction, me) != DirectionBit::backward)
+                    second = min(second, graph::get(weight, me));
+            }
+            EXPECT_EQ(graph::get(weight, e), first + second);
+        }
+    }
+    EXPECT_GT(shortcuts, 0u);
+
+    // the shortest paths go up from s and down to t
+    const Graph& sharedOriginal = original;
+    QueryContext<Graph> reference(sharedOriginal);
+    const Graph& sharedGraph = graph;
+    QueryContext<Graph> forward(sharedGraph);
+    QueryContext<Graph> backward(sharedGraph);
+    auto originalWeight = graph::get(weight_t(), original);
+    auto originalIndex = graph::get(vertex_index_t(), original);
+    auto originalDirection = graph::get(direction_t(), original);
+    vector<Vertex> path;
+    for (Vertex s = 0; s < n; s += 31) {
+        dijkstra(sharedOriginal, s, originalWeight, originalIndex, reference,
+            SkipBackwardEdgesVisitor<decltype(originalDirection)>(originalDirection));
+        for (Vertex t = 0; t < n; t += 17) {
+            auto expected = reference.IsReached(t) ? graph::get(reference.Distance(), t)
+                : numeric_limits<uint32_t>::max();
+            for (bool stalling : {false, true}) {
+                SearchCounters counters;
+                ch_query(sharedGraph, s, t, weight, index, order, direction, forward, backward, stalling, counters);
+                ASSERT_EQ(expected, graph::get(forward.Distance(), t)) << s << " " << t << " " << stalling;
+                EXPECT_GT(counters.SettledVertices, 0u);
+                if (expected == numeric_limits<uint32_t>::max())
+                    continue;
+                // the path in the hierarchy is as long as the distance
+                forward.Path(s, t, path);
+                uint32_t length = 0;
+                for (size_t i = 1; i < path.size(); ++i) {
+                    uint32_t lightest = numeric_limits<uint32_t>::max();
+                    for (auto e : graphUtil::Range(out_edges(path[i - 1], graph))) {
+                        if (target(e, graph) == path[i] && graph::get(direction, e) != DirectionBit::backward)
+                            lightest = min(lightest, graph::get(weight, e));
+                    }
+                    ASSERT_NE(lightest, numeric_limits<uint32_t>::max());
+                    length += lightest;
+                }
+                EXPECT_EQ(expected, length);
+            }
+        }
+    }
+}
+
+TEST(CH, SearchGraphAnswersLikeTheHierarchy) {
+    const size_t n = 400;
+    auto edges = MakeEdges(n, 11);
+    Graph graph(edges.begin(), edges.end(), n, edges.size());
+    auto predecessor = graph::get(predecessor_t(), graph);
+    auto distance = graph::get(distanceF_t(), graph);
+    auto weight = graph::get(weight_t(), graph);
+    auto index = graph::get(vertex_index_t(), graph);
+    auto color = graph::get(color_t(), graph);
+    auto unpack = graph::get(unpack_t(), graph);
+    auto order = graph::get(vertex_order_t(), graph);
+    auto direction = graph::get(direction_t(), graph);
+    ch_preprocess(graph, predecessor, distance, weight, index, color, unpack, order, direction, 50);
+
+    using SearchGraph = CHSearchGraph<weight_t, unpack_t, direction_t>;
+    SearchGraph search(graph, weight, unpack, order, direction);
+    auto& searchGraph = search.GetGraph();
+    EXPECT_EQ(n, num_vertices(searchGraph));
+    // every edge once, at its lower end
+    EXPECT_LE(2 * searchGraph.EdgesCount(), num_edges(graph));
+    auto searchWeight = graph::get(weight_t(), searchGraph);
+    auto searchIndex = graph::get(vertex_index_t(), searchGraph);
+    auto searchUnpack = graph::get(unpack_t(), searchGraph);
+    auto searchDirection = graph::get(direction_t(), searchGraph);
+    for (auto v : graphUtil::Range(vertices(searchGraph))) {
+        EXPECT_EQ(v, search.Rank(search.Original(v)));
+        for (auto e : graphUtil::Range(out_edges(v, searchGraph))) {
+            EXPECT_GT(target(e, searchGraph), v);
+            auto middle = graph::get(searchUnpack, e);
+            if (middle != NoMiddleVertex<decltype(searchUnpack)>()) {
+                EXPECT_LT(middle, v);
+            }
+        }
+    }
+
+    const Graph& sharedGraph = graph;
+    QueryContext<Graph> forward(sharedGraph);
+    QueryContext<Graph> backward(sharedGraph);
+    const SearchGraph::Graph& sharedSearchGraph = searchGraph;
+    QueryContext<SearchGraph::Graph> searchForward(sharedSearchGraph);
+    QueryContext<SearchGraph::Graph> searchBackward(sharedSearchGraph);
+    vector<SearchGraph::Vertex> path;
+    for (Vertex s = 0; s < n; s += 23) {
+        for (Vertex t = 0; t < n; t += 13) {
+            for (bool stalling : {false, true}) {
+                ch_query(sharedGraph, s, t, weight, index, order, direction, forward, backward, stalling);
+                ch_query(sharedSearchGraph, search.Rank(s), search.Rank(t), searchWeight, searchIndex, searchIndex,
+                    searchDirection, searchForward, searchBackward, stalling);
+                auto expected = graph::get(forward.Distance(), t);
+                ASSERT_EQ(expected, graph::get(searchForward.Distance(), search.Rank(t))) << s << " " << t;
+                if (expected == numeric_limits<uint32_t>::max())
+                    continue;
+                searchForward.Path(search.Rank(s), search.Rank(t), path);
+                EXPECT_EQ(s, search.Original(path.front()));
+                EXPECT_EQ(t, search.Original(path.back()));
+            }
+        }
+    }
+}
+
+TEST(CH, ParallelContractionDoesNotDependOnThreads) {
+    const size_t n = 400;
+    auto edges = MakeEdges(n, 13);
+    vector<size_t> ranks[2];
+    size_t edgesCount[2];
+    size_t threads[2] = {1, 4};
+    for (size_t run = 0; run < 2; ++run) {
+        Graph graph(edges.begin(), edges.end(), n, edges.size());
+        auto predecessor = graph::get(predecessor_t(), graph);
+        auto distance = graph::get(distanceF_t(), graph);
+        auto weight = graph::get(weight_t(), graph);
+        auto index = graph::get(vertex_index_t(), graph);
+        auto color = graph::get(color_t(), graph);
+        auto unpack = graph::get(unpack_t(), graph);
+        auto order = graph::get(vertex_order_t(), graph);
+        auto direction = graph::get(direction_t(), graph);
+        ch_preprocess(graph, predecessor, distance, weight, index, color, unpack, order, direction, 50,
+            ShortCutOrderStrategy<Graph>(), threads[run]);
+        for (auto v : graphUtil::Range(vertices(graph))) {
+            ranks[run].push_back(graph::get(order, v));
+        }
+        edgesCount[run] = num_edges(graph);
+    }
+    EXPECT_EQ(ranks[0], ranks[1]);
+    EXPECT_EQ(edgesCount[0], edgesCount[1]);
+}
+
+TEST(CH, ContractionDeletesEachNeighbourOnce) {
+    // 0 and 2 are two-way neighbours of 1, 3 a one-way neighbour
+    EdgeList edges;
+    auto addEdge = [&](size_t u, size_t v, DirectionBit forward, DirectionBit backward) {
+        edges.push_back(make_pair(make_pair(u, v), graph::make_properties(Property<weight_t, uint32_t>(1),
+            Property<direction_t, DirectionBit>(forward))));
+        edges.push_back(make_pair(make_pair(v, u), graph::make_properties(Property<weight_t, uint32_t>(1),
+            Property<direction_t, DirectionBit>(backward))));
+    };
+    addEdge(0, 1, DirectionBit::both, DirectionBit::both);
+    addEdge(1, 2, DirectionBit::both, DirectionBit::both);
+    addEdge(1, 3, DirectionBit::forward, DirectionBit::backward);
+    std::stable_sort(edges.begin(), edges.end(), [](const auto& left, const auto& right) {
+        return left.first.first < right.first.first;
+    });
+    Graph graph(edges.begin(), edges.end(), 4, edges.size());
+    auto weight = graph::get(weight_t(), graph);
+    auto index = graph::get(vertex_index_t(), graph);
+    auto unpack = graph::get(unpack_t(), graph);
+    auto direction = graph::get(direction_t(), graph);
+    using GraphContractor = ch::detail::Contractor<Graph, decltype(weight), decltype(index), decltype(unpack),
+        decltype(direction)>;
+    GraphContractor contractor(graph, weight, index, unpack, direction, 50);
+    vector<GraphContractor::Shortcut> shortcuts;
+    contractor.Simulate(1, shortcuts);
+    contractor.Contract(1, shortcuts);
+    for (Vertex v : {0, 2, 3}) {
+        shortcuts.clear();
+        EXPECT_EQ(1u, contractor.Simulate(v, shortcuts).deletedNeighbours) << v;
+    }
+}
+
+TEST(CH, UnpackedPathsUseOriginalEdges) {
+    const size_t n = 400;
+    auto edges = MakeEdges(n, 17);
+    Graph original(edges.begin(), edges.end(), n, edges.size());
+    Graph graph(edges.begin(), edges.end(), n, edges.size());
+    auto predecessor = graph::get(predecessor_t(), graph);
+    auto distance = graph::get(distanceF_t(), graph);
+    auto weight = graph::get(weight_t(), graph);
+    auto index = graph::get(vertex_index_t(), graph);
+    auto color = graph::get(color_t(), graph);
+    auto unpack = graph::get(unpack_t(), graph);
+    auto order = graph::get(vertex_order_t(), graph);
+    auto direction = graph::get(direction_t(), graph);
+    ch_preprocess(graph, predecessor, distance, weight, index, color, unpack, order, direction, 50);
+    using SearchGraph = CHSearchGraph<weight_t, unpack_t, direction_t>;
+    SearchGraph search(graph, weight, unpack, order, direction);
+    auto searchWeight = graph::get(weight_t(), search.GetGraph());
+    auto searchIndex = graph::get(vertex_index_t(), search.GetGraph());
+    auto searchUnpack = graph::get(unpack_t(), search.GetGraph());
+    auto searchDirection = graph::get(direction_t(), search.GetGraph());
+    const SearchGraph::Graph& sharedSearchGraph = search.GetGraph();
+
+    auto originalWeight = graph::get(weight_t(), original);
+    auto originalDirection = graph::get(direction_t(), original);
+    // the length of the path over the lightest original edges, max when an edge is missing
+    auto pathLength = [&](const vector<Vertex>& path) {
+        uint64_t length = 0;
+        for (size_t i = 1; i < path.size(); ++i) {
+            uint64_t lightest = numeric_limits<uint32_t>::max();
+            for (auto e : graphUtil::Range(out_edges(path[i - 1], original))) {
+                if (target(e, original) == path[i] && graph::get(originalDirection, e) != DirectionBit::backward)
+                    lightest = min<uint64_t>(lightest, graph::get(originalWeight, e));
+            }
+            if (lightest == numeric_limits<uint32_t>::max())
+                return lightest;
+            length += lightest;
+        }
+        return length;
+    };
+
+    const Graph& sharedGraph = graph;
+    QueryContext<Graph> forward(sharedGraph);
+    QueryContext<Graph> backward(sharedGraph);
+    PathUnpacker<Graph, decltype(weight), decltype(unpack), decltype(direction)> cached(
+        sharedGraph, weight, unpack, direction, 1000);
+    using SearchEngine = CHQueryEngine<SearchGraph::Graph, decltype(searchWeight), decltype(searchIndex),
+        decltype(searchUnpack), decltype(searchIndex), decltype(searchDirection)>;
+    SearchEngine engine(sharedSearchGraph, searchWeight, searchIndex, searchUnpack, searchIndex, searchDirection,
+        true, 1000);
+    auto context = engine.CreateContext();
+    vector<Vertex> hops, unpacked, unpackedCached;
+    vector<SearchGraph::Vertex> searchPath;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (Vertex s = 0; s < n; s += 29) {
+            for (Vertex t = 0; t < n; t += 19) {
+                ch_query(sharedGraph, s, t, weight, index, order, direction, forward, backward);
+                auto expected = graph::get(forward.Distance(), t);
+                if (expected == numeric_limits<uint32_t>::max())
+                    continue;
+                forward.Path(s, t, hops);
+                ch_unpack(sharedGraph, weight, unpack, direction, hops, unpacked);
+                ASSERT_EQ(s, unpacked.front());
+                ASSERT_EQ(t, unpacked.back());
+                EXPECT_EQ(expected, pathLength(unpacked)) << s << " " << t;
+                cached.Unpack(hops, unpackedCached);
+                EXPECT_EQ(unpacked, unpackedCached);
+
+                // the search graph path in ranks
+                ASSERT_EQ(expected, engine.Query(context, search.Rank(s), search.Rank(t)));
+                engine.Path(context, search.Rank(s), search.Rank(t), searchPath);
+                vector<Vertex> originalPath;
+                for (auto v : searchPath) {
+                    originalPath.push_back(search.Original(v));
+                }
+                EXPECT_EQ(expected, pathLength(originalPath)) << s << " " << t;
+            }
+        }
+    }
+    // the second pass finds the shortcut hops of the first one
+    EXPECT_GT(cached.CacheHits(), 0u);
+}
 
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}
@@ -6,12 +6,13 @@
 #include <algorithm>
 
 namespace GraphStatistics {
-#define Properties VertexProperties, EdgeProperties
+#define StaticGraphTemplate template <typename VertexProperties, typename EdgeProperties, typename Layout, typename Links>
+#define StaticGraphType graph::StaticGraph<VertexProperties, EdgeProperties, Layout, Links>
 
-	template <typename VertexProperties, typename EdgeProperties>
-	inline typename graph::StaticGraph<Properties>::degree_size_type GetMaximalVertexDegree(
-		const graph::StaticGraph<Properties>& graph) {
-		using DegreeType = typename graph::StaticGraph<Properties>::degree_size_type;
+	StaticGraphTemplate
+	inline typename StaticGraphType::degree_size_type GetMaximalVertexDegree(
+		const StaticGraphType& graph) {
+		using DegreeType = typename StaticGraphType::degree_size_type;
 		DegreeType maxDegree = std::numeric_limits<DegreeType>::min();
 
 		for (auto& v : graph.Vertices()) {
@@ -21,10 +22,10 @@ namespace GraphStatistics {
 		return maxDegree;
 	}
 
-	template <typename VertexProperties, typename EdgeProperties>
-	inline typename graph::StaticGraph<Properties>::degree_size_type GetMinimalVertexDegree(
-		const graph::StaticGraph<Properties>& graph) {
-		using DegreeType = typename graph::StaticGraph<Properties>::degree_size_type;
+	StaticGraphTemplate
+	inline typename StaticGraphType::degree_size_type GetMinimalVertexDegree(
+		const StaticGraphType& graph) {
+		using DegreeType = typename StaticGraphType::degree_size_type;
 		DegreeType minDegree = std::numeric_limits<DegreeType>::max();
 
 		for (auto& v : graph.Vertices()) {
@@ -36,9 +37,9 @@ namespace GraphStatistics {
 		return minDegree;
 	}
 
-	template <typename VertexProperties, typename EdgeProperties>
-	inline double GetAverageVertexDegree(const graph::StaticGraph<Properties>& graph) {
-		using VerticesSizeType = typename graph::StaticGraph<Properties>::vertices_size_type;
+	StaticGraphTemplate
+	inline double GetAverageVertexDegree(const StaticGraphType& graph) {
+		using VerticesSizeType = typename StaticGraphType::vertices_size_type;
 		VerticesSizeType nonEmptyVertexCount = 0;
 
 		for (auto& v : graph.Vertices()) {
@@ -50,10 +51,10 @@ namespace GraphStatistics {
 		return (double)num_edges(graph) / (double)nonEmptyVertexCount;
 	}
 
-	template <typename VertexProperties, typename EdgeProperties>
-	inline typename graph::StaticGraph<Properties>::edges_size_type GetSingleOrientedEdgesCount(
-		const graph::StaticGraph<Properties>& graph) {
-		using EdgesSizeType = typename graph::StaticGraph<Properties>::vertices_size_type;
+	StaticGraphTemplate
+	inline typename StaticGraphType::edges_size_type GetSingleOrientedEdgesCount(
+		const StaticGraphType& graph) {
+		using EdgesSizeType = typename StaticGraphType::vertices_size_type;
 		EdgesSizeType result = 0;
 
 		for (auto& source : graph.Vertices()) {
@@ -65,4 +66,6 @@ namespace GraphStatistics {
 
 		return result;
 	}
+#undef StaticGraphType
+#undef StaticGraphTemplate
 }
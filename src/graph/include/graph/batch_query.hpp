@@ -0,0 +1,156 @@
+#pragma once
+#include <graph/dijkstra.hpp>
+#include <graph/bidirectional_dijkstra.hpp>
+#include <graph/detail/util/ThreadPool.hpp>
+#include <atomic>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+namespace graph
+{
+	// An engine answers the point-to-point queries of BatchQueryExecutor on a shared graph:
+	//   Context CreateContext() const - the search state of one worker, reused by all its queries
+	//   Distance Query(Context&, s, t) const - the distance from s to t, InfinityDistance when t is not reachable
+	//   void Path(Context&, s, t, std::vector<Vertex>&) const - the path found by the last Query of the context
+	// Engines are called from several threads at once.
+	template <typename Graph, typename WeightMap, typename IndexMap, typename QueuePolicy = queue::DijkstraQueuePolicy>
+	class DijkstraQueryEngine {
+	public:
+		using Vertex = typename graph_traits<Graph>::vertex_descriptor;
+		using Distance = uint32_t;
+		using Context = QueryContext<Graph, Distance, QueuePolicy>;
+
+		DijkstraQueryEngine(const Graph& graph, const WeightMap& weight, const IndexMap& index)
+			: graph(graph),
+			  weight(weight),
+			  index(index) {}
+
+		Context CreateContext() const {
+			return Context(graph, index);
+		}
+
+		Distance Query(Context& context, const Vertex& s, const Vertex& t) const {
+			dijkstra(graph, s, weight, index, context, TargetDijkstraVisitor<Graph, QueuePolicy>(t));
+			return context.IsReached(t) ? get(context.Distance(), t) : InfinityDistance<typename Context::DistanceMap>();
+		}
+
+		void Path(Context& context, const Vertex& s, const Vertex& t, std::vector<Vertex>& path) const {
+			context.Path(s, t, path);
+		}
+
+	private:
+		const Graph& graph;
+		WeightMap weight;
+		IndexMap index;
+	};
+
+	template <typename Graph, typename WeightMap, typename IndexMap, typename QueuePolicy = queue::DijkstraQueuePolicy>
+	class BidirectionalDijkstraQueryEngine {
+		using SearchContext = QueryContext<Graph, uint32_t, QueuePolicy>;
+	public:
+		using Vertex = typename graph_traits<Graph>::vertex_descriptor;
+		using Distance = uint32_t;
+		struct Context {
+			SearchContext Forward;
+			SearchContext Backward;
+		};
+
+		BidirectionalDijkstraQueryEngine(const Graph& graph, const WeightMap& weight, const IndexMap& index)
+			: graph(graph),
+			  weight(weight),
+			  index(index) {}
+
+		Context CreateContext() const {
+			return Context{SearchContext(graph, index), SearchContext(graph, index)};
+		}
+
+		Distance Query(Context& context, const Vertex& s, const Vertex& t) const {
+			// the distance of t is written only when a path is found
+			using DistanceMap = typename SearchContext::DistanceMap;
+			put(context.Forward.Distance(), t, InfinityDistance<DistanceMap>());
+			bidirectional_dijkstra(graph, s, t, weight, index, context.Forward, context.Backward);
+			return get(context.Forward.Distance(), t);
+		}
+
+		void Path(Context& context, const Vertex& s, const Vertex& t, std::vector<Vertex>& path) const {
+			context.Forward.Path(s, t, path);
+		}
+
+	private:
+		const Graph& graph;
+		WeightMap weight;
+		IndexMap index;
+	};
+
+	template <typename Vertex, typename Distance>
+	struct BatchQueryResult {
+		// in the order of the queries, the paths are filled when requested and empty for unreachable targets
+		std::vector<Distance> Distances;
+		std::vector<std::vector<Vertex>> Paths;
+		// time of every query and of the whole batch, nanoseconds
+		std::vector<uint64_t> Latencies;
+		uint64_t WallTime;
+
+		double Throughput() const {
+			return WallTime == 0 ? 0 : Distances.size() * 1e9 / WallTime;
+		}
+	};
+
+	// Runs batches of point-to-point queries on a fixed thread pool, every worker keeps one search
+	// context of the engine for all its queries. The workers take the queries one by one,
+	// so a few long queries do not hold up the batch.
+	template <typename Engine>
+	class BatchQueryExecutor {
+	public:
+		using Vertex = typename Engine::Vertex;
+		using Distance = typename Engine::Distance;
+		using Result = BatchQueryResult<Vertex, Distance>;
+
+		explicit BatchQueryExecutor(const Engine& engine, size_t threadsCount = graphUtil::DefaultThreadsCount())
+			: engine(engine),
+			  pool(threadsCount) {
+			contexts.reserve(pool.Size());
+			for (size_t worker = 0; worker < pool.Size(); ++worker) {
+				contexts.push_back(engine.CreateContext());
+			}
+		}
+
+		size_t ThreadsCount() const {
+			return pool.Size();
+		}
+
+		Result Run(const std::vector<std::pair<Vertex, Vertex>>& queries, bool withPaths = false) {
+			using Clock = std::chrono::steady_clock;
+			Result result;
+			result.Distances.resize(queries.size());
+			result.Latencies.resize(queries.size());
+			if (withPaths)
+				result.Paths.resize(queries.size());
+
+			std::atomic<size_t> nextQuery(0);
+			auto batchStart = Clock::now();
+			pool.Run([&](size_t worker) {
+				auto& context = contexts[worker];
+				for (size_t i = nextQuery++; i < queries.size(); i = nextQuery++) {
+					const auto& s = queries[i].first;
+					const auto& t = queries[i].second;
+					auto queryStart = Clock::now();
+					result.Distances[i] = engine.Query(context, s, t);
+					if (withPaths && result.Distances[i] != std::numeric_limits<Distance>::max())
+						engine.Path(context, s, t, result.Paths[i]);
+					result.Latencies[i] = static_cast<uint64_t>(
+						std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - queryStart).count());
+				}
+			});
+			result.WallTime = static_cast<uint64_t>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - batchStart).count());
+			return result;
+		}
+
+	private:
+		Engine engine;
+		graphUtil::ThreadPool pool;
+		std::vector<typename Engine::Context> contexts;
+	};
+}
@@ -7,17 +7,18 @@ namespace graph
 	template <typename PredecessorMapFTag, typename PredecessorMapBTag,
 	          typename DisanceMapFTag, typename DisanceMapBTag, typename WeightMapTag,
 	          typename IndexMapTag, typename ColorMapFTag, typename ColorMapBTag,
-	          typename BundledVertexProperties, typename BundledEdgeProperties>
+	          typename BundledVertexProperties, typename BundledEdgeProperties,
+	          typename Layout = ColumnLayoutTag>
 	struct GenerateBiDijkstraGraph {};
 
 
 	template <typename PredecessorMapFTag, typename PredecessorMapBTag,
 	          typename DisanceMapFTag, typename DisanceMapBTag,
 	          typename WeightMapTag, typename IndexMapTag, typename ColorMapFTag,
-	          typename ColorMapBTag, typename... P1s, typename... P2s>
+	          typename ColorMapBTag, typename... P1s, typename... P2s, typename Layout>
 	struct GenerateBiDijkstraGraph<PredecessorMapFTag, PredecessorMapBTag,
 	                               DisanceMapFTag, DisanceMapBTag, WeightMapTag,
-	                               IndexMapTag, ColorMapFTag, ColorMapBTag, Properties<P1s...>, Properties<P2s...>> {
+	                               IndexMapTag, ColorMapFTag, ColorMapBTag, Properties<P1s...>, Properties<P2s...>, Layout> {
 		using type = StaticGraph<
 			Properties<
 				Property<PredecessorMapFTag,
@@ -31,7 +32,8 @@ namespace graph
 				P1s...>,
 			Properties<
 				Property<WeightMapTag, uint32_t>,
-				P2s...>>;
+				P2s...>,
+			Layout>;
 	};
 
 	template <typename Graph, typename IndexMap,
@@ -102,9 +104,14 @@ namespace graph
 		ColorMapB& colorB;
 	};
 
+	// Calls the hooks of both visitors, the search uses the queue of the main one
 	template <typename Graph, typename MainVisitor, typename AdditionalVisitor>
 	class DijkstraVisitorCombinator : public IDijkstraVisitor<Graph> {
 	public:
+		void Initialize(const Graph& g) {
+			mainVisitor.Initialize(g);
+		}
+
 		void initialize_vertex(const typename graph_traits<Graph>::vertex_descriptor& v, Graph& g) {
 			mainVisitor.initialize_vertex(v, g);
 			additionalVisitor.initialize_vertex(v, g);
@@ -239,12 +246,31 @@ namespace graph
 		uint32_t dis = optTracker.mu;
 		put(distanceF, t, dis);
 		
+		// the backward tree path from the transit node to t, t included
 		Vertex predecessor = optTracker.transitNode;
-		Vertex current = get(predecessorB, predecessor);
-		while (current != t) {
+		while (predecessor != t) {
+			Vertex current = get(predecessorB, predecessor);
 			put(predecessorF, current, predecessor);
 			predecessor = current;
-			current = get(predecessorB, current);
 		}
 	}
+
+	// The search on a shared graph: the forward search runs in the forward context and the backward one
+	// in the backward context, the distance and the path to t are written to the forward context
+	template <class Graph, class WeightMap, class IndexMap, class DistanceType, class QueuePolicy>
+	void bidirectional_dijkstra(const Graph& graph,
+	                            const typename graph_traits<Graph>::vertex_descriptor& s,
+	                            const typename graph_traits<Graph>::vertex_descriptor& t,
+	                            WeightMap& weight, IndexMap& index,
+	                            QueryContext<Graph, DistanceType, QueuePolicy>& forward,
+	                            QueryContext<Graph, DistanceType, QueuePolicy>& backward) {
+		using SharedDataStorage = typename QueryContext<Graph, DistanceType, QueuePolicy>::SharedDataStorage;
+		DefaultDijkstraVisitor<Graph, QueuePolicy> visitorF;
+		DefaultDijkstraVisitor<Graph, QueuePolicy> visitorB;
+		detail::StoredDataLoan<SharedDataStorage> loanF(forward.Stored, visitorF.Stored);
+		detail::StoredDataLoan<SharedDataStorage> loanB(backward.Stored, visitorB.Stored);
+		bidirectional_dijkstra(graph, s, t, forward.Predecessor(), backward.Predecessor(),
+		                       forward.Distance(), backward.Distance(), weight, index,
+		                       forward.Color(), backward.Color(), visitorF, visitorB);
+	}
 }
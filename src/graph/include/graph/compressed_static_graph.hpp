@@ -0,0 +1,484 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cinttypes>
+#include <memory>
+#include <limits>
+#include <stdexcept>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include "graph/static_graph.hpp"
+#include "detail/CompressedGraphIterators.hpp"
+
+namespace graph {
+	// Read-only copy of a StaticGraph which keeps the out and in links of every vertex as delta-varint blocks,
+	// see CompressedEdgeIterator for the encoding. The edges are renumbered in the out links order,
+	// so out links need no stored edge id. Road networks take 1-2 bytes per out link and 3-5 per in link
+	// instead of 8 + 8 bytes.
+	// Build it from a GraphBuilder (or the pair iterators, which fill one) to save memory: the edges are
+	// encoded straight from the builder with 4 more bytes per edge. A copy of a StaticGraph holds the
+	// source graph and the compressed one at the same time.
+	template <typename VertexProperties = NoProperties, typename EdgeProperties = NoProperties,
+			  typename Layout = RowLayoutTag>
+	class CompressedStaticGraph {
+	public:
+		using type = CompressedStaticGraph<VertexProperties, EdgeProperties, Layout>;
+		using SourceGraphType = StaticGraph<VertexProperties, EdgeProperties, Layout>;
+		using Builder = typename SourceGraphType::Builder;
+
+		using edge_size_type = uint32_t;
+		using vertices_size_type = uint32_t;
+		using edges_size_type = uint32_t;
+		using degree_size_type = uint32_t;
+		using vertex_descriptor = vertices_size_type;
+		using directed_category = directed_tag;
+		using edge_parallel_category = disallow_parallel_edge_tag;
+		using traversal_category = StaticGraphTraversalCategory;
+
+		using layout_category = Layout;
+
+		using edge_descriptor = FancyEdgeDescriptor<vertex_descriptor, edges_size_type>;
+
+		using VertexPropertyMapType = std::conditional_t<
+			std::is_same<Layout, ColumnLayoutTag>::value,
+			ColumnPropertyMap<VertexProperties, vertex_descriptor>,
+			VertexPropertyMap<VertexProperties, type>>;
+		using EdgePropertyMapType = std::conditional_t<
+			std::is_same<Layout, ColumnLayoutTag>::value,
+			ColumnPropertyMap<EdgeProperties, edge_descriptor>,
+			EdgePropertyMap<EdgeProperties, type>>;
+		using vertex_bundled = VertexProperties;
+		using edge_bundled = EdgeProperties;
+
+	private:
+		using VertexPropertiesStorageType = detail::PropertiesStorage<VertexProperties, Layout>;
+		using EdgePropertiesStorageType = detail::PropertiesStorage<EdgeProperties, Layout>;
+		using OffsetsVecType = graphUtil::MappedArray<edges_size_type>;
+		using BlocksVecType = graphUtil::MappedArray<uint8_t>;
+
+	public:
+		using vertex_iterator = boost::counting_iterator<vertex_descriptor>;
+		using out_edge_iterator = CompressedEdgeIterator<edge_descriptor, internals::EdgeDirection::Out>;
+		using in_edge_iterator = CompressedEdgeIterator<edge_descriptor, internals::EdgeDirection::In>;
+		using adjacency_iterator = CompressedAdjacencyIterator<vertex_descriptor, edges_size_type>;
+
+		using InEdgeCollection = graphUtil::Collection<in_edge_iterator>;
+		using OutEdgeCollection = graphUtil::Collection<out_edge_iterator>;
+		using AdjacencyCollection = graphUtil::ValueCollection<adjacency_iterator, graphUtil::SortedTag>;
+		using VertexCollection = graphUtil::Collection<vertex_iterator>;
+
+		static vertex_descriptor null_vertex() {
+			return std::numeric_limits<vertex_descriptor>::max();
+		};
+
+		// The peak memory is the source graph plus the compressed graph
+		explicit CompressedStaticGraph(const SourceGraphType& graph)
+			: edgePropertyMap(new EdgePropertyMapType(&edgeProperties)),
+			  vertexPropertyMap(new VertexPropertyMapType(&vertexProperties)),
+			  vertexCollection(vertex_iterator(0), vertex_iterator(num_vertices(graph))),
+			  permutation(graph.Permutation()) {
+			Compress(graph);
+		}
+
+		// The same graph as the copy of builder.Build() without the StaticGraph: the edges of the builder
+		// are sorted in place and released, the peak memory is the edges, the compressed graph and 4 bytes per edge
+		explicit CompressedStaticGraph(Builder&& builder)
+			: edgePropertyMap(new EdgePropertyMapType(&edgeProperties)),
+			  vertexPropertyMap(new VertexPropertyMapType(&vertexProperties)),
+			  vertexCollection(vertex_iterator(0), vertex_iterator(builder.vertexCount)),
+			  permutation(builder.internalIds) {
+			Compress(builder.unsortedEdges, builder.vertexCount);
+			std::vector<typename Builder::Edge>().swap(builder.unsortedEdges);
+		}
+
+		template <class PairIterator>
+		CompressedStaticGraph(PairIterator begin, PairIterator end,
+							  vertices_size_type n, edges_size_type m = 0)
+			: CompressedStaticGraph(CollectEdges(begin, end, n, m)) {}
+
+		CompressedStaticGraph(std::vector<std::pair<size_t, size_t>>::iterator begin,
+							  std::vector<std::pair<size_t, size_t>>::iterator end,
+							  size_t n, size_t m = 0)
+			: CompressedStaticGraph(CollectEdges(begin, end, n, m)) {}
+
+		const VertexCollection& Vertices() const {
+			return vertexCollection;
+		}
+
+		AdjacencyCollection OutAdjacencies(const vertex_descriptor& v) const {
+			return AdjacencyCollection(
+				adjacency_iterator(v, this->outBlocks.data() + this->outBlockOffsets[v],
+								   this->outOffsets[v], this->outOffsets[v + 1], false),
+				adjacency_iterator(v, nullptr, this->outOffsets[v + 1], this->outOffsets[v + 1], false));
+		}
+
+		AdjacencyCollection InAdjacencies(const vertex_descriptor& v) const {
+			return AdjacencyCollection(
+				adjacency_iterator(v, this->inBlocks.data() + this->inBlockOffsets[v],
+								   this->inOffsets[v], this->inOffsets[v + 1], true),
+				adjacency_iterator(v, nullptr, this->inOffsets[v + 1], this->inOffsets[v + 1], true));
+		}
+
+		OutEdgeCollection OutEdges(const vertex_descriptor& v) const {
+			return OutEdgeCollection(
+				out_edge_iterator(v, this->outBlocks.data() + this->outBlockOffsets[v],
+								  this->outOffsets[v], this->outOffsets[v + 1]),
+				out_edge_iterator(v, nullptr, this->outOffsets[v + 1], this->outOffsets[v + 1]));
+		}
+
+		InEdgeCollection InEdges(const vertex_descriptor& v) const {
+			return InEdgeCollection(
+				in_edge_iterator(v, this->inBlocks.data() + this->inBlockOffsets[v],
+								 this->inOffsets[v], this->inOffsets[v + 1]),
+				in_edge_iterator(v, nullptr, this->inOffsets[v + 1], this->inOffsets[v + 1]));
+		}
+
+		degree_size_type OutDegree(const vertex_descriptor& v) const {
+			return this->outOffsets[v + 1] - this->outOffsets[v];
+		}
+
+		degree_size_type InDegree(const vertex_descriptor& v) const {
+			return this->inOffsets[v + 1] - this->inOffsets[v];
+		}
+
+		edges_size_type EdgesCount() const {
+			return edgeProperties.Size();
+		}
+
+		const EdgePropertyMapType& GetEdgePropertyMap() const {
+			return *edgePropertyMap;
+		}
+
+		const VertexPropertyMapType& GetVertexPropertyMap() const {
+			return *vertexPropertyMap;
+		}
+
+		const VertexPermutation& Permutation() const {
+			return permutation;
+		}
+
+		// Bytes taken by the links and the offsets, the properties excluded
+		size_t AdjacencyBytes() const {
+			return outBlocks.size() + inBlocks.size() + sizeof(edges_size_type) *
+				(outOffsets.size() + inOffsets.size() + outBlockOffsets.size() + inBlockOffsets.size());
+		}
+
+	private:
+		template <class PairIterator>
+		static Builder CollectEdges(PairIterator begin, PairIterator end, size_t n, size_t m) {
+			Builder builder(n, m);
+			for (auto it = begin; it != end; ++it) {
+				EdgeProperties edgeProperties;
+				edgeProperties = it->second;
+				builder.AddEdge((it->first).first, (it->first).second, edgeProperties);
+			}
+			return builder;
+		}
+
+		static Builder CollectEdges(std::vector<std::pair<size_t, size_t>>::iterator begin,
+									std::vector<std::pair<size_t, size_t>>::iterator end, size_t n, size_t m) {
+			Builder builder(n, m);
+			for (auto it = begin; it != end; ++it) {
+				builder.AddEdge(it->first, it->second);
+			}
+			return builder;
+		}
+
+		void Compress(const SourceGraphType& graph) {
+			const auto n = num_vertices(graph);
+			const auto m = num_edges(graph);
+			vertexProperties.Resize(n);
+			edgeProperties.Resize(m);
+			outOffsets.resize(n + 1);
+			inOffsets.resize(n + 1);
+			outBlockOffsets.resize(n + 1);
+			inBlockOffsets.resize(n + 1);
+
+			const auto& sourceVertexProperties = graph.GetVertexPropertyMap();
+			const auto& sourceEdgeProperties = graph.GetEdgePropertyMap();
+			std::vector<edges_size_type> newIds(m);
+			std::vector<uint8_t> blocks;
+			edges_size_type id = 0;
+			for (vertex_descriptor v = 0; v < n; ++v) {
+				vertexProperties.Set(v, get(sourceVertexProperties, v));
+				outOffsets[v] = id;
+				outBlockOffsets[v] = CheckedOffset(blocks.size());
+				auto previous = v;
+				for (const auto& e : graphUtil::Range(out_edges(v, graph))) {
+					auto to = target(e, graph);
+					if (id == outOffsets[v])
+						detail::WriteVarint(blocks, detail::ZigZagEncode(static_cast<int32_t>(to - v)));
+					else
+						detail::WriteVarint(blocks, to - previous);
+					previous = to;
+					newIds[e.id] = id;
+					edgeProperties.Set(id++, get(sourceEdgeProperties, e));
+				}
+			}
+			outOffsets[n] = id;
+			outBlockOffsets[n] = CheckedOffset(blocks.size());
+			outBlocks.resize(blocks.size());
+			std::copy(blocks.begin(), blocks.end(), outBlocks.begin());
+
+			blocks.clear();
+			edges_size_type count = 0;
+			for (vertex_descriptor v = 0; v < n; ++v) {
+				inOffsets[v] = count;
+				inBlockOffsets[v] = CheckedOffset(blocks.size());
+				auto previous = v;
+				edges_size_type previousId = 0;
+				for (const auto& e : graphUtil::Range(in_edges(v, graph))) {
+					auto from = source(e, graph);
+					if (count == inOffsets[v])
+						detail::WriteVarint(blocks, detail::ZigZagEncode(static_cast<int32_t>(from - v)));
+					else
+						detail::WriteVarint(blocks, from - previous);
+					previous = from;
+					detail::WriteVarint(blocks, detail::ZigZagEncode(static_cast<int32_t>(newIds[e.id] - previousId)));
+					previousId = newIds[e.id];
+					++count;
+				}
+			}
+			inOffsets[n] = count;
+			inBlockOffsets[n] = CheckedOffset(blocks.size());
+			inBlocks.resize(blocks.size());
+			std::copy(blocks.begin(), blocks.end(), inBlocks.begin());
+		}
+
+		// The edges sorted by the source and then the target, stable as the links of StaticGraph, are the out links
+		// in the edge id order. The in links are the edge ids placed by the target in the same pass, so the in
+		// links of a vertex come sorted by the source.
+		template <typename Edge>
+		void Compress(std::vector<Edge>& edges, vertices_size_type n) {
+			std::stable_sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) {
+				return a.source != b.source ? a.source < b.source : a.target < b.target;
+			});
+			const auto m = static_cast<edges_size_type>(edges.size());
+			vertexProperties.Resize(n);
+			edgeProperties.Resize(m);
+			outOffsets.resize(n + 1);
+			inOffsets.resize(n + 1);
+			outBlockOffsets.resize(n + 1);
+			inBlockOffsets.resize(n + 1);
+
+			std::vector<uint8_t> blocks;
+			edges_size_type id = 0;
+			for (vertex_descriptor v = 0; v < n; ++v) {
+				outOffsets[v] = id;
+				outBlockOffsets[v] = CheckedOffset(blocks.size());
+				auto previous = v;
+				for (; id < m && edges[id].source == v; ++id) {
+					auto to = edges[id].target;
+					if (id == outOffsets[v])
+						detail::WriteVarint(blocks, detail::ZigZagEncode(static_cast<int32_t>(to - v)));
+					else
+						detail::WriteVarint(blocks, to - previous);
+					previous = to;
+					edgeProperties.Set(id, edges[id].properties);
+				}
+			}
+			outOffsets[n] = id;
+			outBlockOffsets[n] = CheckedOffset(blocks.size());
+			outBlocks.resize(blocks.size());
+			std::copy(blocks.begin(), blocks.end(), outBlocks.begin());
+
+			// inOffsets[v] is the cursor of v while the ids are placed and ends up at the offset of v + 1
+			std::fill(inOffsets.begin(), inOffsets.end(), 0);
+			for (const auto& edge : edges)
+				++inOffsets[edge.target + 1];
+			std::partial_sum(inOffsets.begin(), inOffsets.end(), inOffsets.begin());
+			std::vector<edges_size_type> inIds(m);
+			for (edges_size_type edgeId = 0; edgeId < m; ++edgeId)
+				inIds[inOffsets[edges[edgeId].target]++] = edgeId;
+			for (auto v = n; v > 0; --v)
+				inOffsets[v] = inOffsets[v - 1];
+			inOffsets[0] = 0;
+
+			blocks.clear();
+			for (vertex_descriptor v = 0; v < n; ++v) {
+				inBlockOffsets[v] = CheckedOffset(blocks.size());
+				auto previous = v;
+				edges_size_type previousId = 0;
+				for (auto i = inOffsets[v]; i < inOffsets[v + 1]; ++i) {
+					auto from = edges[inIds[i]].source;
+					if (i == inOffsets[v])
+						detail::WriteVarint(blocks, detail::ZigZagEncode(static_cast<int32_t>(from - v)));
+					else
+						detail::WriteVarint(blocks, from - previous);
+					previous = from;
+					detail::WriteVarint(blocks, detail::ZigZagEncode(static_cast<int32_t>(inIds[i] - previousId)));
+					previousId = inIds[i];
+				}
+			}
+			inBlockOffsets[n] = CheckedOffset(blocks.size());
+			inBlocks.resize(blocks.size());
+			std::copy(blocks.begin(), blocks.end(), inBlocks.begin());
+		}
+
+		static edges_size_type CheckedOffset(size_t offset) {
+			if (offset > std::numeric_limits<edges_size_type>::max())
+				throw std::length_error("Compressed adjacencies exceed 4 GB");
+			return static_cast<edges_size_type>(offset);
+		}
+
+		OffsetsVecType outOffsets;
+		OffsetsVecType inOffsets;
+		OffsetsVecType outBlockOffsets;
+		OffsetsVecType inBlockOffsets;
+		BlocksVecType outBlocks;
+		BlocksVecType inBlocks;
+		VertexPropertiesStorageType vertexProperties;
+		EdgePropertiesStorageType edgeProperties;
+		std::unique_ptr<EdgePropertyMapType> edgePropertyMap;
+		std::unique_ptr<VertexPropertyMapType> vertexPropertyMap;
+		VertexCollection vertexCollection;
+		VertexPermutation permutation;
+	};
+}
+
+// PropertyMaps
+namespace graph {
+#define CompressedGraphTemplate template <typename VertexProperties, typename EdgeProperties, typename Layout>
+#define CompressedGraphType CompressedStaticGraph<VertexProperties, EdgeProperties, Layout>
+
+	CompressedGraphTemplate
+	struct property_map<CompressedGraphType, vertex_bundle_t> {
+		using type = typename CompressedGraphType::VertexPropertyMapType;
+	};
+
+	CompressedGraphTemplate
+	struct property_map<CompressedGraphType, edge_bundle_t> {
+		using type = typename CompressedGraphType::EdgePropertyMapType;
+	};
+
+	CompressedGraphTemplate
+	inline typename property_map<CompressedGraphType, vertex_bundle_t>::type
+	get(const vertex_bundle_t&, CompressedGraphType& graph) {
+		return graph.GetVertexPropertyMap();
+	}
+
+	CompressedGraphTemplate
+	inline typename property_map<CompressedGraphType, edge_bundle_t>::type
+	get(const edge_bundle_t&, CompressedGraphType& graph) {
+		return graph.GetEdgePropertyMap();
+	}
+
+	CompressedGraphTemplate
+	struct VertexIndexPropertyMap<CompressedGraphType> {
+		using key_type = typename graph_traits<CompressedGraphType>::vertex_descriptor;
+		using value_type = typename graph_traits<CompressedGraphType>::vertices_size_type;
+		using reference = value_type&;
+		using category = boost::readable_property_map_tag;
+	};
+
+	CompressedGraphTemplate
+	struct property_map<CompressedGraphType, vertex_index_t> {
+		using type = VertexIndexPropertyMap<CompressedGraphType>;
+	};
+
+	CompressedGraphTemplate
+	typename VertexIndexPropertyMap<CompressedGraphType>::value_type
+	get(const VertexIndexPropertyMap<CompressedGraphType>&,
+		const typename VertexIndexPropertyMap<CompressedGraphType>::key_type& key) {
+		return key;
+	};
+
+	CompressedGraphTemplate
+	inline typename property_map<CompressedGraphType, vertex_index_t>::type
+	get(const vertex_index_t&, CompressedGraphType&) {
+		return VertexIndexPropertyMap<CompressedGraphType>();
+	};
+}
+
+// External functions
+namespace graph {
+	CompressedGraphTemplate
+	inline std::pair<typename CompressedGraphType::vertex_iterator, typename CompressedGraphType::vertex_iterator>
+	vertices(const CompressedGraphType& g) {
+		return std::make_pair(g.Vertices().begin(), g.Vertices().end());
+	}
+
+	CompressedGraphTemplate
+	inline std::pair<typename CompressedGraphType::adjacency_iterator, typename CompressedGraphType::adjacency_iterator>
+	adjacent_vertices(typename CompressedGraphType::vertex_descriptor u, const CompressedGraphType& g) {
+		auto edgesCollection = g.OutAdjacencies(u);
+		return std::make_pair(edgesCollection.begin(), edgesCollection.end());
+	}
+
+	CompressedGraphTemplate
+	inline std::pair<typename CompressedGraphType::adjacency_iterator, typename CompressedGraphType::adjacency_iterator>
+	in_adjacent_vertices(typename CompressedGraphType::vertex_descriptor u, const CompressedGraphType& g) {
+		auto edgesCollection = g.InAdjacencies(u);
+		return std::make_pair(edgesCollection.begin(), edgesCollection.end());
+	}
+
+	CompressedGraphTemplate
+	inline typename CompressedGraphType::vertex_descriptor source(
+		typename CompressedGraphType::edge_descriptor e, const CompressedGraphType&) {
+		return e.source;
+	}
+
+	CompressedGraphTemplate
+	inline typename CompressedGraphType::vertex_descriptor target(
+		typename CompressedGraphType::edge_descriptor e, const CompressedGraphType&) {
+		return e.target;
+	}
+
+	CompressedGraphTemplate
+	inline typename CompressedGraphType::degree_size_type out_degree(
+		typename CompressedGraphType::vertex_descriptor u, const CompressedGraphType& g) {
+		return g.OutDegree(u);
+	}
+
+	CompressedGraphTemplate
+	inline std::pair<typename CompressedGraphType::out_edge_iterator, typename CompressedGraphType::out_edge_iterator>
+	out_edges(typename CompressedGraphType::vertex_descriptor u, const CompressedGraphType& g) {
+		auto edgesCollection = g.OutEdges(u);
+		return std::make_pair(edgesCollection.begin(), edgesCollection.end());
+	}
+
+	CompressedGraphTemplate
+	inline typename CompressedGraphType::vertices_size_type num_vertices(const CompressedGraphType& g) {
+		return g.Vertices().size();
+	}
+
+	CompressedGraphTemplate
+	inline typename CompressedGraphType::edges_size_type num_edges(const CompressedGraphType& g) {
+		return g.EdgesCount();
+	}
+
+	CompressedGraphTemplate
+	inline std::pair<typename CompressedGraphType::in_edge_iterator, typename CompressedGraphType::in_edge_iterator>
+	in_edges(typename CompressedGraphType::vertex_descriptor v, const CompressedGraphType& g) {
+		auto edgesCollection = g.InEdges(v);
+		return std::make_pair(edgesCollection.begin(), edgesCollection.end());
+	}
+
+	CompressedGraphTemplate
+	inline typename CompressedGraphType::degree_size_type in_degree(
+		typename CompressedGraphType::vertex_descriptor v, const CompressedGraphType& g) {
+		return g.InDegree(v);
+	}
+
+	CompressedGraphTemplate
+	inline typename CompressedGraphType::degree_size_type degree(
+		typename CompressedGraphType::vertex_descriptor v, const CompressedGraphType& g) {
+		return in_degree(v, g) + out_degree(v, g);
+	}
+
+	CompressedGraphTemplate
+	inline std::pair<typename CompressedGraphType::edge_descriptor, bool> edge(
+		typename CompressedGraphType::vertex_descriptor u,
+		typename CompressedGraphType::vertex_descriptor v,
+		const CompressedGraphType& graph) {
+		using EdgeDescriptor = typename CompressedGraphType::edge_descriptor;
+		for (const auto& edge : graphUtil::Range(out_edges(u, graph))) {
+			if (target(edge, graph) == v) return std::make_pair(edge, true);
+		}
+		return std::make_pair(EdgeDescriptor(), false);
+	}
+
+#undef CompressedGraphType
+#undef CompressedGraphTemplate
+}
@@ -0,0 +1,254 @@
+#pragma once
+#include <graph/dijkstra.hpp>
+#include <graph/detail/util/ThreadPool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace graph
+{
+	// Parallel one-to-all shortest paths by delta-stepping (Meyer, Sanders). The vertices wait in buckets
+	// of width delta; the vertices of the smallest bucket are settled together by the workers of the pool,
+	// the light edges (weight <= delta) are relaxed in phases until the bucket stays empty, the heavy
+	// edges once per settled vertex. The distance and the predecessor of a vertex are one atomic word,
+	// so a relaxation is a single compare-and-swap min.
+	// The edges are copied into light and heavy arrays when the engine is made, later weight changes
+	// need a new engine. One engine runs one search at a time, the graph is only read.
+	template <typename Graph, typename WeightMap, typename IndexMap>
+	class DeltaStepping {
+	public:
+		using Vertex = typename graph_traits<Graph>::vertex_descriptor;
+		using Distance = uint32_t;
+
+		// delta 0 takes the mean edge weight
+		DeltaStepping(const Graph& graph, const WeightMap& weight, const IndexMap& index,
+		              Distance delta = 0, size_t threadsCount = graphUtil::DefaultThreadsCount())
+			: graph(graph),
+			  index(index),
+			  pool(threadsCount),
+			  delta(delta),
+			  state(num_vertices(graph)),
+			  buckets(pool.Size()),
+			  settled(pool.Size()) {
+			SplitEdges(weight);
+			bucketsCount = maxWeight / this->delta + 2;
+			for (auto& local : buckets) {
+				local.resize(bucketsCount);
+			}
+		}
+
+		DeltaStepping(const DeltaStepping&) = delete;
+		DeltaStepping& operator=(const DeltaStepping&) = delete;
+
+		size_t ThreadsCount() const {
+			return pool.Size();
+		}
+
+		Distance Delta() const {
+			return delta;
+		}
+
+		// Writes the distance and the predecessor of every vertex, like dijkstra followed by
+		// EnsureVertexInitialization: the unreached vertices get InfinityDistance and are their own predecessor
+		template <typename PredecessorMap, typename DistanceMap>
+		void Run(const Vertex& s, PredecessorMap& predecessor, DistanceMap& distance) {
+			Run(s);
+			auto verticesCount = num_vertices(graph);
+			pool.Run([&](size_t worker) {
+				auto begin = verticesCount * worker / pool.Size();
+				auto end = verticesCount * (worker + 1) / pool.Size();
+				for (auto v = Vertex(begin); v < Vertex(end); ++v) {
+					auto word = state[get(index, v)].load(std::memory_order_relaxed);
+					put(distance, v, DistanceOf(word));
+					put(predecessor, v, DistanceOf(word) == Infinity ? v : PredecessorOf(word));
+				}
+			});
+		}
+
+	private:
+		using Word = uint64_t;
+		static constexpr Distance Infinity = std::numeric_limits<Distance>::max();
+		// the frontier is handed out to the workers in blocks of this many entries
+		static constexpr size_t BlockSize = 256;
+
+		struct Arc {
+			Vertex To;
+			Distance Weight;
+		};
+
+		// a vertex is entered with the distance it got, an entry is stale once the distance dropped again
+		struct Entry {
+			Vertex V;
+			Distance D;
+		};
+
+		static Word Pack(Distance d, Vertex predecessor) {
+			return (Word(d) << 32) | Word(predecessor);
+		}
+
+		static Distance DistanceOf(Word word) {
+			return static_cast<Distance>(word >> 32);
+		}
+
+		static Vertex PredecessorOf(Word word) {
+			return static_cast<Vertex>(word & 0xFFFFFFFFu);
+		}
+
+		void SplitEdges(const WeightMap& weight) {
+			auto verticesCount = num_vertices(graph);
+			lightOffsets.assign(1, 0);
+			heavyOffsets.assign(1, 0);
+			lightOffsets.reserve(verticesCount + 1);
+			heavyOffsets.reserve(verticesCount + 1);
+			uint64_t weightSum = 0, edgesCount = 0;
+			maxWeight = 0;
+			for (const auto& v : graphUtil::Range(vertices(graph))) {
+				for (const auto& edge : graphUtil::Range(out_edges(v, graph))) {
+					weightSum += get(weight, edge);
+					++edgesCount;
+				}
+			}
+			if (delta == 0)
+				delta = static_cast<Distance>(std::max<uint64_t>(1, edgesCount == 0 ? 1 : weightSum / edgesCount));
+			for (const auto& v : graphUtil::Range(vertices(graph))) {
+				for (const auto& edge : graphUtil::Range(out_edges(v, graph))) {
+					Arc arc{target(edge, graph), get(weight, edge)};
+					maxWeight = std::max(maxWeight, arc.Weight);
+					if (arc.Weight <= delta)
+						lightEdges.push_back(arc);
+					else
+						heavyEdges.push_back(arc);
+				}
+				lightOffsets.push_back(static_cast<uint32_t>(lightEdges.size()));
+				heavyOffsets.push_back(static_cast<uint32_t>(heavyEdges.size()));
+			}
+		}
+
+		void Run(const Vertex& s) {
+			auto verticesCount = num_vertices(graph);
+			pool.Run([&](size_t worker) {
+				auto begin = verticesCount * worker / pool.Size();
+				auto end = verticesCount * (worker + 1) / pool.Size();
+				for (auto i = begin; i < end; ++i) {
+					state[i].store(Pack(Infinity, 0), std::memory_order_relaxed);
+				}
+			});
+			for (auto& local : buckets) {
+				for (auto& bucket : local) {
+					bucket.clear();
+				}
+			}
+
+			state[get(index, s)].store(Pack(0, s), std::memory_order_relaxed);
+			buckets[0][0].push_back(Entry{s, 0});
+			size_t current = 0;
+			while (NextBucket(current)) {
+				auto slot = current % bucketsCount;
+				for (auto& local : settled) {
+					local.clear();
+				}
+				// light phases, relaxing a light edge may put the vertex back into the current bucket
+				while (GatherFrontier(slot)) {
+					ProcessFrontier([&](size_t worker, const Entry& entry) {
+						settled[worker].push_back(entry);
+						Relax(worker, entry, lightEdges, lightOffsets);
+					});
+				}
+				// heavy edges never end in the current bucket, the distances of the settled vertices are final
+				frontier.clear();
+				for (auto& local : settled) {
+					frontier.insert(frontier.end(), local.begin(), local.end());
+				}
+				ProcessFrontier([&](size_t worker, const Entry& entry) {
+					Relax(worker, entry, heavyEdges, heavyOffsets);
+				});
+				++current;
+			}
+		}
+
+		// the first non empty bucket from current on, the buckets are a ring of bucketsCount slots
+		// and every reached distance is less than bucketsCount buckets ahead
+		bool NextBucket(size_t& current) {
+			for (size_t step = 0; step < bucketsCount; ++step, ++current) {
+				auto slot = current % bucketsCount;
+				for (const auto& local : buckets) {
+					if (!local[slot].empty())
+						return true;
+				}
+			}
+			return false;
+		}
+
+		bool GatherFrontier(size_t slot) {
+			frontier.clear();
+			for (auto& local : buckets) {
+				frontier.insert(frontier.end(), local[slot].begin(), local[slot].end());
+				local[slot].clear();
+			}
+			return !frontier.empty();
+		}
+
+		template <typename Function>
+		void ProcessFrontier(Function&& function) {
+			std::atomic<size_t> nextBlock(0);
+			pool.Run([&](size_t worker) {
+				for (size_t block = nextBlock++ * BlockSize; block < frontier.size(); block = nextBlock++ * BlockSize) {
+					auto blockEnd = std::min(frontier.size(), block + BlockSize);
+					for (auto i = block; i < blockEnd; ++i) {
+						const auto& entry = frontier[i];
+						if (DistanceOf(state[get(index, entry.V)].load(std::memory_order_relaxed)) != entry.D)
+							continue;
+						function(worker, entry);
+					}
+				}
+			});
+		}
+
+		void Relax(size_t worker, const Entry& entry, const std::vector<Arc>& arcs, const std::vector<uint32_t>& offsets) {
+			auto vIndex = get(index, entry.V);
+			for (auto i = offsets[vIndex]; i < offsets[vIndex + 1]; ++i) {
+				const auto& arc = arcs[i];
+				auto newDistance = entry.D + arc.Weight;
+				auto& toState = state[get(index, arc.To)];
+				auto word = toState.load(std::memory_order_relaxed);
+				auto newWord = Pack(newDistance, entry.V);
+				bool improved = false;
+				while (newDistance < DistanceOf(word)) {
+					if (toState.compare_exchange_weak(word, newWord, std::memory_order_relaxed)) {
+						improved = true;
+						break;
+					}
+				}
+				if (improved)
+					buckets[worker][(newDistance / delta) % bucketsCount].push_back(Entry{arc.To, newDistance});
+			}
+		}
+
+		const Graph& graph;
+		IndexMap index;
+		graphUtil::ThreadPool pool;
+		Distance delta;
+		Distance maxWeight;
+		size_t bucketsCount;
+		std::vector<uint32_t> lightOffsets;
+		std::vector<Arc> lightEdges;
+		std::vector<uint32_t> heavyOffsets;
+		std::vector<Arc> heavyEdges;
+		std::vector<std::atomic<Word>> state;
+		// buckets[worker][slot] are the entries the worker put into the bucket, together they are the bucket
+		std::vector<std::vector<std::vector<Entry>>> buckets;
+		std::vector<std::vector<Entry>> settled;
+		std::vector<Entry> frontier;
+	};
+
+	template <class Graph, class PredecessorMap, class DistanceMap, class WeightMap, class IndexMap>
+	void delta_stepping(const Graph& graph,
+	                    const typename graph_traits<Graph>::vertex_descriptor& s,
+	                    PredecessorMap& predecessor, DistanceMap& distance, WeightMap& weight,
+	                    IndexMap& index, uint32_t delta = 0,
+	                    size_t threadsCount = graphUtil::DefaultThreadsCount()) {
+		DeltaStepping<Graph, WeightMap, IndexMap> engine(graph, weight, index, delta, threadsCount);
+		engine.Run(s, predecessor, distance);
+	}
+}
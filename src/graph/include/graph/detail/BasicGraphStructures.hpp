@@ -1,17 +1,8 @@
 #pragma once
+#include <limits>
+#include <type_traits>
 
 namespace graph {
-	template <typename Iterator, typename VertexProperties>
-	class Vertex { // inner struture
-	public:
-		using IteratorType = Iterator;
-
-		Iterator begin;
-		VertexProperties properties;
-
-		Vertex(const Iterator& it) : begin(it) {}
-	};
-
 	template <typename Vertex>
 	class Edge {
 	public:
@@ -39,24 +30,24 @@ namespace graph {
 			: Edge<Vertex>(source, target), properties(properties) {}
 	};
 
-	template <typename Vertex, typename EdgeProperties>
+	template <typename Vertex, typename EdgeId>
 	class FancyEdgeDescriptor : public Edge<Vertex> { // inner struture
 	public:
-		using EdgePropertiesType = EdgeProperties;
+		using EdgeIdType = EdgeId;
 
-		EdgePropertiesType* properties;
+		EdgeIdType id;
 
-		FancyEdgeDescriptor() : properties(nullptr) {}
+		FancyEdgeDescriptor() : id(std::numeric_limits<EdgeId>::max()) {}
 
-		FancyEdgeDescriptor(const Vertex& source, const Vertex& target, EdgeProperties* properties)
-			: Edge<Vertex>(source, target), properties(properties) {}
+		FancyEdgeDescriptor(const Vertex& source, const Vertex& target, const EdgeId& id)
+			: Edge<Vertex>(source, target), id(id) {}
 
 		friend bool operator==(const FancyEdgeDescriptor& lhs, const FancyEdgeDescriptor& rhs) {
-			return lhs.properties == rhs.properties;
+			return lhs.id == rhs.id;
 		}
 
 		friend bool operator!=(const FancyEdgeDescriptor& lhs, const FancyEdgeDescriptor& rhs) {
-			return lhs.properties != rhs.properties;
+			return lhs.id != rhs.id;
 		}
 	};
 
@@ -73,21 +64,36 @@ namespace graph {
 			: target(target) {}
 	};
 
-	template <typename Vertex, typename EdgeProperties>
+	// Stores the index of the edge in the edge properties storage instead of a pointer to them,
+	// so a link takes 8 bytes
+	template <typename Vertex, typename EdgeId>
 	class FancyLink : public Link<Vertex> {
 	public:
-		using EdgePropertiesType = EdgeProperties;
+		using EdgeIdType = EdgeId;
 
-		EdgePropertiesType* properties;
+		EdgeIdType id;
 
-		FancyLink() : properties(nullptr) {}
+		FancyLink() : id(std::numeric_limits<EdgeId>::max()) {}
 
 
 		explicit FancyLink(const Vertex& target)
-			: Link<Vertex>(target), properties(nullptr) {}
+			: Link<Vertex>(target), id(std::numeric_limits<EdgeId>::max()) {}
 
 
-		FancyLink(const Vertex& target, EdgeProperties* properties)
-			:Link<Vertex>(target), properties(properties) {}
+		FancyLink(const Vertex& target, const EdgeId& id)
+			:Link<Vertex>(target), id(id) {}
 	};
+
+	namespace detail {
+		// Position of the element in the property storage of a static graph
+		template <typename Vertex, typename EdgeId>
+		inline EdgeId ElementIndex(const FancyEdgeDescriptor<Vertex, EdgeId>& edge) {
+			return edge.id;
+		}
+
+		template <typename Vertex>
+		inline std::enable_if_t<std::is_integral<Vertex>::value, Vertex> ElementIndex(const Vertex& vertex) {
+			return vertex;
+		}
+	}
 }
@@ -0,0 +1,154 @@
+#pragma once
+#include <cinttypes>
+#include <vector>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/iterator/iterator_adaptor.hpp>
+#include "graph/detail/StaticGraphIterators.hpp"
+
+namespace graph {
+	namespace detail {
+		// LEB128: 7 bits per byte, the high bit marks that more bytes follow
+		inline void WriteVarint(std::vector<uint8_t>& output, uint32_t value) {
+			while (value >= 0x80) {
+				output.push_back(static_cast<uint8_t>(value | 0x80));
+				value >>= 7;
+			}
+			output.push_back(static_cast<uint8_t>(value));
+		}
+
+		inline uint32_t ReadVarint(const uint8_t*& input) {
+			uint32_t value = *input & 0x7f;
+			for (uint32_t shift = 7; *input++ & 0x80; shift += 7) {
+				value |= static_cast<uint32_t>(*input & 0x7f) << shift;
+			}
+			return value;
+		}
+
+		// Signed differences are stored zigzag encoded, so small negative values take one byte too
+		inline uint32_t ZigZagEncode(int32_t value) {
+			return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+		}
+
+		inline int32_t ZigZagDecode(uint32_t value) {
+			return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+		}
+	}
+
+	// Decodes the links of one vertex block of a CompressedStaticGraph on the fly.
+	// Out links store the gaps of the sorted targets (the first one relative to the vertex itself),
+	// their edge id is the position of the link in the out links order.
+	// In links store the gaps of the sorted sources followed by the difference to the previous edge id.
+	template <typename EdgeDescriptor, internals::EdgeDirection Direction>
+	class CompressedEdgeIterator
+			: public boost::iterator_facade<
+				CompressedEdgeIterator<EdgeDescriptor, Direction>,
+				EdgeDescriptor,
+				boost::forward_traversal_tag,
+				EdgeDescriptor> {
+		using VertexType = typename EdgeDescriptor::VertexType;
+		using EdgeIdType = typename EdgeDescriptor::EdgeIdType;
+	public:
+		CompressedEdgeIterator() : block(nullptr), vertex(), neighbour(), id(), index(), last() {}
+
+		// Iterates over the links [first, last) of the vertex, block points to the encoded link first
+		CompressedEdgeIterator(const VertexType& vertex, const uint8_t* block, EdgeIdType first, EdgeIdType last)
+			: block(block), vertex(vertex), neighbour(vertex), id(0), index(first), last(last) {
+			if (index < last) {
+				neighbour = vertex + detail::ZigZagDecode(detail::ReadVarint(this->block));
+				DecodeId();
+			}
+		}
+
+	private:
+		friend class boost::iterator_core_access;
+
+		EdgeDescriptor dereference() const {
+			return dereference_impl<Direction>();
+		}
+
+		template <internals::EdgeDirection EdgeDirection>
+		inline std::enable_if_t<EdgeDirection == internals::EdgeDirection::In, EdgeDescriptor> dereference_impl() const {
+			return EdgeDescriptor(neighbour, vertex, id);
+		}
+
+		template <internals::EdgeDirection EdgeDirection>
+		inline std::enable_if_t<EdgeDirection == internals::EdgeDirection::Out, EdgeDescriptor> dereference_impl() const {
+			return EdgeDescriptor(vertex, neighbour, id);
+		}
+
+		void increment() {
+			if (++index < last) {
+				neighbour += detail::ReadVarint(block);
+				DecodeId();
+			}
+		}
+
+		bool equal(const CompressedEdgeIterator& other) const {
+			return index == other.index;
+		}
+
+		inline void DecodeId() {
+			if (Direction == internals::EdgeDirection::Out) {
+				id = index;
+			} else {
+				id += detail::ZigZagDecode(detail::ReadVarint(block));
+			}
+		}
+
+		const uint8_t* block;
+		VertexType vertex;
+		VertexType neighbour;
+		EdgeIdType id;
+		EdgeIdType index;
+		EdgeIdType last;
+	};
+
+	// Decodes the neighbours of one vertex block, the same type serves the out and the in links
+	// (hasIds tells whether the links carry an edge id to skip), so ComplementGraph can swap them
+	template <typename VertexDescriptor, typename EdgeId>
+	class CompressedAdjacencyIterator
+			: public boost::iterator_facade<
+				CompressedAdjacencyIterator<VertexDescriptor, EdgeId>,
+				const VertexDescriptor,
+				boost::forward_traversal_tag> {
+	public:
+		CompressedAdjacencyIterator() : block(nullptr), neighbour(), index(), last(), hasIds(false) {}
+
+		CompressedAdjacencyIterator(const VertexDescriptor& vertex, const uint8_t* block,
+									EdgeId first, EdgeId last, bool hasIds)
+			: block(block), neighbour(vertex), index(first), last(last), hasIds(hasIds) {
+			if (index < last) {
+				neighbour = vertex + detail::ZigZagDecode(detail::ReadVarint(this->block));
+				SkipId();
+			}
+		}
+
+	private:
+		friend class boost::iterator_core_access;
+
+		const VertexDescriptor& dereference() const {
+			return neighbour;
+		}
+
+		void increment() {
+			if (++index < last) {
+				neighbour += detail::ReadVarint(block);
+				SkipId();
+			}
+		}
+
+		bool equal(const CompressedAdjacencyIterator& other) const {
+			return index == other.index;
+		}
+
+		inline void SkipId() {
+			if (hasIds) detail::ReadVarint(block);
+		}
+
+		const uint8_t* block;
+		VertexDescriptor neighbour;
+		EdgeId index;
+		EdgeId last;
+		bool hasIds;
+	};
+}
@@ -1,10 +1,20 @@
 #pragma once
 #include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include "graph/detail/util/Parallel.hpp"
 
 namespace graph {
+	template <typename VertexProperties, typename EdgeProperties, typename Layout>
+	class CompressedStaticGraph;
+
 	template <typename Graph>
 	class GraphBuilder {
 		friend Graph;
+		// encodes the edges without building Graph
+		template <typename, typename, typename>
+		friend class CompressedStaticGraph;
 		using vertices_size_type = typename Graph::vertices_size_type;
 		using edges_size_type = typename Graph::edges_size_type;
 		using vertex_descriptor = typename Graph::vertex_descriptor;
@@ -12,11 +22,13 @@ namespace graph {
 
 		using EdgePropertiesType = typename Graph::edge_bundled;
 		using EdgeType = FancyEdge<vertex_descriptor, EdgePropertiesType>;
-		using VertexType = typename Graph::VertexType;
 		using StoredAdjacencyType = typename Graph::StoredAdjacencyType;
 		using AdjacenciesVecType = typename Graph::AdjacenciesVecType;
+		using OffsetsVecType = typename Graph::OffsetsVecType;
 
 	public:
+		using Edge = EdgeType;
+
 		GraphBuilder(vertices_size_type vertexCount, edges_size_type edgesCount = 0) {
 			this->unsortedEdges.reserve(edgesCount);
 			this->vertexCount = vertexCount;
@@ -27,74 +39,225 @@ namespace graph {
 			unsortedEdges.push_back(EdgeType(from, to, properties));
 		}
 
+		// Appends the edges of the chunks in the chunks order, the chunks are copied on threadsCount threads
+		void AddEdges(const std::vector<std::vector<Edge>>& chunks,
+					  size_t threadsCount = graphUtil::DefaultThreadsCount()) {
+			std::vector<size_t> offsets(chunks.size() + 1, this->unsortedEdges.size());
+			for (size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+				offsets[chunk + 1] = offsets[chunk] + chunks[chunk].size();
+			}
+			this->unsortedEdges.resize(offsets.back());
+			graphUtil::ParallelFor(0, chunks.size(), threadsCount, [&](size_t, size_t begin, size_t end) {
+				for (auto chunk = begin; chunk < end; ++chunk) {
+					std::copy(chunks[chunk].begin(), chunks[chunk].end(), this->unsortedEdges.begin() + offsets[chunk]);
+				}
+			});
+		}
+
+		// Renumbers the vertices of the edges added so far to improve the memory locality of traversals.
+		// HilbertCurve needs the coordinates of every vertex. The built graph keeps the permutation
+		// to map the input vertex ids, see StaticGraph::Permutation().
+		void Reorder(VertexOrder order, const std::vector<VertexCoordinates>& coordinates = {}) {
+			std::vector<uint32_t> newIds;
+			switch (order) {
+			case VertexOrder::Input:
+				return;
+			case VertexOrder::BreadthFirst:
+				newIds = detail::TraversalOrder(this->vertexCount, this->unsortedEdges, false);
+				break;
+			case VertexOrder::DepthFirst:
+				newIds = detail::TraversalOrder(this->vertexCount, this->unsortedEdges, true);
+				break;
+			case VertexOrder::Degree:
+				newIds = detail::DegreeOrder(this->vertexCount, this->unsortedEdges);
+				break;
+			case VertexOrder::HilbertCurve:
+				if (coordinates.size() != static_cast<size_t>(this->vertexCount))
+					throw std::invalid_argument("Hilbert curve order needs the coordinates of every vertex");
+				newIds = detail::HilbertCurveOrder(coordinates);
+				break;
+			}
+
+			for (auto& edge : this->unsortedEdges) {
+				edge.source = newIds[edge.source];
+				edge.target = newIds[edge.target];
+			}
+			if (this->internalIds.empty()) {
+				this->internalIds = std::move(newIds);
+			} else {
+				for (auto& id : this->internalIds) {
+					id = newIds[id];
+				}
+			}
+		}
+
 		std::unique_ptr<Graph> Build() {
 			auto graph = std::make_unique<Graph>();
 			BuildGraph(*graph);
 			return graph;
 		}
 
+		// Builds the same graph as Build() using threadsCount threads
+		std::unique_ptr<Graph> BuildParallel(size_t threadsCount = graphUtil::DefaultThreadsCount()) {
+			auto graph = std::make_unique<Graph>();
+			SortEdgesAndCopyToParallel(*graph, threadsCount);
+			graph->permutation = VertexPermutation(this->internalIds);
+			graph->Initialize();
+			return graph;
+		}
+
 	private:
 		void BuildGraph(Graph& graph) {
 			SortEdgesAndCopyTo(graph);
+			graph.permutation = VertexPermutation(this->internalIds);
 			graph.Initialize();
 		}
 
 		void SortEdgesAndCopyTo(Graph& graph) {
+			const auto edgesCount = this->unsortedEdges.size();
 
-			graph.vertices.reserve(this->vertexCount);
-			graph.edgesSeparators.reserve(this->vertexCount);
-			graph.adjacencies.resize(2 * this->unsortedEdges.size());
-			graph.edgeProperties.reserve(this->unsortedEdges.size());
-
-			auto inDegreeCounts = std::vector<degree_size_type>(this->vertexCount, 0);
-			auto outDegreeCounts = std::vector<degree_size_type>(this->vertexCount, 0);
-			auto linkPointers = std::vector<typename AdjacenciesVecType::iterator>();
-			linkPointers.reserve(this->vertexCount + 1);
-
+			graph.vertexProperties.Resize(this->vertexCount);
+			graph.edgeProperties.Resize(edgesCount);
+			graph.outLinks.resize(edgesCount);
+			graph.outOffsets.assign(this->vertexCount + 1, 0);
 			for (auto& edge : this->unsortedEdges) {
-				++outDegreeCounts[edge.source];
-				++inDegreeCounts[edge.target];
+				++graph.outOffsets[edge.source + 1];
 			}
+			std::partial_sum(graph.outOffsets.begin(), graph.outOffsets.end(), graph.outOffsets.begin());
+			auto outCursors = std::vector<edges_size_type>(graph.outOffsets.begin(), graph.outOffsets.end() - 1);
 
-			linkPointers.push_back(graph.adjacencies.begin());
-			graph.vertices.push_back(VertexType(linkPointers[0]));
-			graph.edgesSeparators.push_back(inDegreeCounts[0]);
-			outDegreeCounts[0] += inDegreeCounts[0];
-			for (int i = 1; i < this->vertexCount; ++i) {
-				linkPointers.push_back(linkPointers[i - 1] + outDegreeCounts[i - 1]);
-				graph.vertices.push_back(VertexType(linkPointers[i]));
-				graph.edgesSeparators.push_back(inDegreeCounts[i]);
-				outDegreeCounts[i] += inDegreeCounts[i];
+			std::vector<edges_size_type> inCursors;
+			if (Graph::HasInLinks) {
+				graph.inLinks.resize(edgesCount);
+				graph.inOffsets.assign(this->vertexCount + 1, 0);
+				for (auto& edge : this->unsortedEdges) {
+					++graph.inOffsets[edge.target + 1];
+				}
+				std::partial_sum(graph.inOffsets.begin(), graph.inOffsets.end(), graph.inOffsets.begin());
+				inCursors.assign(graph.inOffsets.begin(), graph.inOffsets.end() - 1);
 			}
-			linkPointers.push_back(graph.adjacencies.end());
 
+			edges_size_type edgeId = 0;
 			for (auto& edge : this->unsortedEdges) {
 				auto from = edge.source;
 				auto to = edge.target;
-				graph.edgeProperties.push_back(edge.properties);
-				auto propertyPtr = &graph.edgeProperties.back();
-				--outDegreeCounts[from];
-				*(linkPointers[from] + outDegreeCounts[from]) = StoredAdjacencyType(to, propertyPtr);
-				--inDegreeCounts[to];
-				*(linkPointers[to] + inDegreeCounts[to]) = StoredAdjacencyType(from, propertyPtr);
+				graph.edgeProperties.Set(edgeId, edge.properties);
+				graph.outLinks[outCursors[from]++] = StoredAdjacencyType(to, edgeId);
+				if (Graph::HasInLinks) graph.inLinks[inCursors[to]++] = StoredAdjacencyType(from, edgeId);
+				++edgeId;
 			}
 
+			auto byTarget = [](const StoredAdjacencyType& a, const StoredAdjacencyType& b) {
+				return a.target < b.target;
+			};
 			for (int i = 0; i < this->vertexCount; ++i) {
-				auto start = linkPointers[i];
-				auto end = linkPointers[i + 1];
-				std::stable_sort(start, start + graph.edgesSeparators[i],
-						  [](const StoredAdjacencyType& a, const StoredAdjacencyType& b) {
-							  return a.target < b.target;
-						  });
-				std::stable_sort(start + graph.edgesSeparators[i], end,
-						  [](const StoredAdjacencyType& a, const StoredAdjacencyType& b) {
-							  return a.target < b.target;
-						  });
-				start = end;
+				std::stable_sort(graph.outLinks.begin() + graph.outOffsets[i],
+								 graph.outLinks.begin() + graph.outOffsets[i + 1], byTarget);
+				if (Graph::HasInLinks)
+					std::stable_sort(graph.inLinks.begin() + graph.inOffsets[i],
+									 graph.inLinks.begin() + graph.inOffsets[i + 1], byTarget);
+			}
+		}
+
+		// Counting sort of the edges in two passes whose extra memory does not grow with the vertices times
+		// the threads. The first pass groups the links by blocks of owner vertices: the edges are split between
+		// the threads in contiguous chunks and every chunk has a cursor per block after the links of the previous
+		// chunks. The second pass places the links of every block by the owner through a buffer of the block size.
+		// Both passes keep the input order, so the links come out as in the serial scatter
+		void SortEdgesAndCopyToParallel(Graph& graph, size_t threadsCount) {
+			const auto edgesCount = this->unsortedEdges.size();
+			threadsCount = std::max<size_t>(1, threadsCount);
+
+			graph.vertexProperties.Resize(this->vertexCount);
+			graph.edgeProperties.Resize(edgesCount);
+			graphUtil::ParallelFor(0, edgesCount, threadsCount, [&](size_t, size_t begin, size_t end) {
+				for (auto edgeId = begin; edgeId < end; ++edgeId) {
+					graph.edgeProperties.Set(edgeId, this->unsortedEdges[edgeId].properties);
+				}
+			});
+
+			PlaceLinksParallel(graph.outLinks, graph.outOffsets, threadsCount,
+							   [](const EdgeType& edge) { return edge.source; },
+							   [](const EdgeType& edge) { return edge.target; });
+			if (Graph::HasInLinks)
+				PlaceLinksParallel(graph.inLinks, graph.inOffsets, threadsCount,
+								   [](const EdgeType& edge) { return edge.target; },
+								   [](const EdgeType& edge) { return edge.source; });
+		}
+
+		template <typename GetOwner, typename GetTarget>
+		void PlaceLinksParallel(AdjacenciesVecType& links, OffsetsVecType& offsets, size_t threadsCount,
+								GetOwner getOwner, GetTarget getTarget) {
+			const size_t n = this->vertexCount;
+			const auto edgesCount = this->unsortedEdges.size();
+			links.resize(edgesCount);
+			offsets.assign(n + 1, 0);
+			// a few blocks per thread balance the second pass
+			const size_t blocksCount = std::max<size_t>(1, std::min(n, 4 * threadsCount));
+			auto blockOf = [&](size_t v) { return v * blocksCount / n; };
+			auto blockBegin = [&](size_t block) { return (block * n + blocksCount - 1) / blocksCount; };
+
+			// links count of every chunk and block, then the cursors of the chunks in every block
+			std::vector<edges_size_type> cursors(threadsCount * blocksCount, 0);
+			graphUtil::ParallelFor(0, edgesCount, threadsCount, [&](size_t chunk, size_t begin, size_t end) {
+				auto chunkCounts = cursors.data() + chunk * blocksCount;
+				for (auto edgeId = begin; edgeId < end; ++edgeId) {
+					++chunkCounts[blockOf(getOwner(this->unsortedEdges[edgeId]))];
+				}
+			});
+			std::vector<edges_size_type> blockOffsets(blocksCount + 1, 0);
+			for (size_t block = 0; block < blocksCount; ++block) {
+				auto position = blockOffsets[block];
+				for (size_t chunk = 0; chunk < threadsCount; ++chunk) {
+					auto count = cursors[chunk * blocksCount + block];
+					cursors[chunk * blocksCount + block] = position;
+					position += count;
+				}
+				blockOffsets[block + 1] = position;
 			}
+
+			graphUtil::ParallelFor(0, edgesCount, threadsCount, [&](size_t chunk, size_t begin, size_t end) {
+				auto chunkCursors = cursors.data() + chunk * blocksCount;
+				for (auto edgeId = begin; edgeId < end; ++edgeId) {
+					const auto& edge = this->unsortedEdges[edgeId];
+					links[chunkCursors[blockOf(getOwner(edge))]++] = StoredAdjacencyType(getTarget(edge), edgeId);
+				}
+			});
+
+			auto byTarget = [](const StoredAdjacencyType& a, const StoredAdjacencyType& b) {
+				return a.target < b.target;
+			};
+			graphUtil::ParallelFor(0, blocksCount, threadsCount, [&](size_t, size_t begin, size_t end) {
+				std::vector<StoredAdjacencyType> buffer;
+				std::vector<edges_size_type> vertexCursors;
+				for (auto block = begin; block < end; ++block) {
+					const auto first = blockBegin(block);
+					const auto blockOffset = blockOffsets[block];
+					buffer.assign(links.begin() + blockOffset, links.begin() + blockOffsets[block + 1]);
+					vertexCursors.assign(blockBegin(block + 1) - first + 1, 0);
+					for (const auto& link : buffer) {
+						++vertexCursors[getOwner(this->unsortedEdges[link.id]) - first + 1];
+					}
+					std::partial_sum(vertexCursors.begin(), vertexCursors.end(), vertexCursors.begin());
+					for (size_t i = 0; i + 1 < vertexCursors.size(); ++i) {
+						offsets[first + i] = blockOffset + vertexCursors[i];
+					}
+					for (const auto& link : buffer) {
+						links[blockOffset + vertexCursors[getOwner(this->unsortedEdges[link.id]) - first]++] = link;
+					}
+					// vertexCursors[i] is the end of the links of first + i now
+					for (size_t i = 0; i + 1 < vertexCursors.size(); ++i) {
+						std::stable_sort(links.begin() + offsets[first + i], links.begin() + blockOffset + vertexCursors[i],
+										 byTarget);
+					}
+				}
+			});
+			offsets[n] = static_cast<edges_size_type>(edgesCount);
 		}
 
 		std::vector<EdgeType> unsortedEdges;
+		// internalIds[v] is the graph id of the input vertex v, empty when the vertices are not reordered
+		std::vector<uint32_t> internalIds;
 		int vertexCount;
 	};
 }
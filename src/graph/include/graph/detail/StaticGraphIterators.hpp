@@ -58,12 +58,12 @@ namespace graph {
 
 		template <internals::EdgeDirection EdgeDirection>
 		inline std::enable_if_t<EdgeDirection == internals::EdgeDirection::In, EdgeDescriptor> dereference_impl() const {
-			return EdgeDescriptor(this->base_reference()->target, source, this->base_reference()->properties);
+			return EdgeDescriptor(this->base_reference()->target, source, this->base_reference()->id);
 		}
 
 		template <internals::EdgeDirection EdgeDirection>
 		inline std::enable_if_t<EdgeDirection == internals::EdgeDirection::Out, EdgeDescriptor> dereference_impl() const {
-			return EdgeDescriptor(source, this->base_reference()->target, this->base_reference()->properties);
+			return EdgeDescriptor(source, this->base_reference()->target, this->base_reference()->id);
 		}
 
 		VertexType source;
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "graph/graph.hpp"
+#include "graph/properties.hpp"
+#include "graph/detail/BasicGraphStructures.hpp"
+#include "graph/detail/StaticGraphPropertyStorage.hpp"
 #include <boost/property_map/property_map.hpp>
 
 // VertexPropertyMap
@@ -8,13 +11,14 @@ namespace graph {
 	template <typename VertexProperties, typename Graph>
 	class VertexPropertyMap {
 	private:
-		Graph* graph;
+		using StorageType = detail::PropertiesStorage<VertexProperties, RowLayoutTag>;
+		StorageType* storage;
 	public:
-		explicit VertexPropertyMap(Graph* graph)
-			: graph(graph) {}
+		explicit VertexPropertyMap(StorageType* storage)
+			: storage(storage) {}
 
 		VertexPropertyMap()
-			: graph(nullptr) {}
+			: storage(nullptr) {}
 
 		using key_type = typename graph_traits<Graph>::vertex_descriptor;
 		using value_type = VertexProperties;
@@ -22,11 +26,11 @@ namespace graph {
 		using category = boost::read_write_property_map_tag;
 
 		reference get(const key_type& key) const {
-			return graph->vertices[key].properties;
+			return storage->Get(key);
 		}
 
 		void put(const key_type& key, const value_type& value) const {
-			graph->vertices[key].properties = value;
+			storage->Set(key, value);
 		}
 	};
 
@@ -44,25 +48,33 @@ namespace graph {
 		const typename VertexPropertyMap<VertexProperties, Graph>::reference value) {
 		pm.put(key, value);
 	}
-
 }
 
 // EdgePropertyMap
 namespace graph {
 	template <typename EdgeProperties, typename Graph>
 	class EdgePropertyMap {
+	private:
+		using StorageType = detail::PropertiesStorage<EdgeProperties, RowLayoutTag>;
+		StorageType* storage;
 	public:
+		explicit EdgePropertyMap(StorageType* storage)
+			: storage(storage) {}
+
+		EdgePropertyMap()
+			: storage(nullptr) {}
+
 		using key_type = typename graph_traits<Graph>::edge_descriptor;
 		using value_type = EdgeProperties;
 		using reference = value_type&;
 		using category = boost::read_write_property_map_tag;
 
 		value_type& get(const key_type& key) const {
-			return *key.properties;
+			return storage->Get(key.id);
 		}
 
 		void put(const key_type& key, const value_type& value) const {
-			*key.properties = value;
+			storage->Set(key.id, value);
 		}
 	};
 
@@ -81,3 +93,93 @@ namespace graph {
 		pm.put(key, value);
 	}
 }
+
+// ColumnPropertyMap
+namespace graph {
+	// Bundle map of a graph with ColumnLayoutTag, Key is a vertex or an edge descriptor:
+	// a bundle is gathered from the columns on every access.
+	// Maps of single properties do not go through it, see the BundledSubPropertyMap specialization below.
+	template <typename Properties, typename Key>
+	class ColumnPropertyMap {
+	private:
+		using StorageType = detail::PropertiesStorage<Properties, ColumnLayoutTag>;
+		StorageType* storage;
+	public:
+		explicit ColumnPropertyMap(StorageType* storage)
+			: storage(storage) {}
+
+		ColumnPropertyMap()
+			: storage(nullptr) {}
+
+		using key_type = Key;
+		using value_type = Properties;
+		using reference = value_type;
+		using category = boost::read_write_property_map_tag;
+
+		value_type get(const key_type& key) const {
+			return storage->Get(detail::ElementIndex(key));
+		}
+
+		void put(const key_type& key, const value_type& value) const {
+			storage->Set(detail::ElementIndex(key), value);
+		}
+
+		template <typename Tag>
+		decltype(auto) Column() const {
+			return storage->template Column<Tag>();
+		}
+	};
+
+	template <typename Properties, typename Key>
+	inline typename ColumnPropertyMap<Properties, Key>::value_type get(
+		const ColumnPropertyMap<Properties, Key>& pm,
+		const typename ColumnPropertyMap<Properties, Key>::key_type& key) {
+		return pm.get(key);
+	}
+
+	template <typename Properties, typename Key>
+	inline void put(
+		ColumnPropertyMap<Properties, Key>& pm,
+		const typename ColumnPropertyMap<Properties, Key>::key_type& key,
+		const typename ColumnPropertyMap<Properties, Key>::value_type& value) {
+		pm.put(key, value);
+	}
+
+	namespace detail {
+		// A map of a single property stored in a column: plain array access by the vertex index or the edge id
+		template <typename Tag, typename Properties, typename Key>
+		class BundledSubPropertyMap<Tag, ColumnPropertyMap<Properties, Key>> {
+			using BaseBundledPM = ColumnPropertyMap<Properties, Key>;
+			using Index = detail::FindPropertyByTag_t<Tag, Properties>;
+		public:
+			using value_type = typename std::tuple_element<0, typename std::tuple_element<Index::value, typename Properties::Base>::type::Base>::type;
+			using reference = value_type&;
+			using key_type = typename BaseBundledPM::key_type;
+			using category = typename BaseBundledPM::category;
+
+			BundledSubPropertyMap(const BaseBundledPM& base) : column(base.template Column<Tag>()) {};
+			BundledSubPropertyMap() : column(nullptr) {};
+
+			reference operator[](const key_type& key) const {
+				return column[detail::ElementIndex(key)];
+			}
+
+		private:
+			value_type* column;
+		};
+	}
+
+	template <typename Tag, typename Properties, typename Key>
+	inline typename detail::BundledSubPropertyMap<Tag, ColumnPropertyMap<Properties, Key>>::reference get(
+		const detail::BundledSubPropertyMap<Tag, ColumnPropertyMap<Properties, Key>>& pMap,
+		const typename detail::BundledSubPropertyMap<Tag, ColumnPropertyMap<Properties, Key>>::key_type& key) {
+		return pMap[key];
+	};
+
+	template <typename Tag, typename Properties, typename Key>
+	inline void put(detail::BundledSubPropertyMap<Tag, ColumnPropertyMap<Properties, Key>>& pMap,
+		const typename detail::BundledSubPropertyMap<Tag, ColumnPropertyMap<Properties, Key>>::key_type& key,
+		const typename detail::BundledSubPropertyMap<Tag, ColumnPropertyMap<Properties, Key>>::value_type& value) {
+		pMap[key] = value;
+	};
+}
@@ -0,0 +1,166 @@
+#pragma once
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <graph/properties.hpp>
+#include <graph/detail/util/MappedArray.hpp>
+
+namespace graph {
+	// Layout tags of the property bundles stored in a static graph
+
+	// Every bundle is stored as a single record (array of structures)
+	struct RowLayoutTag {};
+
+	// Every property of a bundle is stored in its own contiguous array (structure of arrays)
+	struct ColumnLayoutTag {};
+
+	namespace detail {
+		template <typename Properties, typename Layout>
+		class PropertiesStorage {};
+
+		template <typename Properties>
+		class PropertiesStorage<Properties, RowLayoutTag> {
+		public:
+			using value_type = Properties;
+			using reference = value_type&;
+
+			void Reserve(size_t size) {
+				items.reserve(size);
+			}
+
+			void Resize(size_t size) {
+				items.resize(size);
+			}
+
+			void PushBack(const value_type& value) {
+				items.push_back(value);
+			}
+
+			size_t Size() const {
+				return items.size();
+			}
+
+			reference Get(size_t index) {
+				return items[index];
+			}
+
+			void Set(size_t index, const value_type& value) {
+				items[index] = value;
+			}
+
+		private:
+			std::vector<value_type> items;
+		};
+
+		template <typename PropertiesTuple>
+		struct ColumnsOf {};
+
+		template <typename... Ps>
+		struct ColumnsOf<std::tuple<Ps...>> {
+			using type = std::tuple<graphUtil::MappedArray<typename Ps::value_type>...>;
+		};
+
+		template <typename Properties>
+		class PropertiesStorage<Properties, ColumnLayoutTag> {
+			using PropertiesTuple = typename Properties::Base;
+			using ColumnsType = typename ColumnsOf<PropertiesTuple>::type;
+			using Indices = std::make_index_sequence<std::tuple_size<PropertiesTuple>::value>;
+
+			template <size_t I>
+			using TagOf = typename std::tuple_element<I, PropertiesTuple>::type::tag_type;
+
+			template <typename Tag>
+			using ColumnIndex = detail::FindPropertyByTag_t<Tag, Properties>;
+
+		public:
+			using value_type = Properties;
+			// Bundles do not exist in memory, so they are gathered and scattered by value
+			using reference = value_type;
+
+			template <typename Tag>
+			using ColumnValueType = typename std::tuple_element<ColumnIndex<Tag>::value, ColumnsType>::type::value_type;
+
+			void Reserve(size_t size) {
+				ForEachColumn([size](auto& column) { column.reserve(size); }, Indices());
+			}
+
+			void Resize(size_t size) {
+				count = size;
+				ForEachColumn([size](auto& column) { column.resize(size); }, Indices());
+			}
+
+			void PushBack(const value_type& value) {
+				Resize(count + 1);
+				Set(count - 1, value);
+			}
+
+			size_t Size() const {
+				return count;
+			}
+
+			value_type Get(size_t index) const {
+				value_type result;
+				Gather(result, index, Indices());
+				return result;
+			}
+
+			void Set(size_t index, const value_type& value) {
+				Scatter(value, index, Indices());
+			}
+
+			template <typename Tag>
+			ColumnValueType<Tag>* Column() {
+				return std::get<ColumnIndex<Tag>::value>(columns).data();
+			}
+
+			static constexpr size_t ColumnsCount() {
+				return std::tuple_size<ColumnsType>::value;
+			}
+
+			// Calls function(column) for every column in the order of the properties in the bundle
+			template <typename Function>
+			void ForEachColumn(Function&& function) {
+				ForEachColumn(function, Indices());
+			}
+
+			template <typename Function>
+			void ForEachColumn(Function&& function) const {
+				ForEachColumn(function, Indices());
+			}
+
+			// Sets the size after the columns were replaced through ForEachColumn, e.g. by views of a mapped snapshot
+			void ResetSize(size_t size) {
+				count = size;
+			}
+
+		private:
+			template <typename Function, size_t... Is>
+			void ForEachColumn(Function&& function, std::index_sequence<Is...>) {
+				using expand = int[];
+				(void)expand{0, (function(std::get<Is>(columns)), 0)...};
+			}
+
+			template <typename Function, size_t... Is>
+			void ForEachColumn(Function&& function, std::index_sequence<Is...>) const {
+				using expand = int[];
+				(void)expand{0, (function(std::get<Is>(columns)), 0)...};
+			}
+
+			template <size_t... Is>
+			void Gather(value_type& value, size_t index, std::index_sequence<Is...>) const {
+				using expand = int[];
+				(void)expand{0, (graph::get<TagOf<Is>>(value) = std::get<Is>(columns)[index], 0)...};
+			}
+
+			template <size_t... Is>
+			void Scatter(const value_type& value, size_t index, std::index_sequence<Is...>) {
+				using expand = int[];
+				(void)expand{0, (std::get<Is>(columns)[index] = graph::get<TagOf<Is>>(value), 0)...};
+			}
+
+			ColumnsType columns;
+			size_t count = 0;
+		};
+	}
+}
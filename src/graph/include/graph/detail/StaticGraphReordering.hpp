@@ -0,0 +1,198 @@
+#pragma once
+#include <algorithm>
+#include <cinttypes>
+#include <numeric>
+#include <vector>
+#include "graph/detail/util/MappedArray.hpp"
+
+namespace graph {
+	// Binary snapshot of a built graph, see graph/static_graph_snapshot.hpp
+	template <typename Graph>
+	class GraphSnapshot;
+
+	// Vertex numberings the builder can renumber the vertices into, see GraphBuilder::Reorder
+	enum class VertexOrder {
+		Input,
+		BreadthFirst,
+		DepthFirst,
+		Degree,
+		HilbertCurve
+	};
+
+	struct VertexCoordinates {
+		double x;
+		double y;
+	};
+
+	// Maps the vertex ids of the builder input (external) to the ids in a reordered graph (internal) and back.
+	// An empty permutation is the identity.
+	class VertexPermutation {
+		template <typename Graph>
+		friend class GraphSnapshot;
+	public:
+		VertexPermutation() = default;
+
+		// internalIds[v] is the internal id of the external vertex v
+		explicit VertexPermutation(const std::vector<uint32_t>& internalIds) {
+			toInternal.resize(internalIds.size());
+			toExternal.resize(internalIds.size());
+			for (uint32_t v = 0; v < internalIds.size(); ++v) {
+				toInternal[v] = internalIds[v];
+				toExternal[internalIds[v]] = v;
+			}
+		}
+
+		bool IsIdentity() const {
+			return toInternal.size() == 0;
+		}
+
+		uint32_t ToInternal(uint32_t external) const {
+			return IsIdentity() ? external : toInternal[external];
+		}
+
+		uint32_t ToExternal(uint32_t internal) const {
+			return IsIdentity() ? internal : toExternal[internal];
+		}
+
+	private:
+		graphUtil::MappedArray<uint32_t> toInternal;
+		graphUtil::MappedArray<uint32_t> toExternal;
+	};
+
+	namespace detail {
+		// Undirected adjacencies of the builder edges in CSR form, used by the traversal orders
+		template <typename Edges>
+		void UndirectedAdjacencies(size_t n, const Edges& edges,
+								   std::vector<uint32_t>& offsets, std::vector<uint32_t>& adjacencies) {
+			offsets.assign(n + 1, 0);
+			for (const auto& edge : edges) {
+				++offsets[edge.source + 1];
+				++offsets[edge.target + 1];
+			}
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+			adjacencies.resize(offsets[n]);
+			auto cursors = std::vector<uint32_t>(offsets.begin(), offsets.end() - 1);
+			for (const auto& edge : edges) {
+				adjacencies[cursors[edge.source]++] = edge.target;
+				adjacencies[cursors[edge.target]++] = edge.source;
+			}
+		}
+
+		// Internal ids in the order of the first visit of a breadth or depth first traversal
+		// which ignores the edge directions and restarts from the smallest unvisited vertex
+		template <typename Edges>
+		std::vector<uint32_t> TraversalOrder(size_t n, const Edges& edges, bool isDepthFirst) {
+			std::vector<uint32_t> offsets, adjacencies;
+			UndirectedAdjacencies(n, edges, offsets, adjacencies);
+
+			const auto unvisited = static_cast<uint32_t>(n);
+			std::vector<uint32_t> internalIds(n, unvisited);
+			std::vector<uint32_t> pending;
+			uint32_t nextId = 0;
+			for (uint32_t root = 0; root < n; ++root) {
+				if (internalIds[root] != unvisited) continue;
+				if (isDepthFirst) {
+					pending.push_back(root);
+					while (!pending.empty()) {
+						auto v = pending.back();
+						pending.pop_back();
+						if (internalIds[v] != unvisited) continue;
+						internalIds[v] = nextId++;
+						// reversed, so the neighbours are visited in the increasing order
+						for (auto i = offsets[v + 1]; i > offsets[v]; --i) {
+							if (internalIds[adjacencies[i - 1]] == unvisited)
+								pending.push_back(adjacencies[i - 1]);
+						}
+					}
+				} else {
+					internalIds[root] = nextId++;
+					pending.assign(1, root);
+					for (size_t head = 0; head < pending.size(); ++head) {
+						auto v = pending[head];
+						for (auto i = offsets[v]; i < offsets[v + 1]; ++i) {
+							auto u = adjacencies[i];
+							if (internalIds[u] != unvisited) continue;
+							internalIds[u] = nextId++;
+							pending.push_back(u);
+						}
+					}
+					pending.clear();
+				}
+			}
+			return internalIds;
+		}
+
+		// Internal ids sorted by the decreasing in + out degree, hubs come first
+		template <typename Edges>
+		std::vector<uint32_t> DegreeOrder(size_t n, const Edges& edges) {
+			std::vector<uint32_t> degrees(n, 0);
+			for (const auto& edge : edges) {
+				++degrees[edge.source];
+				++degrees[edge.target];
+			}
+			std::vector<uint32_t> order(n);
+			std::iota(order.begin(), order.end(), 0);
+			std::stable_sort(order.begin(), order.end(), [&degrees](uint32_t a, uint32_t b) {
+				return degrees[a] > degrees[b];
+			});
+			std::vector<uint32_t> internalIds(n);
+			for (uint32_t i = 0; i < n; ++i) {
+				internalIds[order[i]] = i;
+			}
+			return internalIds;
+		}
+
+		// Position of the cell (x, y) along the Hilbert curve filling the 2^16 x 2^16 grid
+		inline uint64_t HilbertIndex(uint32_t x, uint32_t y) {
+			uint64_t index = 0;
+			for (uint32_t side = 1u << 15; side > 0; side >>= 1) {
+				uint32_t rx = (x & side) > 0;
+				uint32_t ry = (y & side) > 0;
+				index += static_cast<uint64_t>(side) * side * ((3 * rx) ^ ry);
+				if (ry == 0) {
+					if (rx == 1) {
+						x = side - 1 - (x & (side - 1));
+						y = side - 1 - (y & (side - 1));
+					}
+					std::swap(x, y);
+				}
+			}
+			return index;
+		}
+
+		// Internal ids sorted along the Hilbert curve through the bounding box of the coordinates
+		inline std::vector<uint32_t> HilbertCurveOrder(const std::vector<VertexCoordinates>& coordinates) {
+			const size_t n = coordinates.size();
+			std::vector<uint32_t> internalIds(n);
+			if (n == 0) return internalIds;
+
+			auto minX = coordinates[0].x, maxX = coordinates[0].x;
+			auto minY = coordinates[0].y, maxY = coordinates[0].y;
+			for (const auto& point : coordinates) {
+				minX = std::min(minX, point.x);
+				maxX = std::max(maxX, point.x);
+				minY = std::min(minY, point.y);
+				maxY = std::max(maxY, point.y);
+			}
+			const double cells = (1u << 16) - 1;
+			auto quantize = [cells](double value, double min, double max) {
+				return max > min ? static_cast<uint32_t>((value - min) / (max - min) * cells) : 0u;
+			};
+
+			std::vector<uint64_t> indices(n);
+			for (size_t v = 0; v < n; ++v) {
+				indices[v] = HilbertIndex(quantize(coordinates[v].x, minX, maxX),
+										  quantize(coordinates[v].y, minY, maxY));
+			}
+			std::vector<uint32_t> order(n);
+			std::iota(order.begin(), order.end(), 0);
+			std::stable_sort(order.begin(), order.end(), [&indices](uint32_t a, uint32_t b) {
+				return indices[a] < indices[b];
+			});
+			for (uint32_t i = 0; i < n; ++i) {
+				internalIds[order[i]] = i;
+			}
+			return internalIds;
+		}
+	}
+}
@@ -1,91 +1,93 @@
 #pragma once
 
 namespace graph {
-#define Properties VertexProperties, EdgeProperties
-	template <typename VertexProperties, typename EdgeProperties>
-	inline std::pair<typename StaticGraph<Properties>::vertex_iterator, typename StaticGraph<Properties>::vertex_iterator>
-	vertices(const StaticGraph<Properties>& g) {
+#define StaticGraphTemplate template <typename VertexProperties, typename EdgeProperties, typename Layout, typename Links>
+#define StaticGraphType StaticGraph<VertexProperties, EdgeProperties, Layout, Links>
+	StaticGraphTemplate
+	inline std::pair<typename StaticGraphType::vertex_iterator, typename StaticGraphType::vertex_iterator>
+	vertices(const StaticGraphType& g) {
 		return std::make_pair(g.Vertices().begin(), g.Vertices().end());
 	}
 
-	template <typename VertexProperties, typename EdgeProperties>
-	inline std::pair<typename StaticGraph<Properties>::adjacency_iterator, typename StaticGraph<Properties>::adjacency_iterator>
-	adjacent_vertices(typename StaticGraph<Properties>::vertex_descriptor u, const StaticGraph<Properties>& g) {
+	StaticGraphTemplate
+	inline std::pair<typename StaticGraphType::adjacency_iterator, typename StaticGraphType::adjacency_iterator>
+	adjacent_vertices(typename StaticGraphType::vertex_descriptor u, const StaticGraphType& g) {
 		auto edgesCollection = g.OutAdjacencies(u);
 		return std::make_pair(edgesCollection.begin(), edgesCollection.end());
 	}
 
-	template <typename VertexProperties, typename EdgeProperties>
-	inline std::pair<typename StaticGraph<Properties>::adjacency_iterator, typename StaticGraph<Properties>::adjacency_iterator>
-	in_adjacent_vertices(typename StaticGraph<Properties>::vertex_descriptor u, const StaticGraph<Properties>& g) {
+	StaticGraphTemplate
+	inline std::pair<typename StaticGraphType::adjacency_iterator, typename StaticGraphType::adjacency_iterator>
+	in_adjacent_vertices(typename StaticGraphType::vertex_descriptor u, const StaticGraphType& g) {
 		auto edgesCollection = g.InAdjacencies(u);
 		return std::make_pair(edgesCollection.begin(), edgesCollection.end());
 	}
 
-	template <typename VertexProperties, typename EdgeProperties>
-	inline typename StaticGraph<Properties>::vertex_descriptor source(
-		typename StaticGraph<Properties>::edge_descriptor e, const StaticGraph<Properties>&) {
+	StaticGraphTemplate
+	inline typename StaticGraphType::vertex_descriptor source(
+		typename StaticGraphType::edge_descriptor e, const StaticGraphType&) {
 		return e.source;
 	}
 
-	template <typename VertexProperties, typename EdgeProperties>
-	inline typename StaticGraph<Properties>::vertex_descriptor target(
-		typename StaticGraph<Properties>::edge_descriptor e, const StaticGraph<Properties>&) {
+	StaticGraphTemplate
+	inline typename StaticGraphType::vertex_descriptor target(
+		typename StaticGraphType::edge_descriptor e, const StaticGraphType&) {
 		return e.target;
 	}
 
-	template <typename VertexProperties, typename EdgeProperties>
-	inline typename StaticGraph<Properties>::degree_size_type out_degree(
-		typename StaticGraph<Properties>::vertex_descriptor u, const StaticGraph<Properties>& g) {
-		return g.OutAdjacencies(u).size();
+	StaticGraphTemplate
+	inline typename StaticGraphType::degree_size_type out_degree(
+		typename StaticGraphType::vertex_descriptor u, const StaticGraphType& g) {
+		return g.OutDegree(u);
 	}
 
-	template <typename VertexProperties, typename EdgeProperties>
-	inline std::pair<typename StaticGraph<Properties>::out_edge_iterator, typename StaticGraph<Properties>::out_edge_iterator>
-	out_edges(typename StaticGraph<Properties>::vertex_descriptor u, const StaticGraph<Properties>& g) {
+	StaticGraphTemplate
+	inline std::pair<typename StaticGraphType::out_edge_iterator, typename StaticGraphType::out_edge_iterator>
+	out_edges(typename StaticGraphType::vertex_descriptor u, const StaticGraphType& g) {
 		auto edgesCollection = g.OutEdges(u);
 		return std::make_pair(edgesCollection.begin(), edgesCollection.end());
 	}
 
-	template <typename VertexProperties, typename EdgeProperties>
-	inline typename StaticGraph<Properties>::vertices_size_type num_vertices(const StaticGraph<Properties>& g) {
+	StaticGraphTemplate
+	inline typename StaticGraphType::vertices_size_type num_vertices(const StaticGraphType& g) {
 		return g.Vertices().size();
 	}
 
-	template <typename VertexProperties, typename EdgeProperties>
-	inline typename StaticGraph<Properties>::edges_size_type num_edges(const StaticGraph<Properties>& g) {
+	StaticGraphTemplate
+	inline typename StaticGraphType::edges_size_type num_edges(const StaticGraphType& g) {
 		return g.EdgesCount();
 	}
 
-	template <typename VertexProperties, typename EdgeProperties>
-	inline std::pair<typename StaticGraph<Properties>::in_edge_iterator, typename StaticGraph<Properties>::in_edge_iterator>
-	in_edges(typename StaticGraph<Properties>::vertex_descriptor v, const StaticGraph<Properties>& g) {
+	StaticGraphTemplate
+	inline std::pair<typename StaticGraphType::in_edge_iterator, typename StaticGraphType::in_edge_iterator>
+	in_edges(typename StaticGraphType::vertex_descriptor v, const StaticGraphType& g) {
 		auto edgesCollection = g.InEdges(v);
 		return std::make_pair(edgesCollection.begin(), edgesCollection.end());
 	}
 
-	template <typename VertexProperties, typename EdgeProperties>
-	inline typename StaticGraph<Properties>::degree_size_type in_degree(
-		typename StaticGraph<Properties>::vertex_descriptor v, const StaticGraph<Properties>& g) {
-		return g.InAdjacencies(v).size();
+	StaticGraphTemplate
+	inline typename StaticGraphType::degree_size_type in_degree(
+		typename StaticGraphType::vertex_descriptor v, const StaticGraphType& g) {
+		return g.InDegree(v);
 	}
 
-	template <typename VertexProperties, typename EdgeProperties>
-	inline typename StaticGraph<Properties>::degree_size_type degree(
-		typename StaticGraph<Properties>::vertex_descriptor v, const StaticGraph<Properties>& g) {
+	StaticGraphTemplate
+	inline typename StaticGraphType::degree_size_type degree(
+		typename StaticGraphType::vertex_descriptor v, const StaticGraphType& g) {
 		return in_degree(v, g) + out_degree(v, g);
 	}
 
-	template <typename VertexProperties, typename EdgeProperties>
-	inline std::pair<typename StaticGraph<Properties>::edge_descriptor, bool> edge(
-		typename StaticGraph<Properties>::vertex_descriptor u,
-		typename StaticGraph<Properties>::vertex_descriptor v,
-		const StaticGraph<Properties>& graph) {
-		using EdgeDescriptor = typename StaticGraph<Properties>::edge_descriptor;
+	StaticGraphTemplate
+	inline std::pair<typename StaticGraphType::edge_descriptor, bool> edge(
+		typename StaticGraphType::vertex_descriptor u,
+		typename StaticGraphType::vertex_descriptor v,
+		const StaticGraphType& graph) {
+		using EdgeDescriptor = typename StaticGraphType::edge_descriptor;
 		for (const auto& edge : graphUtil::Range(out_edges(u, graph))) {
-			if (target(edge, graph) == v) return make_pair(edge, true);
+			if (target(edge, graph) == v) return std::make_pair(edge, true);
 		}
-		return make_pair(EdgeDescriptor(), false);
+		return std::make_pair(EdgeDescriptor(), false);
 	}
-#undef Properties
+#undef StaticGraphType
+#undef StaticGraphTemplate
 }
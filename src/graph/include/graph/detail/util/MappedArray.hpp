@@ -0,0 +1,128 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace graphUtil {
+	// Contiguous array which either owns its items or views memory owned by the holder (e.g. a mapped file).
+	// A view is copied to owned memory before its size changes.
+	template <typename T>
+	class MappedArray {
+		static_assert(!std::is_same<T, bool>::value, "std::vector<bool> is bit-packed, use char for boolean arrays");
+	public:
+		using value_type = T;
+		using iterator = T*;
+		using const_iterator = const T*;
+
+		MappedArray() = default;
+
+		MappedArray(const MappedArray& other)
+			: items(other.items), holder(other.holder) {
+			if (holder) {
+				first = other.first;
+				count = other.count;
+			} else {
+				Sync();
+			}
+		}
+
+		MappedArray(MappedArray&& other) noexcept
+			: items(std::move(other.items)), first(other.first), count(other.count), holder(std::move(other.holder)) {
+			other.first = nullptr;
+			other.count = 0;
+		}
+
+		MappedArray& operator=(MappedArray other) {
+			std::swap(items, other.items);
+			std::swap(first, other.first);
+			std::swap(count, other.count);
+			std::swap(holder, other.holder);
+			return *this;
+		}
+
+		static MappedArray View(T* data, size_t size, std::shared_ptr<void> holder) {
+			MappedArray result;
+			result.first = data;
+			result.count = size;
+			result.holder = std::move(holder);
+			return result;
+		}
+
+		bool IsView() const {
+			return holder != nullptr;
+		}
+
+		void reserve(size_t size) {
+			Detach();
+			items.reserve(size);
+			Sync();
+		}
+
+		void resize(size_t size) {
+			Detach();
+			items.resize(size);
+			Sync();
+		}
+
+		void assign(size_t size, const T& value) {
+			holder.reset();
+			items.assign(size, value);
+			Sync();
+		}
+
+		size_t size() const {
+			return count;
+		}
+
+		T* data() {
+			return first;
+		}
+
+		const T* data() const {
+			return first;
+		}
+
+		T& operator[](size_t index) {
+			return first[index];
+		}
+
+		const T& operator[](size_t index) const {
+			return first[index];
+		}
+
+		iterator begin() {
+			return first;
+		}
+
+		iterator end() {
+			return first + count;
+		}
+
+		const_iterator begin() const {
+			return first;
+		}
+
+		const_iterator end() const {
+			return first + count;
+		}
+
+	private:
+		void Detach() {
+			if (holder) {
+				items.assign(first, first + count);
+				holder.reset();
+			}
+		}
+
+		void Sync() {
+			first = items.data();
+			count = items.size();
+		}
+
+		std::vector<T> items;
+		T* first = nullptr;
+		size_t count = 0;
+		std::shared_ptr<void> holder;
+	};
+}
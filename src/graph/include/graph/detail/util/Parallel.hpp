@@ -0,0 +1,39 @@
+#pragma once
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace graphUtil {
+	inline size_t DefaultThreadsCount() {
+		return std::max<size_t>(1, std::thread::hardware_concurrency());
+	}
+
+	// Splits [begin, end) into threadsCount contiguous chunks and calls function(chunkIndex, chunkBegin, chunkEnd)
+	// for every chunk on its own thread. The split depends only on the arguments, so two calls with the same
+	// range and threadsCount give the same chunks.
+	template <typename Function>
+	void ParallelFor(size_t begin, size_t end, size_t threadsCount, Function&& function) {
+		threadsCount = std::max<size_t>(1, threadsCount);
+		auto chunkBegin = [=](size_t chunk) {
+			return begin + (end - begin) * chunk / threadsCount;
+		};
+
+		if (threadsCount == 1) {
+			function(size_t(0), begin, end);
+			return;
+		}
+
+		std::vector<std::thread> threads;
+		threads.reserve(threadsCount - 1);
+		for (size_t chunk = 1; chunk < threadsCount; ++chunk) {
+			threads.emplace_back([&function, chunk, &chunkBegin]() {
+				function(chunk, chunkBegin(chunk), chunkBegin(chunk + 1));
+			});
+		}
+		function(size_t(0), chunkBegin(0), chunkBegin(1));
+		for (auto& thread : threads) {
+			thread.join();
+		}
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "graph/detail/util/Parallel.hpp"
+
+namespace graphUtil {
+	// Fixed set of worker threads started once and reused by every Run.
+	// Run(function) calls function(workerIndex) on every worker and returns when all of them are done.
+	class ThreadPool {
+	public:
+		explicit ThreadPool(size_t threadsCount = DefaultThreadsCount())
+			: generation(0),
+			  running(0),
+			  stopping(false) {
+			threadsCount = std::max<size_t>(1, threadsCount);
+			workers.reserve(threadsCount);
+			for (size_t worker = 0; worker < threadsCount; ++worker) {
+				workers.emplace_back([this, worker]() { Work(worker); });
+			}
+		}
+
+		~ThreadPool() {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				stopping = true;
+			}
+			wake.notify_all();
+			for (auto& worker : workers) {
+				worker.join();
+			}
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		size_t Size() const {
+			return workers.size();
+		}
+
+		template <typename Function>
+		void Run(Function&& function) {
+			std::unique_lock<std::mutex> lock(mutex);
+			task = std::forward<Function>(function);
+			running = workers.size();
+			++generation;
+			wake.notify_all();
+			done.wait(lock, [this]() { return running == 0; });
+			task = nullptr;
+		}
+
+	private:
+		void Work(size_t worker) {
+			size_t seenGeneration = 0;
+			while (true) {
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait(lock, [&]() { return stopping || generation != seenGeneration; });
+				if (stopping)
+					return;
+				seenGeneration = generation;
+				lock.unlock();
+
+				task(worker);
+
+				lock.lock();
+				if (--running == 0)
+					done.notify_one();
+			}
+		}
+
+		std::vector<std::thread> workers;
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::condition_variable done;
+		std::function<void(size_t)> task;
+		size_t generation;
+		size_t running;
+		bool stopping;
+	};
+}
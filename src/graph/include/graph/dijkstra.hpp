@@ -3,21 +3,28 @@
 #include <graph/properties.hpp>
 #include <graph/static_graph.hpp>
 #include <boost/graph/dijkstra_shortest_paths.hpp>
-#include <graph/queue/DijkstraQueue.hpp>
+#include <graph/queue/QueuePolicies.hpp>
+#include <algorithm>
 #include <limits>
+#include <utility>
+#include <vector>
 
 namespace graph
 {
+	// Search data is kept in columns by default, so relaxing an edge touches only the distance and color arrays.
+	// Dijkstra never looks at the in edges, so Links may be ForwardLinksTag
 	template <typename PredecessorMapTag, class DisanceMapTag, typename WeightMapTag,
 	          typename IndexMapTag, typename ColorMapTag, typename BundledVertexProperties,
-	          typename BundledEdgeProperties>
+	          typename BundledEdgeProperties, typename Layout = ColumnLayoutTag,
+	          typename Links = BidirectionalLinksTag>
 	struct GenerateDijkstraGraph {};
 
 
 	template <typename PredecessorMapTag, class DisanceMapTag, typename WeightMapTag,
-	          typename IndexMapTag, typename ColorMapTag, typename... P1s, typename... P2s>
+	          typename IndexMapTag, typename ColorMapTag, typename... P1s, typename... P2s,
+	          typename Layout, typename Links>
 	struct GenerateDijkstraGraph<PredecessorMapTag, DisanceMapTag, WeightMapTag,
-	                             IndexMapTag, ColorMapTag, Properties<P1s...>, Properties<P2s...>> {
+	                             IndexMapTag, ColorMapTag, Properties<P1s...>, Properties<P2s...>, Layout, Links> {
 		using type = StaticGraph<
 			Properties<
 				Property<PredecessorMapTag,
@@ -27,7 +34,9 @@ namespace graph
 				P1s...>,
 			Properties<
 				Property<WeightMapTag, uint32_t>,
-				P2s...>>;
+				P2s...>,
+			Layout,
+			Links>;
 	};
 
 	template <typename DistanceMap>
@@ -80,7 +89,7 @@ namespace graph
 		IterationIdType currentIterationId;
 	public:
 
-		void Initialize(Graph& graph) {
+		void Initialize(const Graph& graph) {
 			auto verticesCount = num_vertices(graph);
 			vertexIterationId.resize(verticesCount, 0);
 			if (currentIterationId == std::numeric_limits<IterationIdType>::max()) {
@@ -106,11 +115,12 @@ namespace graph
 		}
 	};
 
-	template <typename Graph>
+	// QueuePolicy picks the queue of the search, see graph/queue/QueuePolicies.hpp
+	template <typename Graph, typename QueuePolicy = queue::DijkstraQueuePolicy>
 	struct DefaultDijkstraVisitor : public IDijkstraVisitor<Graph> {
 		struct SharedDataStorage {
-			using QueueType = queue::DijkstraQueue<
-				uint32_t, 
+			using QueueType = typename QueuePolicy::template QueueType<
+				uint32_t,
 				typename graph_traits<Graph>::vertex_descriptor,
 				typename property_map<Graph, vertex_index_t>::type>;
 			QueueType Queue;
@@ -122,7 +132,7 @@ namespace graph
 		DefaultDijkstraVisitor()
 			: Stored() {}
 
-		void Initialize(Graph& graph) {
+		void Initialize(const Graph& graph) {
 			auto verticesCount = num_vertices(graph);
 			Stored.Queue.Resize(verticesCount);
 			Stored.Queue.Clear();
@@ -131,6 +141,179 @@ namespace graph
 		}
 	};
 
+	template <typename Graph, typename WeightMap>
+	typename WeightMap::value_type max_edge_weight(const Graph& graph, const WeightMap& weight) {
+		typename WeightMap::value_type maxWeight = 0;
+		for (const auto& v : graphUtil::Range(vertices(graph))) {
+			for (const auto& edge : graphUtil::Range(out_edges(v, graph))) {
+				maxWeight = std::max(maxWeight, get(weight, edge));
+			}
+		}
+		return maxWeight;
+	}
+
+	// Dial's algorithm for small integer weights, the buckets are sized once for the maximal weight
+	// of the graph, e.g. BucketDijkstraVisitor<Graph>(max_edge_weight(graph, weight))
+	template <typename Graph>
+	struct BucketDijkstraVisitor : public DefaultDijkstraVisitor<Graph, queue::BucketQueuePolicy> {
+		explicit BucketDijkstraVisitor(uint32_t maxWeight = 0) {
+			this->Stored.Queue.SetMaxKeyDelta(maxWeight);
+		}
+	};
+
+	// Property map over an array of per-vertex search data, the array is addressed by the vertex index
+	template <typename Value, typename IndexMap>
+	class VertexArrayPropertyMap {
+	public:
+		using key_type = typename IndexMap::key_type;
+		using value_type = Value;
+		using reference = Value&;
+		using category = boost::lvalue_property_map_tag;
+
+		VertexArrayPropertyMap()
+			: data(nullptr) {}
+
+		VertexArrayPropertyMap(Value* data, const IndexMap& index)
+			: data(data),
+			  index(index) {}
+
+		reference operator[](const key_type& key) const {
+			return data[get(index, key)];
+		}
+
+	private:
+		Value* data;
+		IndexMap index;
+	};
+
+	template <typename Value, typename IndexMap>
+	inline typename VertexArrayPropertyMap<Value, IndexMap>::reference get(
+		const VertexArrayPropertyMap<Value, IndexMap>& pMap,
+		const typename VertexArrayPropertyMap<Value, IndexMap>::key_type& key) {
+		return pMap[key];
+	}
+
+	template <typename Value, typename IndexMap>
+	inline void put(const VertexArrayPropertyMap<Value, IndexMap>& pMap,
+		const typename VertexArrayPropertyMap<Value, IndexMap>::key_type& key,
+		const typename VertexArrayPropertyMap<Value, IndexMap>::value_type& value) {
+		pMap[key] = value;
+	}
+
+	// Search state of one query kept outside the graph: the predecessor, distance and color of the vertices,
+	// the queue and the initialization marks. The searches taking a context only read the graph,
+	// so one graph serves any number of threads with a context each.
+	template <typename Graph, typename DistanceType = uint32_t, typename QueuePolicy = queue::DijkstraQueuePolicy>
+	class QueryContext {
+	public:
+		using Vertex = typename graph_traits<Graph>::vertex_descriptor;
+		using IndexMap = typename property_map<Graph, vertex_index_t>::type;
+		using PredecessorMap = VertexArrayPropertyMap<Vertex, IndexMap>;
+		using DistanceMap = VertexArrayPropertyMap<DistanceType, IndexMap>;
+		using ColorMap = VertexArrayPropertyMap<boost::two_bit_color_type, IndexMap>;
+		using SharedDataStorage = typename DefaultDijkstraVisitor<Graph, QueuePolicy>::SharedDataStorage;
+
+		explicit QueryContext(const Graph& graph, const IndexMap& index = IndexMap())
+			: index(index),
+			  predecessors(num_vertices(graph)),
+			  distances(num_vertices(graph)),
+			  colors(num_vertices(graph)),
+			  predecessor(predecessors.data(), index),
+			  distance(distances.data(), index),
+			  color(colors.data(), index),
+			  Stored() {}
+
+		// the maps point to the arrays of this context
+		QueryContext(const QueryContext&) = delete;
+		QueryContext& operator=(const QueryContext&) = delete;
+		QueryContext(QueryContext&&) = default;
+
+		PredecessorMap& Predecessor() {
+			return predecessor;
+		}
+
+		DistanceMap& Distance() {
+			return distance;
+		}
+
+		ColorMap& Color() {
+			return color;
+		}
+
+		// The maps keep values of the previous queries for the vertices not reached by the last one
+		bool IsReached(const Vertex& v) const {
+			return Stored.VertexInitializer.IsInitialized(v, index);
+		}
+
+		// The vertices from s to t on the predecessors path of the last query, the query must have reached t
+		void Path(const Vertex& s, const Vertex& t, std::vector<Vertex>& path) const {
+			path.clear();
+			for (Vertex v = t; v != s; v = predecessors[get(index, v)]) {
+				path.push_back(v);
+			}
+			path.push_back(s);
+			std::reverse(path.begin(), path.end());
+		}
+
+	private:
+		IndexMap index;
+		std::vector<Vertex> predecessors;
+		std::vector<DistanceType> distances;
+		std::vector<boost::two_bit_color_type> colors;
+		PredecessorMap predecessor;
+		DistanceMap distance;
+		ColorMap color;
+
+	public:
+		SharedDataStorage Stored;
+	};
+
+	// Stops the search once the target is settled, e.g. for point-to-point queries
+	template <typename Graph, typename QueuePolicy = queue::DijkstraQueuePolicy>
+	struct TargetDijkstraVisitor : public DefaultDijkstraVisitor<Graph, QueuePolicy> {
+		explicit TargetDijkstraVisitor(const typename graph_traits<Graph>::vertex_descriptor& target)
+			: target(target),
+			  targetSettled(false) {}
+
+		void finish_vertex(const typename graph_traits<Graph>::vertex_descriptor& v, const Graph&) {
+			if (v == target)
+				targetSettled = true;
+		}
+
+		bool should_continue() {
+			return !targetSettled;
+		}
+
+	private:
+		typename graph_traits<Graph>::vertex_descriptor target;
+		bool targetSettled;
+	};
+
+	namespace detail {
+		// Hands the queue and the initialization marks of a context to a visitor for one search,
+		// the buffers are swapped, so nothing is allocated per query
+		template <typename SharedDataStorage>
+		class StoredDataLoan {
+		public:
+			StoredDataLoan(SharedDataStorage& owner, SharedDataStorage& borrower)
+				: owner(owner),
+				  borrower(borrower) {
+				std::swap(owner, borrower);
+			}
+
+			~StoredDataLoan() {
+				std::swap(owner, borrower);
+			}
+
+			StoredDataLoan(const StoredDataLoan&) = delete;
+			StoredDataLoan& operator=(const StoredDataLoan&) = delete;
+
+		private:
+			SharedDataStorage& owner;
+			SharedDataStorage& borrower;
+		};
+	}
+
 	template <class Graph, class PredecessorMap, class DistanceMap,
 	          class IndexMap, class ColorMap, class DijkstraVisitor>
 	void EnsureVertexInitialization(Graph& graph,
@@ -249,4 +432,17 @@ namespace graph
 				break;
 		}
 	};
+
+	// The search on a shared graph: the search state is taken from the context and the graph is only read.
+	// The visitor must derive from DefaultDijkstraVisitor<Graph, QueuePolicy>, its own storage is not used.
+	template <class Graph, class WeightMap, class IndexMap, class DistanceType, class QueuePolicy,
+	          class DijkstraVisitor = DefaultDijkstraVisitor<Graph, QueuePolicy>>
+	void dijkstra(const Graph& graph,
+	              const typename graph_traits<Graph>::vertex_descriptor& s,
+	              WeightMap& weight, IndexMap& index, QueryContext<Graph, DistanceType, QueuePolicy>& context,
+	              DijkstraVisitor&& visitor = DijkstraVisitor()) {
+		detail::StoredDataLoan<typename QueryContext<Graph, DistanceType, QueuePolicy>::SharedDataStorage>
+				loan(context.Stored, visitor.Stored);
+		dijkstra(graph, s, context.Predecessor(), context.Distance(), weight, index, context.Color(), visitor);
+	}
 }
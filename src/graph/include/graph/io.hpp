@@ -1,15 +1,19 @@
 #pragma once
 
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <utility>
+#include <vector>
 #include <graph/properties.hpp>
-#include <graph/io/FileReader.hpp>
+#include <graph/io/MappedFileReader.hpp>
+#include <graph/detail/util/Parallel.hpp>
 
 template <typename EdgeWeightProperty, typename BackInsertIterator>
 int read_ddsg(BackInsertIterator backInserter, size_t& numOfNodes, size_t& numOfEdges, 
     const char* fileName) {
     using namespace std;
-    graphIO::FileReader input;
+    graphIO::MappedFileReader input;
     if (!input.Open(fileName)) {
         cerr << "File "<<fileName<<" not found!" << endl;
         return 1;
@@ -57,7 +61,7 @@ template <typename EdgeWeightProperty, typename EdgeDirectionProperty, typename
 int read_ddsg(BackInsertIterator backInserter, size_t& numOfNodes, size_t& numOfEdges,
     const char* fileName) {
     using namespace std;
-    graphIO::FileReader input;
+    graphIO::MappedFileReader input;
     if (!input.Open(fileName)) {
         cerr << "File " << fileName << " not found!" << endl;
         return 1;
@@ -102,4 +106,185 @@ int read_ddsg(BackInsertIterator backInserter, size_t& numOfNodes, size_t& numOf
 
     input.Close();
     return 0;
-};
\ No newline at end of file
+};
+
+namespace graphIO {
+    namespace detail {
+        // Splits [begin, end) into chunksCount chunks which start at line starts
+        inline std::vector<const char*> SplitAtLines(const char* begin, const char* end, size_t chunksCount) {
+            std::vector<const char*> bounds(1, begin);
+            for (size_t chunk = 1; chunk < chunksCount; ++chunk) {
+                const char* bound = std::max(bounds.back(), begin + (end - begin) * chunk / chunksCount);
+                while (bound != begin && bound != end && bound[-1] != '\n') ++bound;
+                bounds.push_back(bound);
+            }
+            bounds.push_back(end);
+            return bounds;
+        }
+
+        // Parses a mapped file on threadsCount threads into a graph. parseHeader(reader) reads the header
+        // and returns the vertices count (0 for a wrong header), then the rest of the file is split
+        // at the line starts and parseLine(reader, edges) reads a line of a chunk into the edges of the chunk,
+        // it returns false for a wrong line. The edges keep the order of the file.
+        // Returns nullptr for a wrong file or a vertex out of range.
+        template <typename Graph, typename ParseHeader, typename ParseLine>
+        std::unique_ptr<Graph> LoadGraph(const char* fileName, size_t threadsCount,
+            ParseHeader parseHeader, ParseLine parseLine) {
+            using Edge = typename Graph::Builder::Edge;
+            threadsCount = std::max<size_t>(1, threadsCount);
+            MappedFileReader input;
+            if (!input.Open(fileName)) {
+                std::cerr << "File " << fileName << " not found!" << std::endl;
+                return nullptr;
+            }
+            MemoryReader header(input.Data(), input.Data() + input.Size());
+            auto numOfNodes = parseHeader(header);
+            if (numOfNodes == 0) {
+                std::cerr << "Wrong file format" << std::endl;
+                return nullptr;
+            }
+
+            auto bounds = SplitAtLines(header.Position(), input.Data() + input.Size(), threadsCount);
+            std::vector<std::vector<Edge>> edges(threadsCount);
+            std::vector<char> isValid(threadsCount, 1);
+            graphUtil::ParallelFor(0, threadsCount, threadsCount, [&](size_t, size_t begin, size_t end) {
+                for (auto chunk = begin; chunk < end; ++chunk) {
+                    MemoryReader reader(bounds[chunk], bounds[chunk + 1]);
+                    while (reader.HasNext()) {
+                        if (!parseLine(reader, edges[chunk])) {
+                            isValid[chunk] = 0;
+                            break;
+                        }
+                    }
+                    for (const auto& edge : edges[chunk]) {
+                        if (edge.source >= numOfNodes || edge.target >= numOfNodes) isValid[chunk] = 0;
+                    }
+                }
+            });
+            if (std::find(isValid.begin(), isValid.end(), 0) != isValid.end()) {
+                std::cerr << "Wrong file format" << std::endl;
+                return nullptr;
+            }
+
+            typename Graph::Builder builder(numOfNodes);
+            builder.AddEdges(edges, threadsCount);
+            edges.clear();
+            return builder.BuildParallel(threadsCount);
+        }
+
+        // Reads the "d n m" header of a .ddsg file
+        inline size_t ParseDdsgHeader(MemoryReader& reader) {
+            if (reader.NextChar() != 'd') return 0;
+            size_t numOfNodes = reader.NextUnsignedInt();
+            reader.NextUnsignedInt();
+            return numOfNodes;
+        }
+    }
+}
+
+// Parallel version of read_ddsg which builds the graph without the intermediate edges vector
+template <typename Graph, typename EdgeWeightProperty>
+std::unique_ptr<Graph> load_ddsg(const char* fileName,
+    size_t threadsCount = graphUtil::DefaultThreadsCount()) {
+    using WeightTag = typename EdgeWeightProperty::tag_type;
+    using Edge = typename Graph::Builder::Edge;
+    return graphIO::detail::LoadGraph<Graph>(fileName, threadsCount, graphIO::detail::ParseDdsgHeader,
+        [](graphIO::MemoryReader& input, std::vector<Edge>& edges) {
+        auto u = input.NextUnsignedInt();
+        auto v = input.NextUnsignedInt();
+        typename Graph::edge_bundled properties;
+        graph::get<WeightTag>(properties) = input.NextUnsignedInt();
+        switch (input.NextUnsignedInt()) {
+        case 0:
+        case 3:
+            edges.emplace_back(u, v, properties);
+            edges.emplace_back(v, u, properties);
+            return true;
+        case 1:
+            edges.emplace_back(u, v, properties);
+            return true;
+        case 2:
+            edges.emplace_back(v, u, properties);
+            return true;
+        default:
+            return false;
+        }
+    });
+};
+
+// Parallel version of read_ddsg with the direction bits
+template <typename Graph, typename EdgeWeightProperty, typename EdgeDirectionProperty>
+std::unique_ptr<Graph> load_ddsg(const char* fileName,
+    size_t threadsCount = graphUtil::DefaultThreadsCount()) {
+    using WeightTag = typename EdgeWeightProperty::tag_type;
+    using DirectionTag = typename EdgeDirectionProperty::tag_type;
+    using DirectionBit = typename EdgeDirectionProperty::value_type;
+    using Edge = typename Graph::Builder::Edge;
+    return graphIO::detail::LoadGraph<Graph>(fileName, threadsCount, graphIO::detail::ParseDdsgHeader,
+        [](graphIO::MemoryReader& input, std::vector<Edge>& edges) {
+        auto u = input.NextUnsignedInt();
+        auto v = input.NextUnsignedInt();
+        typename Graph::edge_bundled forward, backward;
+        graph::get<WeightTag>(forward) = graph::get<WeightTag>(backward) = input.NextUnsignedInt();
+        switch (input.NextUnsignedInt()) {
+        case 0:
+        case 3:
+            graph::get<DirectionTag>(forward) = graph::get<DirectionTag>(backward) = static_cast<DirectionBit>(0);
+            break;
+        case 1:
+            graph::get<DirectionTag>(forward) = static_cast<DirectionBit>(1);
+            graph::get<DirectionTag>(backward) = static_cast<DirectionBit>(2);
+            break;
+        case 2:
+            graph::get<DirectionTag>(forward) = static_cast<DirectionBit>(2);
+            graph::get<DirectionTag>(backward) = static_cast<DirectionBit>(1);
+            break;
+        default:
+            return false;
+        }
+        edges.emplace_back(u, v, forward);
+        edges.emplace_back(v, u, backward);
+        return true;
+    });
+};
+
+// Loads a DIMACS shortest paths .gr file ("c" comments, "p sp n m" and "a u v w" lines) on several threads.
+// The vertex ids are kept 1-based as in graphOSM::ReadGraphFrom, so the graph has n + 1 vertices.
+template <typename Graph, typename EdgeWeightProperty>
+std::unique_ptr<Graph> load_dimacs(const char* fileName,
+    size_t threadsCount = graphUtil::DefaultThreadsCount()) {
+    using WeightTag = typename EdgeWeightProperty::tag_type;
+    using Edge = typename Graph::Builder::Edge;
+    return graphIO::detail::LoadGraph<Graph>(fileName, threadsCount,
+        [](graphIO::MemoryReader& input) -> size_t {
+        while (char c = input.NextChar()) {
+            if (c == 'p') {
+                input.NextChar();
+                input.NextChar();
+                size_t numOfNodes = input.NextUnsignedInt() + 1;
+                input.NextUnsignedInt();
+                return numOfNodes;
+            }
+            if (c != 'c') return 0;
+            input.ReadLine();
+        }
+        return 0;
+    },
+        [](graphIO::MemoryReader& input, std::vector<Edge>& edges) {
+        switch (input.NextChar()) {
+        case 'a': {
+            auto u = input.NextUnsignedInt();
+            auto v = input.NextUnsignedInt();
+            typename Graph::edge_bundled properties;
+            graph::get<WeightTag>(properties) = input.NextUnsignedInt();
+            edges.emplace_back(u, v, properties);
+            return true;
+        }
+        case 'c':
+            input.ReadLine();
+            return true;
+        default:
+            return false;
+        }
+    });
+};
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <graph/io/IReader.hpp>
+
+#include <cstdint>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define GRAPHIO_SIMD_PARSING
+#endif
+
+namespace graphIO
+{
+	namespace detail {
+		// Token parsing follows FileReader: a token ends at the first byte <= ' ' (signed),
+		// its characters are taken as digits (c & 15)
+		inline uint32_t ParseUnsignedScalar(const char*& position, const char* end) {
+			uint32_t result = 0;
+			while (position != end && *position > ' ')
+				result = result * 10 + (*(position++) & 15);
+			return result;
+		}
+
+#ifdef GRAPHIO_SIMD_PARSING
+		// Shuffle masks moving the first length bytes of a block to its end, the other bytes are zeroed
+		struct AlignRightMasks {
+			alignas(16) int8_t masks[17][16];
+
+			AlignRightMasks() {
+				for (int length = 0; length <= 16; ++length) {
+					for (int i = 0; i < 16; ++i) {
+						int from = i - (16 - length);
+						masks[length][i] = static_cast<int8_t>(from >= 0 ? from : -1);
+					}
+				}
+			}
+		};
+
+		// Parses a token of up to 16 characters from a 16 bytes block: the digits are aligned to the end
+		// of the block and combined pairwise (2, 4, 8 and 16 digits) with multiply-add instructions.
+		// Returns false when the token does not end inside the block.
+		__attribute__((target("sse4.1")))
+		inline bool ParseUnsignedBlock(const char*& position, uint32_t& result) {
+			static const AlignRightMasks alignRight;
+			const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+			const auto separators = static_cast<uint32_t>(
+				_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(' ' + 1), block)));
+			if (separators == 0) return false;
+			const int length = __builtin_ctz(separators);
+
+			__m128i digits = _mm_and_si128(block, _mm_set1_epi8(15));
+			digits = _mm_shuffle_epi8(digits,
+				_mm_load_si128(reinterpret_cast<const __m128i*>(alignRight.masks[length])));
+			const __m128i pairs = _mm_maddubs_epi16(digits, _mm_setr_epi8(
+				10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+			const __m128i quads = _mm_madd_epi16(pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+			const __m128i octs = _mm_madd_epi16(_mm_packus_epi32(quads, quads),
+				_mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+			result = static_cast<uint32_t>(_mm_cvtsi128_si32(octs)) * 100000000u +
+				static_cast<uint32_t>(_mm_extract_epi32(octs, 1));
+			position += length;
+			return true;
+		}
+
+		inline bool HasSimdParsing() {
+			static const bool supported = __builtin_cpu_supports("sse4.1");
+			return supported;
+		}
+#endif
+	}
+
+	// Reader over the characters [begin, end) of a memory block.
+	// NextUnsignedInt parses a whole token at once with SSE4.1 when the CPU supports it.
+	class MemoryReader : public IReader {
+	public:
+		MemoryReader() : position(nullptr), end(nullptr) {}
+
+		MemoryReader(const char* begin, const char* end) : position(begin), end(end) {}
+
+		char NextChar() override {
+			SkipWhitespaces();
+			if (IsEof()) return 0;
+			return *(position++);
+		}
+
+		unsigned int NextUnsignedInt() override {
+			SkipWhitespaces();
+			if (IsEof()) return 0;
+#ifdef GRAPHIO_SIMD_PARSING
+			uint32_t result;
+			// the block must not be read past the end
+			if (end - position >= 16 && detail::HasSimdParsing() && detail::ParseUnsignedBlock(position, result))
+				return result;
+#endif
+			return detail::ParseUnsignedScalar(position, end);
+		}
+
+		std::string ReadLine() override {
+			const char* lineEnd = position;
+			while (lineEnd != end && *lineEnd != '\r' && *lineEnd != '\n')
+				++lineEnd;
+			std::string result(position, lineEnd);
+
+			position = lineEnd;
+			if (position != end && *position == '\r')
+				++position;
+			if (position != end && *position == '\n')
+				++position;
+			return result;
+		}
+
+		bool HasNext() override {
+			const char* current = position;
+			SkipWhitespaces();
+			bool hasNext = !IsEof();
+			position = current;
+			return hasNext;
+		}
+
+		const char* Position() const {
+			return position;
+		}
+
+	protected:
+		bool IsEof() const {
+			return position == end;
+		}
+
+		void SkipWhitespaces() {
+			while (position != end && *position <= ' ')
+				++position;
+		}
+
+		const char* position;
+		const char* end;
+	};
+
+	// Reader over a read-only mapping of the whole file: no copies and no buffer refills
+	class MappedFileReader : public MemoryReader {
+	public:
+		MappedFileReader() : data(nullptr), size(0) {}
+
+		virtual ~MappedFileReader() {
+			Close();
+		}
+
+		MappedFileReader(const MappedFileReader&) = delete;
+		MappedFileReader& operator=(const MappedFileReader&) = delete;
+
+		bool Open(const char* fileName) {
+			Close();
+			int file = open(fileName, O_RDONLY);
+			if (file < 0)
+				return false;
+
+			struct stat fileStat;
+			if (fstat(file, &fileStat) != 0) {
+				close(file);
+				return false;
+			}
+			size = static_cast<size_t>(fileStat.st_size);
+			if (size > 0) {
+				void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+				if (address == MAP_FAILED) {
+					close(file);
+					size = 0;
+					return false;
+				}
+				madvise(address, size, MADV_SEQUENTIAL);
+				data = static_cast<const char*>(address);
+			}
+			close(file);
+			position = data;
+			end = data + size;
+			return true;
+		}
+
+		void Close() {
+			if (data != nullptr)
+				munmap(const_cast<char*>(data), size);
+			data = position = end = nullptr;
+			size = 0;
+		}
+
+		// The mapped file, e.g. to split it between threads
+		const char* Data() const {
+			return data;
+		}
+
+		size_t Size() const {
+			return size;
+		}
+
+	private:
+		const char* data;
+		size_t size;
+	};
+}
@@ -0,0 +1,228 @@
+#pragma once
+#include <graph/dijkstra.hpp>
+#include <graph/queue/SimdDHeapQueue.hpp>
+#include <cstdint>
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <type_traits>
+#include <vector>
+
+namespace graph
+{
+	namespace detail {
+		// One bit per source of a multi source search
+		template <size_t Lanes>
+		using LaneMask = std::conditional_t<Lanes <= 8, uint8_t,
+			std::conditional_t<Lanes <= 16, uint16_t, uint32_t>>;
+
+		template <size_t Lanes>
+		inline uint32_t RelaxLanesScalar(const uint32_t* from, uint32_t* to, uint32_t weight, uint32_t lanes) {
+			uint32_t improved = 0;
+			for (size_t lane = 0; lane < Lanes; ++lane) {
+				if (!(lanes & (1u << lane)) || from[lane] == std::numeric_limits<uint32_t>::max())
+					continue;
+				auto newDistance = from[lane] + weight;
+				if (newDistance < to[lane]) {
+					to[lane] = newDistance;
+					improved |= 1u << lane;
+				}
+			}
+			return improved;
+		}
+
+#ifdef GRAPH_SIMD_HEAP
+		// The lanes of from plus weight, min with the lanes of to, four lanes per SSE4.1 block.
+		// Only the lanes set in lanes are relaxed, the unreached lanes of from keep the maximal distance.
+		template <size_t Lanes>
+		__attribute__((target("sse4.1")))
+		uint32_t RelaxLanesSimd(const uint32_t* from, uint32_t* to, uint32_t weight, uint32_t lanes) {
+			const __m128i infinity = _mm_set1_epi32(-1);
+			const __m128i weights = _mm_set1_epi32(static_cast<int>(weight));
+			const __m128i laneBits = _mm_setr_epi32(1, 2, 4, 8);
+			uint32_t improved = 0;
+			for (size_t block = 0; block < Lanes; block += 4) {
+				const __m128i fromBlock = _mm_load_si128(reinterpret_cast<const __m128i*>(from + block));
+				const __m128i toBlock = _mm_load_si128(reinterpret_cast<const __m128i*>(to + block));
+				const __m128i selected = _mm_cmpeq_epi32(
+					_mm_and_si128(_mm_set1_epi32(static_cast<int>(lanes >> block)), laneBits), laneBits);
+				const __m128i skipped = _mm_or_si128(_mm_cmpeq_epi32(fromBlock, infinity),
+				                                     _mm_andnot_si128(selected, infinity));
+				const __m128i candidate = _mm_or_si128(_mm_add_epi32(fromBlock, weights), skipped);
+				const __m128i minBlock = _mm_min_epu32(toBlock, candidate);
+				_mm_store_si128(reinterpret_cast<__m128i*>(to + block), minBlock);
+				const int changed = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(minBlock, toBlock))) ^ 0xF;
+				improved |= static_cast<uint32_t>(changed) << block;
+			}
+			return improved;
+		}
+#endif
+	}
+
+	// Grows the shortest path trees of up to Lanes sources in one pass over the graph.
+	// Every vertex keeps a vector of Lanes distances, the distances of an edge target are updated
+	// with one SIMD add, min and compare per four lanes. A vertex is queued by the smallest of its
+	// improved distances and relaxes all improved lanes when it is taken, so a lane may be relaxed
+	// again after a later improvement. On the inverted graph the trees are the shortest paths to
+	// the sources, e.g. for arc-flags preprocessing of Lanes boundary vertices at once.
+	template <typename Graph, typename WeightMap, typename IndexMap, size_t Lanes = 8>
+	class MultiSourceDijkstra {
+		static_assert(Lanes % 4 == 0 && Lanes <= 32, "Lanes fill whole SIMD blocks of four distances");
+	public:
+		using Vertex = typename graph_traits<Graph>::vertex_descriptor;
+		using Distance = uint32_t;
+		using Mask = detail::LaneMask<Lanes>;
+		static constexpr size_t LanesCount = Lanes;
+
+		MultiSourceDijkstra(const Graph& graph, const WeightMap& weight, const IndexMap& index)
+			: graph(graph),
+			  weight(weight),
+			  index(index),
+			  distances(num_vertices(graph) * Lanes),
+			  predecessors(num_vertices(graph) * Lanes),
+			  improvedLanes(num_vertices(graph)),
+			  queuedKeys(num_vertices(graph)) {}
+
+		// Lane i grows the tree of sources[i], the lanes past the sources stay unreached
+		void Run(const std::vector<Vertex>& sources) {
+			assert(sources.size() <= Lanes);
+			std::fill(distances.begin(), distances.end(), Infinity);
+			std::fill(improvedLanes.begin(), improvedLanes.end(), 0);
+			std::fill(queuedKeys.begin(), queuedKeys.end(), Infinity);
+			for (const auto& v : graphUtil::Range(vertices(graph))) {
+				auto vIndex = get(index, v);
+				std::fill(predecessors.begin() + vIndex * Lanes, predecessors.begin() + (vIndex + 1) * Lanes, v);
+			}
+			this->sources = sources;
+
+			for (size_t lane = 0; lane < sources.size(); ++lane) {
+				auto sIndex = get(index, sources[lane]);
+				distances[sIndex * Lanes + lane] = 0;
+				improvedLanes[sIndex] |= Mask(1u << lane);
+				if (queuedKeys[sIndex] != 0) {
+					queuedKeys[sIndex] = 0;
+					vertexQueue.push(QueueItem{0, sources[lane]});
+				}
+			}
+#ifdef GRAPH_SIMD_HEAP
+			if (queue::detail::HasSimdHeap()) {
+				Search([](const Distance* from, Distance* to, Distance edgeWeight, uint32_t lanes) {
+					return detail::RelaxLanesSimd<Lanes>(from, to, edgeWeight, lanes);
+				});
+				return;
+			}
+#endif
+			Search([](const Distance* from, Distance* to, Distance edgeWeight, uint32_t lanes) {
+				return detail::RelaxLanesScalar<Lanes>(from, to, edgeWeight, lanes);
+			});
+		}
+
+		const std::vector<Vertex>& Sources() const {
+			return sources;
+		}
+
+		Distance GetDistance(const Vertex& v, size_t lane) const {
+			return distances[get(index, v) * Lanes + lane];
+		}
+
+		// v itself for the source of the lane and for the vertices it does not reach
+		Vertex GetPredecessor(const Vertex& v, size_t lane) const {
+			return predecessors[get(index, v) * Lanes + lane];
+		}
+
+		// Calls function(edge, mask) for every edge on a shortest path tree of the last Run,
+		// bit i of the mask is set when the edge leads to its target in the tree of sources[i].
+		// Of parallel edges as light as the tree edge only the first one is in the tree, the out edges
+		// come sorted by the target
+		template <typename Function>
+		void ForEachTreeEdge(Function&& function) const {
+			for (const auto& v : graphUtil::Range(vertices(graph))) {
+				auto vIndex = get(index, v);
+				Vertex previousTarget = v;
+				Mask reached = 0;
+				for (const auto& edge : graphUtil::Range(out_edges(v, graph))) {
+					auto to = target(edge, graph);
+					if (to == v)
+						continue;
+					if (to != previousTarget)
+						reached = 0;
+					previousTarget = to;
+					auto toIndex = get(index, to);
+					auto edgeWeight = get(weight, edge);
+					Mask mask = 0;
+					for (size_t lane = 0; lane < sources.size(); ++lane) {
+						if (predecessors[toIndex * Lanes + lane] == v &&
+							distances[vIndex * Lanes + lane] + edgeWeight == distances[toIndex * Lanes + lane])
+							mask |= Mask(1u << lane);
+					}
+					mask &= ~reached;
+					reached |= mask;
+					if (mask != 0)
+						function(edge, mask);
+				}
+			}
+		}
+
+	private:
+		static constexpr Distance Infinity = std::numeric_limits<Distance>::max();
+
+		struct QueueItem {
+			Distance Key;
+			Vertex V;
+
+			friend bool operator>(const QueueItem& lhs, const QueueItem& rhs) {
+				return lhs.Key > rhs.Key;
+			}
+		};
+
+		template <typename RelaxLanes>
+		void Search(RelaxLanes relaxLanes) {
+			while (!vertexQueue.empty()) {
+				auto item = vertexQueue.top();
+				vertexQueue.pop();
+				auto vIndex = get(index, item.V);
+				// the vertex was taken with a smaller key already
+				if (queuedKeys[vIndex] != item.Key)
+					continue;
+				queuedKeys[vIndex] = Infinity;
+				uint32_t lanes = improvedLanes[vIndex];
+				improvedLanes[vIndex] = 0;
+				const Distance* from = &distances[vIndex * Lanes];
+
+				for (const auto& edge : graphUtil::Range(out_edges(item.V, graph))) {
+					auto to = target(edge, graph);
+					auto toIndex = get(index, to);
+					Distance* toDistances = &distances[toIndex * Lanes];
+					uint32_t improved = relaxLanes(from, toDistances, get(weight, edge), lanes);
+					if (improved == 0)
+						continue;
+					improvedLanes[toIndex] |= Mask(improved);
+					Distance key = Infinity;
+					for (uint32_t bits = improved; bits != 0; bits &= bits - 1) {
+						auto lane = __builtin_ctz(bits);
+						predecessors[toIndex * Lanes + lane] = item.V;
+						key = std::min(key, toDistances[lane]);
+					}
+					if (key < queuedKeys[toIndex]) {
+						queuedKeys[toIndex] = key;
+						vertexQueue.push(QueueItem{key, to});
+					}
+				}
+			}
+		}
+
+		const Graph& graph;
+		WeightMap weight;
+		IndexMap index;
+		std::vector<Vertex> sources;
+		// Lanes distances per vertex, every vertex starts an aligned block
+		std::vector<Distance, queue::detail::AlignedAllocator<Distance, 64>> distances;
+		std::vector<Vertex> predecessors;
+		// the lanes improved since the vertex was last taken from the queue
+		std::vector<Mask> improvedLanes;
+		// the key the vertex waits in the queue with, Infinity when it is not queued
+		std::vector<Distance> queuedKeys;
+		std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> vertexQueue;
+	};
+}
@@ -0,0 +1,159 @@
+#pragma once
+#include <cinttypes>
+#include <cassert>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include <graph/properties.hpp>
+
+namespace graph
+{
+	namespace queue
+	{
+		// Dial's bucket queue with the contract of DijkstraQueue for integer keys: a circular array
+		// with one bucket per key, the queued keys lie in [last minimum, last minimum + max edge weight],
+		// so they never share a bucket when the array is longer than the maximal weight.
+		// SetMaxKeyDelta sizes the array for the weights of the graph, a longer key range grows it.
+		// DeleteMin scans the buckets forward, a search costs O(m + D) bucket
+		// visits for the largest distance D. DecreaseKey inserts the vertex again, the outdated items
+		// are dropped on the scan. Items cannot be reinserted, the search starts from the key 0.
+		template <typename DistanceType, typename VertexType, typename IndexMap>
+		class BucketQueue {
+			static_assert(std::is_unsigned<DistanceType>::value, "Bucket queue needs unsigned keys");
+		private:
+			using IndexType = typename IndexMap::value_type;
+			using IterationIdType = uint32_t;
+
+		public:
+			struct BucketQueueItem {
+				DistanceType Distance;
+				IndexType VertexIndex;
+				VertexType Vertex;
+
+				BucketQueueItem(const DistanceType& distance, const IndexType& index, const VertexType& vertex)
+					:Distance(distance),
+					 VertexIndex(index),
+					 Vertex(vertex) {}
+			};
+
+		private:
+			// PeekMin moves the last minimum to the found bucket, the buckets before it are empty
+			mutable std::vector<std::vector<BucketQueueItem>> buckets;
+			mutable DistanceType last;
+			DistanceType mask;
+			std::vector<DistanceType> keys;
+			std::vector<IterationIdType> isDeleted;
+			IterationIdType iterationId;
+			size_t itemsCount;
+
+			bool IsOutdated(const BucketQueueItem& item) const {
+				return isDeleted[item.VertexIndex] == iterationId || keys[item.VertexIndex] != item.Distance;
+			}
+
+			std::vector<BucketQueueItem>& BucketOf(const DistanceType& key) const {
+				return buckets[key & mask];
+			}
+
+			// Power of two buckets for the keys in [last, last + keyDelta]
+			void Grow(const DistanceType& keyDelta) {
+				size_t bucketsCount = buckets.size();
+				while (bucketsCount <= keyDelta)
+					bucketsCount *= 2;
+				if (bucketsCount == buckets.size())
+					return;
+
+				std::vector<std::vector<BucketQueueItem>> oldBuckets(bucketsCount);
+				std::swap(buckets, oldBuckets);
+				mask = static_cast<DistanceType>(bucketsCount - 1);
+				for (const auto& bucket : oldBuckets) {
+					for (const auto& item : bucket) {
+						if (!IsOutdated(item))
+							BucketOf(item.Distance).push_back(item);
+					}
+				}
+			}
+
+			// Brings the minimum to the back of the bucket of last
+			void FindMin() const {
+				while (true) {
+					auto& bucket = BucketOf(last);
+					while (!bucket.empty() && IsOutdated(bucket.back()))
+						bucket.pop_back();
+					if (!bucket.empty())
+						return;
+					++last;
+				}
+			}
+
+		public:
+			explicit BucketQueue(int dataIdSize = 0)
+				: buckets(1),
+				  last(0),
+				  mask(0),
+				  iterationId(1),
+				  itemsCount(0) {
+				Resize(dataIdSize);
+			}
+
+			void Resize(int dataIdSize) {
+				isDeleted.resize(dataIdSize, 0);
+				keys.resize(dataIdSize);
+			}
+
+			// The largest difference of the queued keys, the maximal edge weight for Dijkstra
+			void SetMaxKeyDelta(const DistanceType& maxKeyDelta) {
+				Grow(maxKeyDelta);
+			}
+
+			void Clear() {
+				if (iterationId == std::numeric_limits<IterationIdType>::max()) {
+					iterationId = 0;
+					isDeleted.assign(isDeleted.size(), 0);
+				}
+				++iterationId;
+				// the buckets keep their capacity for the next search
+				for (auto& bucket : buckets)
+					bucket.clear();
+				last = 0;
+				itemsCount = 0;
+			}
+
+			void Insert(const DistanceType& key, const VertexType& vertex, const IndexMap& index) {
+				auto vertexIndex = get(index, vertex);
+				assert(isDeleted[vertexIndex] < iterationId);
+				assert(key >= last);
+				Grow(key - last);
+				keys[vertexIndex] = key;
+				BucketOf(key).push_back(BucketQueueItem(key, vertexIndex, vertex));
+				++itemsCount;
+			}
+
+			const BucketQueueItem& PeekMin() const {
+				assert(!this->IsEmpty());
+				FindMin();
+				return BucketOf(last).back();
+			}
+
+			void DeleteMin() {
+				assert(!this->IsEmpty());
+				FindMin();
+				auto& bucket = BucketOf(last);
+				isDeleted[bucket.back().VertexIndex] = iterationId;
+				bucket.pop_back();
+				--itemsCount;
+			}
+
+			void DecreaseKey(const DistanceType& newKey, const VertexType& vertex, const IndexMap& index) {
+				auto vertexIndex = get(index, vertex);
+				assert(newKey < keys[vertexIndex]);
+				assert(newKey >= last);
+				keys[vertexIndex] = newKey;
+				BucketOf(newKey).push_back(BucketQueueItem(newKey, vertexIndex, vertex));
+			}
+
+			bool IsEmpty() const {
+				return itemsCount == 0;
+			}
+		};
+	}
+}
@@ -0,0 +1,185 @@
+#pragma once
+#include <graph/queue/DijkstraQueue.hpp>
+#include <graph/queue/RadixHeapQueue.hpp>
+#include <graph/queue/BucketQueue.hpp>
+#include <graph/queue/SimdDHeapQueue.hpp>
+#include <graph/queue/HeapQueue.hpp>
+#include <graph/queue/D-aryHeapQueue.hpp>
+#include <graph/queue/FibonacciHeapQueue.hpp>
+#include <graph/queue/SegmentTreeQueue.hpp>
+#include <graph/queue/SetQueue.hpp>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace graph
+{
+	namespace queue
+	{
+		// Gives a queue of (key, data id) items the contract of DijkstraQueue: the items are vertices
+		// addressed through the index map and DecreaseKey takes the new key only.
+		// Policy::Create<Key, DataId>(size) makes the underlying queue for size data ids.
+		template <typename DistanceType, typename VertexType, typename IndexMap, typename Policy>
+		class IndexedQueueAdapter {
+		private:
+			using IndexType = typename IndexMap::value_type;
+			using QueueType = decltype(Policy::template Create<DistanceType, IndexType>(0));
+
+		public:
+			struct IndexedQueueItem {
+				DistanceType Distance;
+				IndexType VertexIndex;
+				VertexType Vertex;
+
+				IndexedQueueItem(const DistanceType& distance, const IndexType& index, const VertexType& vertex)
+					:Distance(distance),
+					 VertexIndex(index),
+					 Vertex(vertex) {}
+			};
+
+		private:
+			std::unique_ptr<QueueType> q;
+			std::vector<DistanceType> keys;
+			std::vector<VertexType> vertices;
+			int size;
+			// the underlying queues return their own items, PeekMin converts the minimum
+			mutable IndexedQueueItem minItem;
+
+		public:
+			explicit IndexedQueueAdapter(int dataIdSize = 0)
+				: size(-1),
+				  minItem(DistanceType(), IndexType(), VertexType()) {
+				Resize(dataIdSize);
+			}
+
+			void Resize(int dataIdSize) {
+				if (dataIdSize == size)
+					return;
+				size = dataIdSize;
+				q.reset(new QueueType(Policy::template Create<DistanceType, IndexType>(std::max(1, dataIdSize))));
+				keys.resize(dataIdSize);
+				vertices.resize(dataIdSize);
+			}
+
+			// the queues have no reset, the items left by a stopped search are deleted one by one
+			void Clear() {
+				while (!q->IsEmpty())
+					q->DeleteMin();
+			}
+
+			void Insert(const DistanceType& key, const VertexType& vertex, const IndexMap& index) {
+				IndexType vertexIndex = get(index, vertex);
+				keys[vertexIndex] = key;
+				vertices[vertexIndex] = vertex;
+				q->Insert(key, vertexIndex);
+			}
+
+			const IndexedQueueItem& PeekMin() const {
+				assert(!this->IsEmpty());
+				auto item = q->PeekMin();
+				minItem = IndexedQueueItem(item.Key(), item.Data(), vertices[item.Data()]);
+				return minItem;
+			}
+
+			void DeleteMin() {
+				assert(!this->IsEmpty());
+				q->DeleteMin();
+			}
+
+			void DecreaseKey(const DistanceType& newKey, const VertexType& vertex, const IndexMap& index) {
+				IndexType vertexIndex = get(index, vertex);
+				q->DecreaseKey(keys[vertexIndex], vertexIndex, newKey);
+				keys[vertexIndex] = newKey;
+			}
+
+			bool IsEmpty() const {
+				return q->IsEmpty();
+			}
+		};
+
+		// Queue policies of DefaultDijkstraVisitor: Policy::QueueType<Distance, Vertex, IndexMap>
+		// has the contract of DijkstraQueue
+		struct DijkstraQueuePolicy {
+			template <typename DistanceType, typename VertexType, typename IndexMap>
+			using QueueType = DijkstraQueue<DistanceType, VertexType, IndexMap>;
+		};
+
+		struct RadixHeapQueuePolicy {
+			template <typename DistanceType, typename VertexType, typename IndexMap>
+			using QueueType = RadixHeapQueue<DistanceType, VertexType, IndexMap>;
+		};
+
+		struct BucketQueuePolicy {
+			template <typename DistanceType, typename VertexType, typename IndexMap>
+			using QueueType = BucketQueue<DistanceType, VertexType, IndexMap>;
+		};
+
+		template <int Arity = 4>
+		struct SimdDHeapQueuePolicy {
+			template <typename DistanceType, typename VertexType, typename IndexMap>
+			using QueueType = SimdDHeapQueue<DistanceType, VertexType, IndexMap, Arity>;
+		};
+
+		struct HeapQueuePolicy {
+			template <typename DistanceType, typename VertexType, typename IndexMap>
+			using QueueType = IndexedQueueAdapter<DistanceType, VertexType, IndexMap, HeapQueuePolicy>;
+
+			template <typename TKey, typename TDataId>
+			static HeapQueue<TKey, TDataId> Create(int dataIdSize) {
+				return HeapQueue<TKey, TDataId>(dataIdSize);
+			}
+		};
+
+		template <int D = 4>
+		struct DHeapQueuePolicy {
+			template <typename DistanceType, typename VertexType, typename IndexMap>
+			using QueueType = IndexedQueueAdapter<DistanceType, VertexType, IndexMap, DHeapQueuePolicy>;
+
+			template <typename TKey, typename TDataId>
+			static DHeapQueue<TKey, TDataId> Create(int dataIdSize) {
+				return DHeapQueue<TKey, TDataId>(dataIdSize, D);
+			}
+		};
+
+		struct FibonacciHeapQueuePolicy {
+			template <typename DistanceType, typename VertexType, typename IndexMap>
+			using QueueType = IndexedQueueAdapter<DistanceType, VertexType, IndexMap, FibonacciHeapQueuePolicy>;
+
+			template <typename TKey, typename TDataId>
+			static FibonacciHeapQueue<TKey, TDataId> Create(int dataIdSize) {
+				return FibonacciHeapQueue<TKey, TDataId>(dataIdSize);
+			}
+		};
+
+		struct SegmentTreeQueuePolicy {
+			template <typename DistanceType, typename VertexType, typename IndexMap>
+			using QueueType = IndexedQueueAdapter<DistanceType, VertexType, IndexMap, SegmentTreeQueuePolicy>;
+
+			template <typename TKey, typename TDataId>
+			static SegmentTreeQueue<TKey, TDataId> Create(int dataIdSize) {
+				return SegmentTreeQueue<TKey, TDataId>(dataIdSize);
+			}
+		};
+
+		template <int N = 4>
+		struct NarySegmentTreeQueuePolicy {
+			template <typename DistanceType, typename VertexType, typename IndexMap>
+			using QueueType = IndexedQueueAdapter<DistanceType, VertexType, IndexMap, NarySegmentTreeQueuePolicy>;
+
+			template <typename TKey, typename TDataId>
+			static NarySegmentTreeQueue<TKey, TDataId, N> Create(int dataIdSize) {
+				return NarySegmentTreeQueue<TKey, TDataId, N>(dataIdSize);
+			}
+		};
+
+		struct SetQueuePolicy {
+			template <typename DistanceType, typename VertexType, typename IndexMap>
+			using QueueType = IndexedQueueAdapter<DistanceType, VertexType, IndexMap, SetQueuePolicy>;
+
+			template <typename TKey, typename TDataId>
+			static SetQueue<TKey, TDataId> Create(int) {
+				return SetQueue<TKey, TDataId>();
+			}
+		};
+	}
+}
@@ -0,0 +1,157 @@
+#pragma once
+#include <cinttypes>
+#include <cassert>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include <graph/properties.hpp>
+
+namespace graph
+{
+	namespace queue
+	{
+		// Monotone queue with the contract of DijkstraQueue: the inserted keys are never smaller than
+		// the key of the last deleted minimum, which holds for Dijkstra with non-negative weights.
+		// Items are kept in buckets by the highest bit in which their key differs from the last minimum,
+		// an item moves to a lower bucket at most once per bit, so DeleteMin is amortized O(log C).
+		// DecreaseKey inserts the vertex again, the outdated items are dropped when their bucket is split.
+		// Items cannot be reinserted.
+		template <typename DistanceType, typename VertexType, typename IndexMap>
+		class RadixHeapQueue {
+			static_assert(std::is_unsigned<DistanceType>::value, "Radix heap needs unsigned keys");
+		private:
+			using IndexType = typename IndexMap::value_type;
+			using IterationIdType = uint32_t;
+			static constexpr size_t BucketsCount = std::numeric_limits<DistanceType>::digits + 1;
+
+		public:
+			struct RadixHeapQueueItem {
+				DistanceType Distance;
+				IndexType VertexIndex;
+				VertexType Vertex;
+
+				RadixHeapQueueItem(const DistanceType& distance, const IndexType& index, const VertexType& vertex)
+					:Distance(distance),
+					 VertexIndex(index),
+					 Vertex(vertex) {}
+			};
+
+		private:
+			// PeekMin splits the buckets on demand, a DeleteMin must not move the last minimum
+			// before the edges of the deleted vertex are relaxed
+			mutable std::vector<RadixHeapQueueItem> buckets[BucketsCount];
+			mutable DistanceType last;
+			std::vector<DistanceType> keys;
+			std::vector<IterationIdType> isDeleted;
+			IterationIdType iterationId;
+			size_t itemsCount;
+
+			size_t BucketIndex(const DistanceType& key) const {
+				return key == last ? 0 : std::numeric_limits<unsigned long long>::digits -
+					__builtin_clzll(static_cast<unsigned long long>(key ^ last));
+			}
+
+			bool IsOutdated(const RadixHeapQueueItem& item) const {
+				return isDeleted[item.VertexIndex] == iterationId || keys[item.VertexIndex] != item.Distance;
+			}
+
+			// Brings the minimum to the bucket 0
+			void SplitBuckets() const {
+				auto& first = buckets[0];
+				while (true) {
+					while (!first.empty() && IsOutdated(first.back()))
+						first.pop_back();
+					if (!first.empty())
+						return;
+
+					size_t bucketIndex = 1;
+					while (bucketIndex < BucketsCount && buckets[bucketIndex].empty())
+						++bucketIndex;
+					if (bucketIndex == BucketsCount)
+						return;
+
+					auto& bucket = buckets[bucketIndex];
+					auto minKey = std::numeric_limits<DistanceType>::max();
+					bool anyItem = false;
+					for (const auto& item : bucket) {
+						if (IsOutdated(item))
+							continue;
+						anyItem = true;
+						if (item.Distance < minKey)
+							minKey = item.Distance;
+					}
+					if (anyItem) {
+						// the items differ from the new minimum in lower bits only
+						last = minKey;
+						for (const auto& item : bucket) {
+							if (!IsOutdated(item))
+								buckets[BucketIndex(item.Distance)].push_back(item);
+						}
+					}
+					bucket.clear();
+				}
+			}
+
+		public:
+			explicit RadixHeapQueue(int dataIdSize = 0) {
+				iterationId = 1;
+				last = 0;
+				itemsCount = 0;
+				Resize(dataIdSize);
+			}
+
+			void Resize(int dataIdSize) {
+				isDeleted.resize(dataIdSize, 0);
+				keys.resize(dataIdSize);
+			}
+
+			void Clear() {
+				if (iterationId == std::numeric_limits<IterationIdType>::max()) {
+					iterationId = 0;
+					isDeleted.assign(isDeleted.size(), 0);
+				}
+				++iterationId;
+				// the buckets keep their capacity for the next search
+				for (auto& bucket : buckets)
+					bucket.clear();
+				last = 0;
+				itemsCount = 0;
+			}
+
+			void Insert(const DistanceType& key, const VertexType& vertex, const IndexMap& index) {
+				auto vertexIndex = get(index, vertex);
+				assert(isDeleted[vertexIndex] < iterationId);
+				assert(key >= last);
+				keys[vertexIndex] = key;
+				buckets[BucketIndex(key)].push_back(RadixHeapQueueItem(key, vertexIndex, vertex));
+				++itemsCount;
+			}
+
+			const RadixHeapQueueItem& PeekMin() const {
+				assert(!this->IsEmpty());
+				SplitBuckets();
+				return buckets[0].back();
+			}
+
+			void DeleteMin() {
+				assert(!this->IsEmpty());
+				SplitBuckets();
+				isDeleted[buckets[0].back().VertexIndex] = iterationId;
+				buckets[0].pop_back();
+				--itemsCount;
+			}
+
+			void DecreaseKey(const DistanceType& newKey, const VertexType& vertex, const IndexMap& index) {
+				auto vertexIndex = get(index, vertex);
+				assert(newKey < keys[vertexIndex]);
+				assert(newKey >= last);
+				keys[vertexIndex] = newKey;
+				buckets[BucketIndex(newKey)].push_back(RadixHeapQueueItem(newKey, vertexIndex, vertex));
+			}
+
+			bool IsEmpty() const {
+				return itemsCount == 0;
+			}
+		};
+	}
+}
@@ -0,0 +1,271 @@
+#pragma once
+#include <cinttypes>
+#include <cassert>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include <graph/properties.hpp>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define GRAPH_SIMD_HEAP
+#endif
+
+namespace graph
+{
+	namespace queue
+	{
+		namespace detail {
+			template <typename T, size_t Alignment>
+			struct AlignedAllocator {
+				using value_type = T;
+
+				template <typename U>
+				struct rebind {
+					using other = AlignedAllocator<U, Alignment>;
+				};
+
+				AlignedAllocator() = default;
+
+				template <typename U>
+				AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+				T* allocate(size_t n) {
+					void* memory = nullptr;
+					if (posix_memalign(&memory, Alignment, n * sizeof(T)) != 0)
+						throw std::bad_alloc();
+					return static_cast<T*>(memory);
+				}
+
+				void deallocate(T* memory, size_t) {
+					free(memory);
+				}
+
+				template <typename U>
+				bool operator==(const AlignedAllocator<U, Alignment>&) const {
+					return true;
+				}
+
+				template <typename U>
+				bool operator!=(const AlignedAllocator<U, Alignment>&) const {
+					return false;
+				}
+			};
+
+			template <int Arity, typename Key>
+			inline int MinPositionScalar(const Key* keys) {
+				int position = 0;
+				for (int i = 1; i < Arity; ++i) {
+					if (keys[i] < keys[position])
+						position = i;
+				}
+				return position;
+			}
+
+#ifdef GRAPH_SIMD_HEAP
+			// Minimum of the four keys in every lane
+			__attribute__((target("sse4.1")))
+			inline __m128i HorizontalMin(__m128i block) {
+				block = _mm_min_epu32(block, _mm_shuffle_epi32(block, _MM_SHUFFLE(1, 0, 3, 2)));
+				return _mm_min_epu32(block, _mm_shuffle_epi32(block, _MM_SHUFFLE(2, 3, 0, 1)));
+			}
+
+			template <int Arity>
+			struct SimdMinPosition;
+
+			template <>
+			struct SimdMinPosition<4> {
+				__attribute__((target("sse4.1")))
+				static int Find(const uint32_t* keys) {
+					const __m128i block = _mm_load_si128(reinterpret_cast<const __m128i*>(keys));
+					const __m128i min = HorizontalMin(block);
+					return __builtin_ctz(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, min))));
+				}
+			};
+
+			template <>
+			struct SimdMinPosition<8> {
+				__attribute__((target("sse4.1")))
+				static int Find(const uint32_t* keys) {
+					const __m128i low = _mm_load_si128(reinterpret_cast<const __m128i*>(keys));
+					const __m128i high = _mm_load_si128(reinterpret_cast<const __m128i*>(keys + 4));
+					const __m128i min = HorizontalMin(_mm_min_epu32(low, high));
+					const int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(low, min))) |
+						(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(high, min))) << 4);
+					return __builtin_ctz(mask);
+				}
+			};
+
+			inline bool HasSimdHeap() {
+				static const bool supported = __builtin_cpu_supports("sse4.1");
+				return supported;
+			}
+#endif
+		}
+
+		// D-ary heap with the contract of DijkstraQueue and the arity fixed at compile time.
+		// The keys are kept apart from the items in an aligned array where the children of a node
+		// fill one aligned block, so with 4 or 8 children of uint32_t keys the minimum child is found
+		// with one SSE4.1 compare and reduce. The free slots hold the maximal key.
+		// Every vertex has its position in the heap, DecreaseKey moves the item up in place.
+		template <typename DistanceType, typename VertexType, typename IndexMap, int Arity = 4>
+		class SimdDHeapQueue {
+			static_assert(Arity == 4 || Arity == 8, "Arity of 4 or 8 children fits the SIMD blocks");
+		private:
+			using IndexType = typename IndexMap::value_type;
+			static constexpr size_t KeysAlignment = Arity * sizeof(DistanceType) < 16 ? 16 : Arity * sizeof(DistanceType);
+
+		public:
+			struct SimdDHeapQueueItem {
+				DistanceType Distance;
+				IndexType VertexIndex;
+				VertexType Vertex;
+
+				SimdDHeapQueueItem() = default;
+
+				SimdDHeapQueueItem(const DistanceType& distance, const IndexType& index, const VertexType& vertex)
+					:Distance(distance),
+					 VertexIndex(index),
+					 Vertex(vertex) {}
+			};
+
+		private:
+			// the node p has the key slot p + Arity - 1, so its children start at the slot Arity * (p + 1)
+			std::vector<DistanceType, detail::AlignedAllocator<DistanceType, KeysAlignment>> keys;
+			std::vector<SimdDHeapQueueItem> items;
+			std::vector<int> positions;
+			int size;
+			bool useSimd;
+
+			static size_t Slot(int node) {
+				return node + Arity - 1;
+			}
+
+			static DistanceType FreeKey() {
+				return std::numeric_limits<DistanceType>::max();
+			}
+
+			void Place(int node, const SimdDHeapQueueItem& item) {
+				items[node] = item;
+				keys[Slot(node)] = item.Distance;
+				positions[item.VertexIndex] = node;
+			}
+
+			void SiftUp(int node, const SimdDHeapQueueItem& item) {
+				while (node > 0) {
+					int parent = (node - 1) / Arity;
+					if (!(item.Distance < keys[Slot(parent)]))
+						break;
+					Place(node, items[parent]);
+					node = parent;
+				}
+				Place(node, item);
+			}
+
+			void SiftDownScalar(int node, const SimdDHeapQueueItem& item) {
+				while (true) {
+					int firstChild = Arity * node + 1;
+					if (firstChild >= size)
+						break;
+					int child = firstChild + detail::MinPositionScalar<Arity>(&keys[Slot(firstChild)]);
+					if (!(keys[Slot(child)] < item.Distance))
+						break;
+					Place(node, items[child]);
+					node = child;
+				}
+				Place(node, item);
+			}
+
+#ifdef GRAPH_SIMD_HEAP
+			// the whole loop is compiled for SSE4.1, so the minimum search is inlined into it
+			__attribute__((target("sse4.1")))
+			void SiftDownSimd(int node, const SimdDHeapQueueItem& item) {
+				while (true) {
+					int firstChild = Arity * node + 1;
+					if (firstChild >= size)
+						break;
+					int child = firstChild + detail::SimdMinPosition<Arity>::Find(&keys[Slot(firstChild)]);
+					if (!(keys[Slot(child)] < item.Distance))
+						break;
+					Place(node, items[child]);
+					node = child;
+				}
+				Place(node, item);
+			}
+
+			void SiftDown(int node, const SimdDHeapQueueItem& item, std::true_type) {
+				if (useSimd)
+					SiftDownSimd(node, item);
+				else
+					SiftDownScalar(node, item);
+			}
+#endif
+
+			void SiftDown(int node, const SimdDHeapQueueItem& item, std::false_type) {
+				SiftDownScalar(node, item);
+			}
+
+		public:
+			explicit SimdDHeapQueue(int dataIdSize = 0)
+				: size(0),
+				  useSimd(false) {
+#ifdef GRAPH_SIMD_HEAP
+				useSimd = std::is_same<DistanceType, uint32_t>::value && detail::HasSimdHeap();
+#endif
+				Resize(dataIdSize);
+			}
+
+			void Resize(int dataIdSize) {
+				if (static_cast<size_t>(dataIdSize) == positions.size())
+					return;
+				// the children block of the last node may reach Arity slots past it
+				keys.assign(dataIdSize + 2 * Arity, FreeKey());
+				items.resize(dataIdSize);
+				positions.resize(dataIdSize);
+				size = 0;
+			}
+
+			void Clear() {
+				for (int node = 0; node < size; ++node)
+					keys[Slot(node)] = FreeKey();
+				size = 0;
+			}
+
+			void Insert(const DistanceType& key, const VertexType& vertex, const IndexMap& index) {
+				assert(size < static_cast<int>(items.size()));
+				SiftUp(size++, SimdDHeapQueueItem(key, get(index, vertex), vertex));
+			}
+
+			const SimdDHeapQueueItem& PeekMin() const {
+				assert(!this->IsEmpty());
+				return items[0];
+			}
+
+			void DeleteMin() {
+				assert(!this->IsEmpty());
+				--size;
+				SimdDHeapQueueItem last = items[size];
+				keys[Slot(size)] = FreeKey();
+				if (size == 0)
+					return;
+#ifdef GRAPH_SIMD_HEAP
+				SiftDown(0, last, std::integral_constant<bool, std::is_same<DistanceType, uint32_t>::value>());
+#else
+				SiftDown(0, last, std::false_type());
+#endif
+			}
+
+			void DecreaseKey(const DistanceType& newKey, const VertexType& vertex, const IndexMap& index) {
+				int node = positions[get(index, vertex)];
+				assert(newKey < items[node].Distance);
+				SiftUp(node, SimdDHeapQueueItem(newKey, items[node].VertexIndex, vertex));
+			}
+
+			bool IsEmpty() const {
+				return size == 0;
+			}
+		};
+	}
+}
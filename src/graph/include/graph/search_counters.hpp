@@ -0,0 +1,153 @@
+#pragma once
+#include <graph/dijkstra.hpp>
+#include <cstdint>
+#include <utility>
+
+namespace graph
+{
+	// The work of the searches a CountingDijkstraVisitor has seen, summed up until Reset:
+	// settled vertices, edges relaxed (examined and allowed by should_relax), queue inserts,
+	// decrease-keys and edges pruned by should_relax
+	struct SearchCounters {
+		uint64_t SettledVertices = 0;
+		uint64_t RelaxedEdges = 0;
+		uint64_t QueueInserts = 0;
+		uint64_t DecreaseKeys = 0;
+		uint64_t PrunedEdges = 0;
+
+		void Reset() {
+			*this = SearchCounters();
+		}
+
+		// e.g. the forward and the backward search of a bidirectional query
+		SearchCounters& operator+=(const SearchCounters& other) {
+			SettledVertices += other.SettledVertices;
+			RelaxedEdges += other.RelaxedEdges;
+			QueueInserts += other.QueueInserts;
+			DecreaseKeys += other.DecreaseKeys;
+			PrunedEdges += other.PrunedEdges;
+			return *this;
+		}
+
+		void Settle() {
+			++SettledVertices;
+		}
+
+		void Relax() {
+			++RelaxedEdges;
+		}
+
+		void Insert() {
+			++QueueInserts;
+		}
+
+		void DecreaseKey() {
+			++DecreaseKeys;
+		}
+
+		void Prune() {
+			++PrunedEdges;
+		}
+	};
+
+	// Counts nothing: an empty type whose counters are constant zeros,
+	// CountingDijkstraVisitor with it is the visitor it wraps (see the specialization below)
+	struct NoSearchCounters {
+		static constexpr uint64_t SettledVertices = 0;
+		static constexpr uint64_t RelaxedEdges = 0;
+		static constexpr uint64_t QueueInserts = 0;
+		static constexpr uint64_t DecreaseKeys = 0;
+		static constexpr uint64_t PrunedEdges = 0;
+
+		void Reset() {}
+
+		template <typename Other>
+		NoSearchCounters& operator+=(const Other&) {
+			return *this;
+		}
+
+		void Settle() {}
+
+		void Relax() {}
+
+		void Insert() {}
+
+		void DecreaseKey() {}
+
+		void Prune() {}
+	};
+
+	// Counts the work of the search on top of Visitor, the hooks of Visitor are called as before.
+	// Wrap the visitor that prunes to count the pruned edges: e.g. the main visitor of a
+	// DijkstraVisitorCombinator, or the visitors of bidirectional_dijkstra. As the additional visitor
+	// of a combinator it counts everything but the edges the main visitor prunes.
+	// A vertex is inserted into the queue right after discover_vertex, so the relaxation that
+	// follows a discovery is the insert and any other successful relaxation is a decrease-key.
+	template <typename Graph, typename Visitor = DefaultDijkstraVisitor<Graph>, typename Counters = SearchCounters>
+	class CountingDijkstraVisitor : public Visitor {
+	public:
+		template <typename... Args>
+		explicit CountingDijkstraVisitor(Args&&... args)
+			: Visitor(std::forward<Args>(args)...),
+			  counters(),
+			  discovered(false) {}
+
+		const Counters& GetCounters() const {
+			return counters;
+		}
+
+		Counters& GetCounters() {
+			return counters;
+		}
+
+		template <typename G>
+		void examine_vertex(const typename graph_traits<Graph>::vertex_descriptor& v, G& g) {
+			counters.Settle();
+			// the start vertex is discovered without a relaxation
+			discovered = false;
+			Visitor::examine_vertex(v, g);
+		}
+
+		template <typename G>
+		void discover_vertex(const typename graph_traits<Graph>::vertex_descriptor& v, G& g) {
+			counters.Insert();
+			discovered = true;
+			Visitor::discover_vertex(v, g);
+		}
+
+		template <typename G>
+		void edge_relaxed(const typename graph_traits<Graph>::edge_descriptor& e, G& g) {
+			if (!discovered)
+				counters.DecreaseKey();
+			discovered = false;
+			Visitor::edge_relaxed(e, g);
+		}
+
+		template <typename G>
+		bool should_relax(const typename graph_traits<Graph>::edge_descriptor& e, G& g) {
+			if (!Visitor::should_relax(e, g)) {
+				counters.Prune();
+				return false;
+			}
+			counters.Relax();
+			return true;
+		}
+
+	private:
+		Counters counters;
+		bool discovered;
+	};
+
+	// Disabled counting: no state and no hooks of its own, only the hooks of Visitor run
+	template <typename Graph, typename Visitor>
+	class CountingDijkstraVisitor<Graph, Visitor, NoSearchCounters> : public Visitor {
+	public:
+		template <typename... Args>
+		explicit CountingDijkstraVisitor(Args&&... args)
+			: Visitor(std::forward<Args>(args)...) {}
+
+		NoSearchCounters GetCounters() const {
+			return NoSearchCounters();
+		}
+	};
+}
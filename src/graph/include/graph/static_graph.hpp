@@ -6,8 +6,11 @@
 #include <limits>
 #include <boost/iterator/counting_iterator.hpp>
 #include "detail/util/Collection.hpp"
+#include "detail/util/MappedArray.hpp"
 #include "detail/StaticGraphIterators.hpp"
 #include "detail/BasicGraphStructures.hpp"
+#include "detail/StaticGraphPropertyStorage.hpp"
+#include "detail/StaticGraphReordering.hpp"
 #include "detail/StaticGraphPropertyMaps.hpp"
 #include "detail/StaticGraphBuilder.hpp"
 #include "properties.hpp"
@@ -20,44 +23,75 @@ namespace graph {
 		public vertex_list_graph_tag, public boost::vertex_list_graph_tag
 	{ };
 
+	struct ForwardStaticGraphTraversalCategory :
+		public adjacency_graph_tag, public boost::adjacency_graph_tag,
+		public incidence_graph_tag, public boost::incidence_graph_tag,
+		public vertex_list_graph_tag, public boost::vertex_list_graph_tag
+	{ };
+
+	// Links tags of a static graph
+
+	// Out and in links are stored, the graph is bidirectional and can be wrapped into ComplementGraph
+	struct BidirectionalLinksTag {};
+
+	// Only out links are stored, which halves the adjacency memory of one-directional searches
+	struct ForwardLinksTag {};
+
 	struct NoProperties : public Properties<> {};
 
-	template <typename VertexProperties = NoProperties, typename EdgeProperties = NoProperties>
+	// Layout selects how the vertex and edge property bundles are stored, see RowLayoutTag and ColumnLayoutTag.
+	// Links selects whether the in links are stored, see BidirectionalLinksTag and ForwardLinksTag
+	template <typename VertexProperties = NoProperties, typename EdgeProperties = NoProperties,
+			  typename Layout = RowLayoutTag, typename Links = BidirectionalLinksTag>
 	class StaticGraph {
+		template <typename, typename, typename, typename>
+		friend class StaticGraph;
 	public:
-		using type = StaticGraph<VertexProperties, EdgeProperties>;
+		using type = StaticGraph<VertexProperties, EdgeProperties, Layout, Links>;
+
+		static constexpr bool HasInLinks = std::is_same<Links, BidirectionalLinksTag>::value;
 
 		using edge_size_type = uint32_t;
 		using vertices_size_type = uint32_t;
 		using edges_size_type = uint32_t;
-		using degree_size_type = uint16_t;
+		using degree_size_type = uint32_t;
 		using vertex_descriptor = vertices_size_type;
 		using directed_category = directed_tag;
 		using edge_parallel_category = disallow_parallel_edge_tag;
-		using traversal_category = StaticGraphTraversalCategory;
-
-		using VertexPropertyMapType = VertexPropertyMap<VertexProperties, type>;
-		using EdgePropertyMapType = EdgePropertyMap<EdgeProperties, type>;
+		using traversal_category = std::conditional_t<HasInLinks,
+			StaticGraphTraversalCategory, ForwardStaticGraphTraversalCategory>;
+
+		using layout_category = Layout;
+		using links_category = Links;
+
+		using edge_descriptor = FancyEdgeDescriptor<vertex_descriptor, edges_size_type>;
+
+		using VertexPropertyMapType = std::conditional_t<
+			std::is_same<Layout, ColumnLayoutTag>::value,
+			ColumnPropertyMap<VertexProperties, vertex_descriptor>,
+			VertexPropertyMap<VertexProperties, type>>;
+		using EdgePropertyMapType = std::conditional_t<
+			std::is_same<Layout, ColumnLayoutTag>::value,
+			ColumnPropertyMap<EdgeProperties, edge_descriptor>,
+			EdgePropertyMap<EdgeProperties, type>>;
 		using vertex_bundled = VertexProperties;
 		using edge_bundled = EdgeProperties;
 
-		friend VertexPropertyMapType;
 	private:
 		
-		using EdgePropertiesVecType = std::vector<EdgeProperties>;
+		using EdgePropertiesStorageType = detail::PropertiesStorage<EdgeProperties, Layout>;
 
-		using StoredAdjacencyType = FancyLink<vertex_descriptor, EdgeProperties>;
-		using AdjacenciesVecType = std::vector<StoredAdjacencyType>;
-		using AdjacenciesVecIteratorType = typename AdjacenciesVecType::const_iterator;
+		using StoredAdjacencyType = FancyLink<vertex_descriptor, edges_size_type>;
+		using AdjacenciesVecType = graphUtil::MappedArray<StoredAdjacencyType>;
+		using AdjacenciesVecIteratorType = const StoredAdjacencyType*;
 
-		using VertexType = Vertex<AdjacenciesVecIteratorType, VertexProperties>;
-		using VerticesVecType = std::vector<VertexType>;
+		using VertexPropertiesStorageType = detail::PropertiesStorage<VertexProperties, Layout>;
 
-		using AdjacenciesSeparatorsVecType = std::vector<degree_size_type>;
+		// Links of the vertex v are [offsets[v], offsets[v + 1]) of the in or out links array (CSR)
+		using OffsetsVecType = graphUtil::MappedArray<edges_size_type>;
 	public:
 		using vertex_iterator = boost::counting_iterator<vertex_descriptor>;
 		using adjacency_iterator = AdjacencyIterator<AdjacenciesVecIteratorType, vertex_descriptor>;
-		using edge_descriptor = FancyEdgeDescriptor<typename StoredAdjacencyType::VertexType, typename StoredAdjacencyType::EdgePropertiesType>;
 		using out_edge_iterator = EdgeIterator<AdjacenciesVecIteratorType, edge_descriptor, internals::EdgeDirection::Out>;
 		using in_edge_iterator = EdgeIterator<AdjacenciesVecIteratorType, edge_descriptor, internals::EdgeDirection::In>;
 
@@ -68,20 +102,18 @@ namespace graph {
 
 		using Builder = GraphBuilder<type>;
 		friend Builder;
+
+		using Snapshot = GraphSnapshot<type>;
+		friend Snapshot;
 		
 		class VertexCollection : public graphUtil::Collection<vertex_iterator> {
 		public:
-			VertexType operator[](const vertex_descriptor& v) const {
-				if (v == this->size())
-					return VertexType(this->graph.adjacencies.end());
-				return this->graph.vertices[v];
+			vertex_descriptor operator[](const vertices_size_type& index) const {
+				return *(this->begin() + index);
 			}
 
 			explicit VertexCollection(const StaticGraph& g)
-				: CollectionType(vertex_iterator(0), vertex_iterator(g.vertices.size())), graph(g) {}
-
-		private:
-			const StaticGraph& graph;
+				: CollectionType(vertex_iterator(0), vertex_iterator(g.outOffsets.size() - 1)) {}
 		};
 
         static vertex_descriptor null_vertex() { 
@@ -89,8 +121,8 @@ namespace graph {
         };
 
 		StaticGraph()
-			: edgePropertyMap(new EdgePropertyMapType()),
-			  vertexPropertyMap(new VertexPropertyMapType(this)),
+			: edgePropertyMap(new EdgePropertyMapType(&edgeProperties)),
+			  vertexPropertyMap(new VertexPropertyMapType(&vertexProperties)),
 			  vertexCollection(nullptr) {}
 
 		template <class PairIterator>
@@ -123,6 +155,20 @@ namespace graph {
             delete builder;
         }
 
+		// Copies the out links and the properties of a bidirectional graph,
+		// e.g. to query a graph preprocessed with ComplementGraph searches
+		template <typename OtherLinks, typename = std::enable_if_t<
+			!HasInLinks && StaticGraph<VertexProperties, EdgeProperties, Layout, OtherLinks>::HasInLinks>>
+		explicit StaticGraph(const StaticGraph<VertexProperties, EdgeProperties, Layout, OtherLinks>& graph)
+			: StaticGraph() {
+			this->outLinks = graph.outLinks;
+			this->outOffsets = graph.outOffsets;
+			this->vertexProperties = graph.vertexProperties;
+			this->edgeProperties = graph.edgeProperties;
+			this->permutation = graph.permutation;
+			Initialize();
+		}
+
 
 		const VertexCollection& Vertices() const {
 			return *vertexCollection;
@@ -130,31 +176,41 @@ namespace graph {
 
 		AdjacencyCollection OutAdjacencies(const vertex_descriptor& v) const {
 			return AdjacencyCollection(
-				adjacency_iterator(this->Vertices()[v].begin + this->edgesSeparators[v]),
-				adjacency_iterator(this->Vertices()[v + 1].begin));
-				
+				adjacency_iterator(this->outLinks.data() + this->outOffsets[v]),
+				adjacency_iterator(this->outLinks.data() + this->outOffsets[v + 1]));
 		}
 
 		AdjacencyCollection InAdjacencies(const vertex_descriptor& v) const {
+			static_assert(HasInLinks, "The graph stores no in links");
 			return AdjacencyCollection(
-				adjacency_iterator(this->Vertices()[v].begin),
-				adjacency_iterator(this->Vertices()[v].begin + this->edgesSeparators[v]));
+				adjacency_iterator(this->inLinks.data() + this->inOffsets[v]),
+				adjacency_iterator(this->inLinks.data() + this->inOffsets[v + 1]));
 		}
 
 		OutEdgeCollection OutEdges(const vertex_descriptor& v) const {
 			return OutEdgeCollection(
-				out_edge_iterator(v, this->Vertices()[v].begin + this->edgesSeparators[v]),
-				out_edge_iterator(v, this->Vertices()[v + 1].begin));
+				out_edge_iterator(v, this->outLinks.data() + this->outOffsets[v]),
+				out_edge_iterator(v, this->outLinks.data() + this->outOffsets[v + 1]));
 		}
 
 		InEdgeCollection InEdges(const vertex_descriptor& v) const {
+			static_assert(HasInLinks, "The graph stores no in links");
 			return InEdgeCollection(
-				in_edge_iterator(v, this->Vertices()[v].begin),
-				in_edge_iterator(v, this->Vertices()[v].begin + this->edgesSeparators[v]));
+				in_edge_iterator(v, this->inLinks.data() + this->inOffsets[v]),
+				in_edge_iterator(v, this->inLinks.data() + this->inOffsets[v + 1]));
+		}
+
+		degree_size_type OutDegree(const vertex_descriptor& v) const {
+			return this->outOffsets[v + 1] - this->outOffsets[v];
+		}
+
+		degree_size_type InDegree(const vertex_descriptor& v) const {
+			static_assert(HasInLinks, "The graph stores no in links");
+			return this->inOffsets[v + 1] - this->inOffsets[v];
 		}
 
 		edges_size_type EdgesCount() const {
-			return edgeProperties.size();
+			return edgeProperties.Size();
 		}
 
 		const EdgePropertyMapType& GetEdgePropertyMap() const {
@@ -165,42 +221,56 @@ namespace graph {
 			return *vertexPropertyMap;
 		}
 
+		// Maps the vertex ids of the builder input to the vertex ids of the graph, see GraphBuilder::Reorder
+		const VertexPermutation& Permutation() const {
+			return permutation;
+		}
+
 	private:
 		void Initialize() {
 			this->vertexCollection = std::make_unique<VertexCollection>(*this);
 		}
 
-		AdjacenciesVecType adjacencies;
-		VerticesVecType vertices;
-		EdgePropertiesVecType edgeProperties;
-		AdjacenciesSeparatorsVecType edgesSeparators;
+		AdjacenciesVecType outLinks;
+		AdjacenciesVecType inLinks;
+		OffsetsVecType outOffsets;
+		OffsetsVecType inOffsets;
+		VertexPropertiesStorageType vertexProperties;
+		EdgePropertiesStorageType edgeProperties;
+		VertexPermutation permutation;
 		std::unique_ptr<EdgePropertyMapType> edgePropertyMap;
 		std::unique_ptr<VertexPropertyMapType> vertexPropertyMap;
 		std::unique_ptr<VertexCollection> vertexCollection;
 	};
+
+	// Static graph without in links for the searches which never look at the in edges
+	template <typename VertexProperties = NoProperties, typename EdgeProperties = NoProperties,
+			  typename Layout = RowLayoutTag>
+	using ForwardStaticGraph = StaticGraph<VertexProperties, EdgeProperties, Layout, ForwardLinksTag>;
 }
 
 // PropertyMaps
 namespace graph {
-#define StaticGraphType StaticGraph<VertexProperties, EdgeProperties>
+#define StaticGraphTemplate template <typename VertexProperties, typename EdgeProperties, typename Layout, typename Links>
+#define StaticGraphType StaticGraph<VertexProperties, EdgeProperties, Layout, Links>
 
-	template <typename VertexProperties, typename EdgeProperties>
+	StaticGraphTemplate
 	struct property_map<StaticGraphType, vertex_bundle_t> {
 		using type = typename StaticGraphType::VertexPropertyMapType;
 	};
 
-	template <typename VertexProperties, typename EdgeProperties>
+	StaticGraphTemplate
 	struct property_map<StaticGraphType, edge_bundle_t> {
 		using type = typename StaticGraphType::EdgePropertyMapType;
 	};
 
-	template <typename VertexProperties, typename EdgeProperties>
+	StaticGraphTemplate
 	inline typename property_map<StaticGraphType, vertex_bundle_t>::type
 	get(const vertex_bundle_t&, StaticGraphType& graph) {
 		return graph.GetVertexPropertyMap();
 	}
 
-	template <typename VertexProperties, typename EdgeProperties>
+	StaticGraphTemplate
 	inline typename property_map<StaticGraphType, edge_bundle_t>::type
 	get(const edge_bundle_t&, StaticGraphType& graph) {
 		return graph.GetEdgePropertyMap();
@@ -210,7 +280,7 @@ namespace graph {
     template <typename Graph>
     struct VertexIndexPropertyMap{};
 
-    template <typename VertexProperties, typename EdgeProperties>
+    StaticGraphTemplate
     struct VertexIndexPropertyMap<StaticGraphType> {
         using key_type = typename graph_traits<StaticGraphType>::vertex_descriptor;
         using value_type = typename graph_traits<StaticGraphType>::vertices_size_type;
@@ -218,25 +288,26 @@ namespace graph {
         using category = boost::readable_property_map_tag;
     };
 
-    template <typename VertexProperties, typename EdgeProperties>
+    StaticGraphTemplate
     struct property_map<StaticGraphType, vertex_index_t> {
         using type = VertexIndexPropertyMap<StaticGraphType>;
     };
 
-    template <typename VertexProperties, typename EdgeProperties>
+    StaticGraphTemplate
     typename VertexIndexPropertyMap<StaticGraphType>::value_type
         get(const VertexIndexPropertyMap<StaticGraphType>& index,
         const typename VertexIndexPropertyMap<StaticGraphType>::key_type& key) {
         return key;
     };
 
-    template<typename VertexProperties, typename EdgeProperties>
+    StaticGraphTemplate
     inline typename property_map<StaticGraphType, vertex_index_t>::type
     get(const vertex_index_t&, StaticGraphType&) {
         return VertexIndexPropertyMap<StaticGraphType>();
     };
 
 #undef StaticGraphType
+#undef StaticGraphTemplate
 }
 
 #include "detail/StaticGraphTools.hpp"
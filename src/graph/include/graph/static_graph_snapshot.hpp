@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <graph/static_graph.hpp>
+
+namespace graph {
+	namespace detail {
+		// Snapshot file: SnapshotHeader, SnapshotArrayEntry for every array, then the arrays,
+		// each aligned to SnapshotAlignment bytes. The arrays are out offsets, in offsets, out links, in links,
+		// the vertex permutation (empty when the vertices are not reordered) in both directions,
+		// vertex property columns and edge property columns, in the order of the properties in the bundles.
+		const char SnapshotMagic[8] = {'S', 'G', 'S', 'N', 'A', 'P', '\0', '\0'};
+		const uint32_t SnapshotVersion = 2;
+		const uint64_t SnapshotAlignment = 64;
+
+		struct SnapshotHeader {
+			char magic[8];
+			uint32_t version;
+			uint32_t arraysCount;
+			uint64_t vertexCount;
+			uint64_t edgesCount;
+			uint64_t permutationSize;
+		};
+
+		struct SnapshotArrayEntry {
+			uint64_t offset;
+			uint64_t count;
+			uint32_t elementSize;
+			uint32_t reserved;
+		};
+	}
+
+	// Saves the arrays of a built graph as they are and loads them back by mapping the file:
+	// a loaded graph runs on the mapped pages with no parsing and no copying.
+	// The file is mapped privately, so writes to the loaded graph properties never reach the file,
+	// and processes loading the same snapshot share its page cache until they write.
+	// Only graphs with ColumnLayoutTag are supported, every column must be trivially copyable.
+	template <typename Graph>
+	class GraphSnapshot {
+		static_assert(std::is_same<typename Graph::layout_category, ColumnLayoutTag>::value,
+					  "Snapshots store property columns, use ColumnLayoutTag");
+
+		static constexpr uint32_t ArraysCount = 6 +
+			Graph::VertexPropertiesStorageType::ColumnsCount() + Graph::EdgePropertiesStorageType::ColumnsCount();
+	public:
+		static bool Save(const Graph& graph, const char* fileName) {
+			std::ofstream output(fileName, std::ios::binary | std::ios::trunc);
+			if (!output) {
+				std::cerr << "File " << fileName << " can not be created!" << std::endl;
+				return false;
+			}
+
+			detail::SnapshotHeader header;
+			std::memcpy(header.magic, detail::SnapshotMagic, sizeof(header.magic));
+			header.version = detail::SnapshotVersion;
+			header.arraysCount = ArraysCount;
+			header.vertexCount = num_vertices(graph);
+			header.edgesCount = num_edges(graph);
+			header.permutationSize = graph.permutation.toInternal.size();
+
+			std::vector<detail::SnapshotArrayEntry> entries;
+			uint64_t offset = Align(sizeof(header) + ArraysCount * sizeof(detail::SnapshotArrayEntry));
+			ForEachArray(graph, header, [&entries, &offset](const auto& array, uint64_t) {
+				using ValueType = typename std::decay_t<decltype(array)>::value_type;
+				static_assert(std::is_trivially_copyable<ValueType>::value, "Snapshot arrays are stored bytewise");
+				entries.push_back({offset, array.size(), sizeof(ValueType), 0});
+				offset = Align(offset + array.size() * sizeof(ValueType));
+			});
+
+			output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			output.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(entries[0]));
+			size_t index = 0;
+			ForEachArray(graph, header, [&output, &entries, &index](const auto& array, uint64_t) {
+				using ValueType = typename std::decay_t<decltype(array)>::value_type;
+				Pad(output, entries[index++].offset);
+				output.write(reinterpret_cast<const char*>(array.data()), array.size() * sizeof(ValueType));
+			});
+
+			return static_cast<bool>(output);
+		}
+
+		static std::unique_ptr<Graph> Load(const char* fileName) {
+			int file = open(fileName, O_RDONLY);
+			if (file < 0) {
+				std::cerr << "File " << fileName << " not found!" << std::endl;
+				return nullptr;
+			}
+			struct stat fileStat;
+			if (fstat(file, &fileStat) != 0 || static_cast<uint64_t>(fileStat.st_size) < sizeof(detail::SnapshotHeader)) {
+				close(file);
+				std::cerr << "Wrong snapshot format" << std::endl;
+				return nullptr;
+			}
+			const uint64_t fileSize = fileStat.st_size;
+			void* address = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+			close(file);
+			if (address == MAP_FAILED) {
+				std::cerr << "File " << fileName << " can not be mapped!" << std::endl;
+				return nullptr;
+			}
+			auto mapping = std::shared_ptr<void>(address, [fileSize](void* p) { munmap(p, fileSize); });
+			auto bytes = static_cast<char*>(address);
+
+			const auto& header = *reinterpret_cast<const detail::SnapshotHeader*>(bytes);
+			bool isValid = std::memcmp(header.magic, detail::SnapshotMagic, sizeof(header.magic)) == 0 &&
+				header.version == detail::SnapshotVersion && header.arraysCount == ArraysCount &&
+				(header.permutationSize == 0 || header.permutationSize == header.vertexCount) &&
+				sizeof(header) + ArraysCount * sizeof(detail::SnapshotArrayEntry) <= fileSize;
+			if (!isValid) {
+				std::cerr << "Wrong snapshot format" << std::endl;
+				return nullptr;
+			}
+			auto entries = reinterpret_cast<const detail::SnapshotArrayEntry*>(bytes + sizeof(header));
+
+			auto graph = std::make_unique<Graph>();
+			size_t index = 0;
+			ForEachArray(*graph, header, [&](auto& array, uint64_t expectedCount) {
+				using ArrayType = std::decay_t<decltype(array)>;
+				using ValueType = typename ArrayType::value_type;
+				const auto& entry = entries[index++];
+				if (!isValid || entry.count != expectedCount || entry.elementSize != sizeof(ValueType) ||
+					entry.offset % alignof(ValueType) != 0 || entry.offset + entry.count * sizeof(ValueType) > fileSize) {
+					isValid = false;
+					return;
+				}
+				array = ArrayType::View(reinterpret_cast<ValueType*>(bytes + entry.offset), entry.count, mapping);
+			});
+			if (!isValid) {
+				std::cerr << "Wrong snapshot format" << std::endl;
+				return nullptr;
+			}
+			graph->vertexProperties.ResetSize(header.vertexCount);
+			graph->edgeProperties.ResetSize(header.edgesCount);
+
+			graph->Initialize();
+			return graph;
+		}
+
+	private:
+		// Calls function(array, count) for every array of the graph in the snapshot order,
+		// count is the size of the array in a graph described by the header
+		template <typename G, typename Function>
+		static void ForEachArray(G& graph, const detail::SnapshotHeader& header, Function&& function) {
+			const uint64_t vertexCount = header.vertexCount;
+			const uint64_t edgesCount = header.edgesCount;
+			// a graph without in links keeps their arrays empty
+			const uint64_t inLinksFactor = Graph::HasInLinks ? 1 : 0;
+			function(graph.outOffsets, vertexCount + 1);
+			function(graph.inOffsets, inLinksFactor * (vertexCount + 1));
+			function(graph.outLinks, edgesCount);
+			function(graph.inLinks, inLinksFactor * edgesCount);
+			function(graph.permutation.toInternal, header.permutationSize);
+			function(graph.permutation.toExternal, header.permutationSize);
+			graph.vertexProperties.ForEachColumn([&function, vertexCount](auto& column) { function(column, vertexCount); });
+			graph.edgeProperties.ForEachColumn([&function, edgesCount](auto& column) { function(column, edgesCount); });
+		}
+
+		static uint64_t Align(uint64_t offset) {
+			return (offset + detail::SnapshotAlignment - 1) / detail::SnapshotAlignment * detail::SnapshotAlignment;
+		}
+
+		static void Pad(std::ofstream& output, uint64_t offset) {
+			static const char zeros[detail::SnapshotAlignment] = {};
+			output.write(zeros, offset - static_cast<uint64_t>(output.tellp()));
+		}
+	};
+}
@@ -10,7 +10,11 @@ namespace statistics {
 enum class GraphKeys {
     source,
     target,
-    distance
+    distance,
+    ordering,
+    threads,
+    queue,
+    representation
 };
 
 std::ostream& operator<<(std::ostream& osm, const GraphKeys& arg) {
@@ -24,6 +28,18 @@ std::ostream& operator<<(std::ostream& osm, const GraphKeys& arg) {
     case GraphKeys::distance:
         osm << "distance";
         break;
+    case GraphKeys::ordering:
+        osm << "ordering";
+        break;
+    case GraphKeys::threads:
+        osm << "threads";
+        break;
+    case GraphKeys::queue:
+        osm << "queue";
+        break;
+    case GraphKeys::representation:
+        osm << "representation";
+        break;
     default:
         osm << "Unknown column";
         break;
@@ -47,6 +63,34 @@ struct DijkstraSSSPStatistics : GeneralStatistics {
     StatisticsField<GraphKeys,size_t> distance;
 };
 
+struct VertexOrderingStatistics : DijkstraOneToAllSPStatistics {
+    VertexOrderingStatistics(const DijkstraOneToAllSPStatistics& base, const std::string& ordering)
+        :DijkstraOneToAllSPStatistics(base), ordering(GraphKeys::ordering, ordering) {};
+    StatisticsField<GraphKeys, std::string> ordering;
+};
+
+struct ParallelOneToAllSPStatistics : DijkstraOneToAllSPStatistics {
+    ParallelOneToAllSPStatistics(const DijkstraOneToAllSPStatistics& base, size_t threads)
+        :DijkstraOneToAllSPStatistics(base), threads(GraphKeys::threads, threads) {};
+    StatisticsField<GraphKeys, size_t> threads;
+};
+
+// Any statistics row followed by the priority queue of the search
+template <typename Base = GeneralStatistics>
+struct QueueStatistics : Base {
+    QueueStatistics(const Base& base, const std::string& queue)
+        :Base(base), queue(GraphKeys::queue, queue) {};
+    StatisticsField<GraphKeys, std::string> queue;
+};
+
+// Any statistics row followed by the storage of the graph, e.g. forward links only
+template <typename Base = GeneralStatistics>
+struct RepresentationStatistics : Base {
+    RepresentationStatistics(const Base& base, const std::string& representation)
+        :Base(base), representation(GraphKeys::representation, representation) {};
+    StatisticsField<GraphKeys, std::string> representation;
+};
+
 struct BFSStatistics : GeneralStatistics {
     using GeneralStatistics::GeneralStatistics;
 };
@@ -56,6 +100,28 @@ std::ostream& operator<<(std::ostream& osm, const DijkstraOneToAllSPStatistics&
     return osm;
 };
 
+std::ostream& operator<<(std::ostream& osm, const VertexOrderingStatistics& arg) {
+    osm << static_cast<DijkstraOneToAllSPStatistics>(arg) << '\t' << arg.ordering;
+    return osm;
+};
+
+std::ostream& operator<<(std::ostream& osm, const ParallelOneToAllSPStatistics& arg) {
+    osm << static_cast<DijkstraOneToAllSPStatistics>(arg) << '\t' << arg.threads;
+    return osm;
+};
+
+template <typename Base>
+std::ostream& operator<<(std::ostream& osm, const QueueStatistics<Base>& arg) {
+    osm << static_cast<const Base&>(arg) << '\t' << arg.queue;
+    return osm;
+};
+
+template <typename Base>
+std::ostream& operator<<(std::ostream& osm, const RepresentationStatistics<Base>& arg) {
+    osm << static_cast<const Base&>(arg) << '\t' << arg.representation;
+    return osm;
+};
+
 std::ostream& operator<<(std::ostream& osm, const DijkstraSSSPStatistics& arg) {
     osm << static_cast<GeneralStatistics>(arg) << '\t' << arg.source << '\t' << arg.target << '\t' << arg.distance;
     return osm;
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <graph/io/FileReader.hpp>
+#include <graph/io/MappedFileReader.hpp>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+
+using namespace std;
+using namespace graphIO;
+
+namespace {
+	void WriteFile(const char* fileName, const string& content) {
+		ofstream output(fileName, ios::binary);
+		output << content;
+	}
+}
+
+TEST(MappedFileReader, MatchesFileReader) {
+	const char* fileName = "mapped-reader-test.txt";
+	mt19937 generator(13);
+	uniform_int_distribution<uint32_t> valueDistribution;
+	uniform_int_distribution<int> lengthDistribution(0, 9);
+	string content = "d\n";
+	for (int i = 0; i < 20000; ++i) {
+		// every length of the tokens, some of them with leading zeros
+		uint32_t value = valueDistribution(generator);
+		for (int digits = lengthDistribution(generator); digits > 0; --digits) value /= 10;
+		content += (i % 7 == 0 ? "00" : "") + to_string(value);
+		content += i % 4 == 3 ? "\r\n" : (i % 5 == 0 ? "\t " : " ");
+	}
+	content += "4294967295 12345678901234567 7";
+	WriteFile(fileName, content);
+
+	FileReader fileReader;
+	MappedFileReader mappedReader;
+	ASSERT_TRUE(fileReader.Open(fileName));
+	ASSERT_TRUE(mappedReader.Open(fileName));
+	EXPECT_EQ(content.size(), mappedReader.Size());
+	EXPECT_EQ('d', mappedReader.NextChar());
+	EXPECT_EQ('d', fileReader.NextChar());
+	size_t count = 0;
+	while (fileReader.HasNext()) {
+		ASSERT_TRUE(mappedReader.HasNext());
+		ASSERT_EQ(fileReader.NextUnsignedInt(), mappedReader.NextUnsignedInt()) << "token " << count;
+		++count;
+	}
+	EXPECT_EQ(20003u, count);
+	EXPECT_FALSE(mappedReader.HasNext());
+	EXPECT_EQ(0u, mappedReader.NextUnsignedInt());
+	EXPECT_EQ(0, mappedReader.NextChar());
+
+	fileReader.Close();
+	remove(fileName);
+}
+
+TEST(MappedFileReader, Lines) {
+	const char* fileName = "mapped-reader-lines.txt";
+	WriteFile(fileName, "c comment\r\np sp 3 2\na 1 2 17");
+
+	MappedFileReader reader;
+	ASSERT_TRUE(reader.Open(fileName));
+	EXPECT_EQ("c comment", reader.ReadLine());
+	EXPECT_EQ('p', reader.NextChar());
+	EXPECT_EQ(" sp 3 2", reader.ReadLine());
+	EXPECT_EQ('a', reader.NextChar());
+	EXPECT_EQ(1u, reader.NextUnsignedInt());
+	EXPECT_EQ(2u, reader.NextUnsignedInt());
+	EXPECT_EQ(17u, reader.NextUnsignedInt());
+	EXPECT_FALSE(reader.HasNext());
+	reader.Close();
+
+	WriteFile(fileName, "");
+	ASSERT_TRUE(reader.Open(fileName));
+	EXPECT_FALSE(reader.HasNext());
+	EXPECT_EQ("", reader.ReadLine());
+	EXPECT_FALSE(reader.Open("mapped-reader-missing.txt"));
+
+	remove(fileName);
+}
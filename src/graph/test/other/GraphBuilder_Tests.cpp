@@ -6,6 +6,9 @@ using namespace std;
 using namespace graph;
 using namespace graphUtil;
 
+struct distance_t {};
+struct weight_t {};
+
 TEST(GraphBuilder, Correctness) {
 	using EmptyStaticGraph = StaticGraph<>;
 
@@ -52,3 +55,238 @@ TEST(GraphBuilder, Correctness) {
 		}
 	}
 }
+
+TEST(GraphBuilder, HighDegreeVertex) {
+	using EmptyStaticGraph = StaticGraph<>;
+
+	// more links than a 16-bit degree could count
+	size_t n = 70000;
+	vector<pair<size_t, size_t>> edges;
+	for (size_t v = 1; v < n; ++v) {
+		edges.push_back(make_pair(0, v));
+		edges.push_back(make_pair(v, 0));
+	}
+
+	auto g = EmptyStaticGraph(edges.begin(), edges.end(), n, edges.size());
+
+	EXPECT_EQ(n - 1, out_degree(0, g));
+	EXPECT_EQ(n - 1, in_degree(0, g));
+	EXPECT_EQ(1u, out_degree(n - 1, g));
+	EXPECT_EQ(1u, in_degree(n - 1, g));
+	EXPECT_EQ(n - 1, Range(out_edges(0, g)).size());
+	EXPECT_EQ(n - 1, target(*(Range(out_edges(0, g)).end() - 1), g));
+	EXPECT_EQ(0u, g.Vertices()[0]);
+	EXPECT_EQ(n - 1, g.Vertices()[n - 1]);
+}
+
+TEST(GraphBuilder, ParallelBuildMatchesSerial) {
+	using WeightedGraph = StaticGraph<Properties<Property<distance_t, uint32_t>>, Properties<Property<weight_t, uint32_t>>>;
+	using EdgeProperties = WeightedGraph::edge_bundled;
+
+	size_t n = 1000;
+	size_t m = 20000;
+	mt19937 generator(42);
+	uniform_int_distribution<size_t> vertexDistribution(0, n - 1);
+
+	// duplicates included, their order must be preserved too
+	WeightedGraph::Builder serialBuilder(n, m);
+	WeightedGraph::Builder parallelBuilder(n, m);
+	for (size_t i = 0; i < m; ++i) {
+		auto from = vertexDistribution(generator);
+		auto to = vertexDistribution(generator);
+		EdgeProperties properties;
+		graph::get<weight_t>(properties) = i;
+		serialBuilder.AddEdge(from, to, properties);
+		parallelBuilder.AddEdge(from, to, properties);
+	}
+
+	auto serial = serialBuilder.Build();
+	for (size_t threadsCount : {1, 3, 8}) {
+		auto parallel = parallelBuilder.BuildParallel(threadsCount);
+
+		EXPECT_EQ(num_vertices(*serial), num_vertices(*parallel));
+		EXPECT_EQ(num_edges(*serial), num_edges(*parallel));
+		auto serialWeight = graph::get(weight_t(), *serial);
+		auto parallelWeight = graph::get(weight_t(), *parallel);
+		for (auto v : Range(vertices(*serial))) {
+			auto serialOut = Range(out_edges(v, *serial));
+			auto parallelOut = Range(out_edges(v, *parallel));
+			ASSERT_TRUE(std::equal(serialOut.begin(), serialOut.end(), parallelOut.begin(), parallelOut.end()));
+			auto serialIn = Range(in_edges(v, *serial));
+			auto parallelIn = Range(in_edges(v, *parallel));
+			ASSERT_TRUE(std::equal(serialIn.begin(), serialIn.end(), parallelIn.begin(), parallelIn.end()));
+			for (auto e : serialOut) {
+				EXPECT_EQ(e.id, graph::get(parallelWeight, e));
+				EXPECT_EQ(graph::get(serialWeight, e), graph::get(parallelWeight, e));
+			}
+		}
+	}
+}
+
+TEST(GraphBuilder, ParallelBuildWithMoreThreadsThanVertices) {
+	using EmptyStaticGraph = StaticGraph<>;
+
+	// most chunks of edges and blocks of vertices are empty
+	size_t n = 10;
+	size_t m = 60;
+	size_t threadsCount = 256;
+	mt19937 generator(7);
+	uniform_int_distribution<size_t> vertexDistribution(0, n - 1);
+	EmptyStaticGraph::Builder serialBuilder(n, m);
+	EmptyStaticGraph::Builder parallelBuilder(n, m);
+	for (size_t i = 0; i < m; ++i) {
+		auto from = vertexDistribution(generator);
+		auto to = vertexDistribution(generator);
+		serialBuilder.AddEdge(from, to);
+		parallelBuilder.AddEdge(from, to);
+	}
+
+	auto serial = serialBuilder.Build();
+	auto parallel = parallelBuilder.BuildParallel(threadsCount);
+	EXPECT_EQ(num_edges(*serial), num_edges(*parallel));
+	for (auto v : Range(vertices(*serial))) {
+		auto serialOut = Range(out_edges(v, *serial));
+		auto parallelOut = Range(out_edges(v, *parallel));
+		EXPECT_TRUE(std::equal(serialOut.begin(), serialOut.end(), parallelOut.begin(), parallelOut.end()));
+		auto serialIn = Range(in_edges(v, *serial));
+		auto parallelIn = Range(in_edges(v, *parallel));
+		EXPECT_TRUE(std::equal(serialIn.begin(), serialIn.end(), parallelIn.begin(), parallelIn.end()));
+		auto serialAdjacent = Range(adjacent_vertices(v, *serial));
+		auto parallelAdjacent = Range(adjacent_vertices(v, *parallel));
+		EXPECT_TRUE(std::equal(serialAdjacent.begin(), serialAdjacent.end(),
+			parallelAdjacent.begin(), parallelAdjacent.end()));
+	}
+
+	EmptyStaticGraph::Builder emptyBuilder(n);
+	auto empty = emptyBuilder.BuildParallel(threadsCount);
+	EXPECT_EQ(n, num_vertices(*empty));
+	EXPECT_EQ(0u, num_edges(*empty));
+	EXPECT_EQ(0u, out_degree(n - 1, *empty));
+}
+
+TEST(GraphBuilder, ForwardGraphKeepsOutLinksOnly) {
+	using EdgeBundle = Properties<Property<weight_t, uint32_t>>;
+	using VertexBundle = Properties<Property<distance_t, uint32_t>>;
+	using Graph = StaticGraph<VertexBundle, EdgeBundle, ColumnLayoutTag>;
+	using ForwardGraph = ForwardStaticGraph<VertexBundle, EdgeBundle, ColumnLayoutTag>;
+	static_assert(detail::IsBidirectional<Graph>::value, "");
+	static_assert(!detail::IsBidirectional<ForwardGraph>::value, "");
+	static_assert(detail::IsIncidence<ForwardGraph>::value, "");
+
+	size_t n = 300;
+	size_t m = 3000;
+	mt19937 generator(11);
+	uniform_int_distribution<size_t> vertexDistribution(0, n - 1);
+	Graph::Builder builder(n, m);
+	ForwardGraph::Builder forwardBuilder(n, m);
+	for (size_t i = 0; i < m; ++i) {
+		auto from = vertexDistribution(generator);
+		auto to = vertexDistribution(generator);
+		Graph::edge_bundled properties;
+		graph::get<weight_t>(properties) = i;
+		builder.AddEdge(from, to, properties);
+		forwardBuilder.AddEdge(from, to, properties);
+	}
+	builder.Reorder(VertexOrder::Degree);
+	forwardBuilder.Reorder(VertexOrder::Degree);
+	auto g = builder.Build();
+	auto built = forwardBuilder.Build();
+	auto parallel = forwardBuilder.BuildParallel(3);
+	auto distance = graph::get(distance_t(), *g);
+	for (auto v : Range(vertices(*g))) {
+		graph::put(distance, v, 2 * v);
+	}
+	ForwardGraph copied(*g);
+
+	auto weight = graph::get(weight_t(), *g);
+	for (const ForwardGraph* forward : {built.get(), parallel.get(), &copied}) {
+		EXPECT_EQ(num_vertices(*g), num_vertices(*forward));
+		EXPECT_EQ(num_edges(*g), num_edges(*forward));
+		auto forwardWeight = graph::get(weight_t(), const_cast<ForwardGraph&>(*forward));
+		for (auto v : Range(vertices(*g))) {
+			EXPECT_EQ(g->Permutation().ToInternal(v), forward->Permutation().ToInternal(v));
+			EXPECT_EQ(out_degree(v, *g), out_degree(v, *forward));
+			auto out = Range(out_edges(v, *g));
+			auto forwardOut = Range(out_edges(v, *forward));
+			ASSERT_TRUE(std::equal(out.begin(), out.end(), forwardOut.begin(), forwardOut.end()));
+			for (auto e : forwardOut) {
+				EXPECT_EQ(graph::get(weight, e), graph::get(forwardWeight, e));
+			}
+		}
+	}
+	auto copiedDistance = graph::get(distance_t(), copied);
+	for (auto v : Range(vertices(copied))) {
+		EXPECT_EQ(2 * v, graph::get(copiedDistance, v));
+	}
+}
+
+TEST(GraphBuilder, ReorderKeepsEdgesAndPermutation) {
+	using WeightedGraph = StaticGraph<Properties<Property<distance_t, uint32_t>>, Properties<Property<weight_t, uint32_t>>>;
+	using EdgeProperties = WeightedGraph::edge_bundled;
+
+	size_t n = 300;
+	size_t m = 2000;
+	mt19937 generator(11);
+	uniform_int_distribution<size_t> vertexDistribution(0, n - 1);
+	vector<pair<size_t, size_t>> edges;
+	for (size_t i = 0; i < m; ++i) {
+		edges.push_back(make_pair(vertexDistribution(generator), vertexDistribution(generator)));
+	}
+	vector<VertexCoordinates> coordinates;
+	for (size_t v = 0; v < n; ++v) {
+		coordinates.push_back(VertexCoordinates{double(v % 17), double(v / 17)});
+	}
+
+	for (auto order : {VertexOrder::Input, VertexOrder::BreadthFirst, VertexOrder::DepthFirst,
+					   VertexOrder::Degree, VertexOrder::HilbertCurve}) {
+		WeightedGraph::Builder builder(n, m);
+		for (size_t i = 0; i < m; ++i) {
+			EdgeProperties properties;
+			graph::get<weight_t>(properties) = i;
+			builder.AddEdge(edges[i].first, edges[i].second, properties);
+		}
+		builder.Reorder(order, coordinates);
+		auto g = builder.Build();
+		const auto& permutation = g->Permutation();
+		EXPECT_EQ(order == VertexOrder::Input, permutation.IsIdentity());
+
+		vector<bool> isUsed(n, false);
+		for (size_t v = 0; v < n; ++v) {
+			auto internal = permutation.ToInternal(v);
+			ASSERT_LT(internal, n);
+			EXPECT_FALSE(isUsed[internal]);
+			isUsed[internal] = true;
+			EXPECT_EQ(v, permutation.ToExternal(internal));
+		}
+
+		auto weight = graph::get(weight_t(), *g);
+		for (size_t i = 0; i < m; ++i) {
+			auto from = permutation.ToInternal(edges[i].first);
+			auto to = permutation.ToInternal(edges[i].second);
+			bool isFound = false;
+			for (auto e : Range(out_edges(from, *g))) {
+				isFound |= target(e, *g) == to && graph::get(weight, e) == i;
+			}
+			EXPECT_TRUE(isFound);
+		}
+	}
+}
+
+TEST(GraphBuilder, HilbertCurveOrderVisitsNeighbourCells) {
+	// 16 x 16 grid: the curve moves between adjacent cells only
+	size_t side = 16;
+	vector<VertexCoordinates> coordinates;
+	for (size_t v = 0; v < side * side; ++v) {
+		coordinates.push_back(VertexCoordinates{double(v % side), double(v / side)});
+	}
+	auto internalIds = graph::detail::HilbertCurveOrder(coordinates);
+	vector<size_t> externalIds(internalIds.size());
+	for (size_t v = 0; v < internalIds.size(); ++v) {
+		externalIds[internalIds[v]] = v;
+	}
+	for (size_t i = 1; i < externalIds.size(); ++i) {
+		auto a = coordinates[externalIds[i - 1]];
+		auto b = coordinates[externalIds[i]];
+		EXPECT_EQ(1.0, std::abs(a.x - b.x) + std::abs(a.y - b.y));
+	}
+}
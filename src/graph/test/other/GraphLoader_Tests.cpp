@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <graph/static_graph.hpp>
+#include <graph/io.hpp>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <tuple>
+
+using namespace std;
+using namespace graph;
+using namespace graphUtil;
+
+namespace {
+	struct loader_weight_t {};
+	struct loader_direction_t {};
+
+	using WeightProperty = Property<loader_weight_t, uint32_t>;
+	using DirectionProperty = Property<loader_direction_t, char>;
+	using LoadedGraph = StaticGraph<Properties<>, Properties<WeightProperty>, ColumnLayoutTag>;
+	using DirectedGraph = StaticGraph<Properties<>, Properties<WeightProperty, DirectionProperty>, ColumnLayoutTag>;
+
+	const char* WriteRandomDdsg(const char* fileName, size_t n, size_t m) {
+		mt19937 generator(23);
+		uniform_int_distribution<size_t> vertexDistribution(0, n - 1);
+		ofstream output(fileName);
+		output << "d\n" << n << " " << m << "\n";
+		for (size_t i = 0; i < m; ++i) {
+			output << vertexDistribution(generator) << " " << vertexDistribution(generator) << " "
+				<< i + 1 << " " << i % 4 << "\n";
+		}
+		return fileName;
+	}
+
+	int DirectionOf(LoadedGraph&, const LoadedGraph::edge_descriptor&) {
+		return 0;
+	}
+
+	int DirectionOf(DirectedGraph& g, const DirectedGraph::edge_descriptor& e) {
+		return graph::get(graph::get(loader_direction_t(), g), e);
+	}
+
+	// (source, target, properties) of the out edges, the edge ids depend on the input order
+	template <typename Graph>
+	vector<tuple<size_t, size_t, uint32_t, int>> OutEdges(Graph& g) {
+		vector<tuple<size_t, size_t, uint32_t, int>> result;
+		auto weight = graph::get(loader_weight_t(), g);
+		for (auto v : Range(vertices(g))) {
+			for (auto e : Range(out_edges(v, g))) {
+				result.emplace_back(v, target(e, g), graph::get(weight, e), DirectionOf(g, e));
+			}
+		}
+		sort(result.begin(), result.end());
+		return result;
+	}
+}
+
+TEST(GraphLoader, DdsgMatchesReadDdsg) {
+	const char* fileName = WriteRandomDdsg("graph-loader-test.ddsg", 1000, 20000);
+	vector<pair<pair<size_t, size_t>, Properties<WeightProperty>>> input;
+	size_t n, m;
+	ASSERT_EQ(0, read_ddsg<WeightProperty>(back_inserter(input), n, m, fileName));
+	LoadedGraph expected(input.begin(), input.end(), n, input.size());
+
+	for (size_t threadsCount : {1, 3, 8}) {
+		auto loaded = load_ddsg<LoadedGraph, WeightProperty>(fileName, threadsCount);
+		ASSERT_NE(nullptr, loaded);
+		EXPECT_EQ(num_vertices(expected), num_vertices(*loaded));
+		EXPECT_EQ(num_edges(expected), num_edges(*loaded));
+		EXPECT_EQ(OutEdges(expected), OutEdges(*loaded));
+	}
+	remove(fileName);
+}
+
+TEST(GraphLoader, DdsgDirectionBits) {
+	const char* fileName = WriteRandomDdsg("graph-loader-directions.ddsg", 500, 5000);
+	vector<pair<pair<size_t, size_t>, Properties<WeightProperty, DirectionProperty>>> input;
+	size_t n, m;
+	ASSERT_EQ(0, (read_ddsg<WeightProperty, DirectionProperty>(back_inserter(input), n, m, fileName)));
+	DirectedGraph expected(input.begin(), input.end(), n, input.size());
+
+	auto loaded = load_ddsg<DirectedGraph, WeightProperty, DirectionProperty>(fileName, 4);
+	ASSERT_NE(nullptr, loaded);
+	EXPECT_EQ(num_edges(expected), num_edges(*loaded));
+	EXPECT_EQ(OutEdges(expected), OutEdges(*loaded));
+	remove(fileName);
+}
+
+TEST(GraphLoader, Dimacs) {
+	const char* fileName = "graph-loader-test.gr";
+	{
+		ofstream output(fileName);
+		output << "c 9th DIMACS\nc\np sp 4 5\na 1 2 10\na 2 3 20\nc between\na 3 4 30\na 4 1 40\na 1 3 50\n";
+	}
+	for (size_t threadsCount : {1, 2, 16}) {
+		auto loaded = load_dimacs<LoadedGraph, WeightProperty>(fileName, threadsCount);
+		ASSERT_NE(nullptr, loaded);
+		EXPECT_EQ(5u, num_vertices(*loaded));
+		vector<tuple<size_t, size_t, uint32_t, int>> expected = {
+			make_tuple(1, 2, 10, 0), make_tuple(1, 3, 50, 0), make_tuple(2, 3, 20, 0),
+			make_tuple(3, 4, 30, 0), make_tuple(4, 1, 40, 0)};
+		EXPECT_EQ(expected, OutEdges(*loaded));
+	}
+	remove(fileName);
+}
+
+TEST(GraphLoader, RejectsWrongFile) {
+	const char* fileName = "graph-loader-wrong.ddsg";
+	{
+		ofstream output(fileName);
+		output << "d\n3 2\n0 1 5 0\n1 2 5 7\n";
+	}
+	EXPECT_EQ(nullptr, (load_ddsg<LoadedGraph, WeightProperty>(fileName, 2)));
+	{
+		ofstream output(fileName);
+		output << "d\n3 1\n0 3 5 0\n";
+	}
+	EXPECT_EQ(nullptr, (load_ddsg<LoadedGraph, WeightProperty>(fileName, 2)));
+	EXPECT_EQ(nullptr, (load_dimacs<LoadedGraph, WeightProperty>(fileName, 2)));
+	EXPECT_EQ(nullptr, (load_ddsg<LoadedGraph, WeightProperty>("graph-loader-missing.ddsg")));
+	remove(fileName);
+}
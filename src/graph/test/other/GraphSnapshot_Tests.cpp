@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <graph/static_graph.hpp>
+#include <graph/static_graph_snapshot.hpp>
+#include <cstdio>
+#include <random>
+
+using namespace std;
+using namespace graph;
+using namespace graphUtil;
+
+namespace {
+	struct snapshot_distance_t {};
+	struct snapshot_weight_t {};
+	struct snapshot_edge_type_t {};
+
+	using SnapshotGraph = StaticGraph<
+		Properties<Property<snapshot_distance_t, uint32_t>>,
+		Properties<Property<snapshot_weight_t, uint32_t>, Property<snapshot_edge_type_t, char>>,
+		ColumnLayoutTag>;
+
+	std::unique_ptr<SnapshotGraph> BuildRandomGraph(size_t n, size_t m) {
+		mt19937 generator(7);
+		uniform_int_distribution<size_t> vertexDistribution(0, n - 1);
+		SnapshotGraph::Builder builder(n, m);
+		for (size_t i = 0; i < m; ++i) {
+			SnapshotGraph::edge_bundled properties;
+			graph::get<snapshot_weight_t>(properties) = i * 3;
+			graph::get<snapshot_edge_type_t>(properties) = static_cast<char>(i % 5);
+			builder.AddEdge(vertexDistribution(generator), vertexDistribution(generator), properties);
+		}
+		builder.Reorder(VertexOrder::BreadthFirst);
+		auto g = builder.Build();
+		auto distance = graph::get(snapshot_distance_t(), *g);
+		for (auto v : Range(vertices(*g))) {
+			graph::put(distance, v, v + 1);
+		}
+		return g;
+	}
+}
+
+TEST(GraphSnapshot, SaveLoad) {
+	const char* fileName = "graph-snapshot-test.bin";
+	auto original = BuildRandomGraph(500, 5000);
+	ASSERT_TRUE(SnapshotGraph::Snapshot::Save(*original, fileName));
+
+	auto loaded = SnapshotGraph::Snapshot::Load(fileName);
+	ASSERT_NE(nullptr, loaded);
+	EXPECT_EQ(num_vertices(*original), num_vertices(*loaded));
+	EXPECT_EQ(num_edges(*original), num_edges(*loaded));
+	EXPECT_FALSE(loaded->Permutation().IsIdentity());
+
+	auto originalDistance = graph::get(snapshot_distance_t(), *original);
+	auto loadedDistance = graph::get(snapshot_distance_t(), *loaded);
+	auto originalWeight = graph::get(snapshot_weight_t(), *original);
+	auto loadedWeight = graph::get(snapshot_weight_t(), *loaded);
+	auto loadedEdgeType = graph::get(snapshot_edge_type_t(), *loaded);
+	for (auto v : Range(vertices(*original))) {
+		EXPECT_EQ(original->Permutation().ToExternal(v), loaded->Permutation().ToExternal(v));
+		EXPECT_EQ(original->Permutation().ToInternal(v), loaded->Permutation().ToInternal(v));
+		EXPECT_EQ(graph::get(originalDistance, v), graph::get(loadedDistance, v));
+		auto originalOut = Range(out_edges(v, *original));
+		auto loadedOut = Range(out_edges(v, *loaded));
+		ASSERT_TRUE(std::equal(originalOut.begin(), originalOut.end(), loadedOut.begin(), loadedOut.end()));
+		auto originalIn = Range(in_edges(v, *original));
+		auto loadedIn = Range(in_edges(v, *loaded));
+		ASSERT_TRUE(std::equal(originalIn.begin(), originalIn.end(), loadedIn.begin(), loadedIn.end()));
+		for (auto e : loadedOut) {
+			EXPECT_EQ(graph::get(originalWeight, e), graph::get(loadedWeight, e));
+			EXPECT_EQ(e.id % 5, graph::get(loadedEdgeType, e));
+		}
+	}
+
+	// the mapping is private: writes stay in the process
+	graph::put(loadedDistance, 0, 0);
+	EXPECT_EQ(0u, graph::get(loadedDistance, 0));
+	auto reloaded = SnapshotGraph::Snapshot::Load(fileName);
+	ASSERT_NE(nullptr, reloaded);
+	EXPECT_EQ(1u, graph::get(graph::get(snapshot_distance_t(), *reloaded), 0));
+
+	remove(fileName);
+}
+
+TEST(GraphSnapshot, ForwardGraph) {
+	using ForwardGraph = ForwardStaticGraph<SnapshotGraph::vertex_bundled, SnapshotGraph::edge_bundled, ColumnLayoutTag>;
+	const char* fileName = "graph-snapshot-forward.bin";
+	auto original = BuildRandomGraph(200, 1000);
+	ForwardGraph forward(*original);
+	ASSERT_TRUE(ForwardGraph::Snapshot::Save(forward, fileName));
+
+	auto loaded = ForwardGraph::Snapshot::Load(fileName);
+	ASSERT_NE(nullptr, loaded);
+	for (auto v : Range(vertices(*original))) {
+		auto originalOut = Range(out_edges(v, *original));
+		auto loadedOut = Range(out_edges(v, *loaded));
+		ASSERT_TRUE(std::equal(originalOut.begin(), originalOut.end(), loadedOut.begin(), loadedOut.end()));
+	}
+	// the in links arrays are empty, so the bidirectional graph can not be loaded from it
+	EXPECT_EQ(nullptr, SnapshotGraph::Snapshot::Load(fileName));
+
+	remove(fileName);
+}
+
+TEST(GraphSnapshot, RejectsWrongFile) {
+	const char* fileName = "graph-snapshot-wrong.bin";
+	FILE* file = fopen(fileName, "wb");
+	ASSERT_NE(nullptr, file);
+	const char garbage[128] = "d 1 2 3";
+	fwrite(garbage, 1, sizeof(garbage), file);
+	fclose(file);
+
+	EXPECT_EQ(nullptr, SnapshotGraph::Snapshot::Load(fileName));
+	EXPECT_EQ(nullptr, SnapshotGraph::Snapshot::Load("graph-snapshot-missing.bin"));
+
+	remove(fileName);
+}
@@ -4,6 +4,11 @@
 #include <graph/queue/FibonacciHeapQueue.hpp>
 #include <graph/queue/D-aryHeapQueue.hpp>
 #include <graph/queue/SegmentTreeQueue.hpp>
+#include <graph/queue/DijkstraQueue.hpp>
+#include <graph/queue/RadixHeapQueue.hpp>
+#include <graph/queue/BucketQueue.hpp>
+#include <graph/queue/SimdDHeapQueue.hpp>
+#include <graph/queue/QueuePolicies.hpp>
 #include <graph/detail/util/Collection.hpp>
 #include <random>
 #include <type_traits>
@@ -130,6 +135,131 @@ void Queue_RandomTest(TQueue& queue) {
 	}
 }
 
+struct IdentityIndexMap {
+	using key_type = DataType;
+	using value_type = DataType;
+};
+
+DataType get(const IdentityIndexMap&, const DataType& key) {
+	return key;
+}
+
+// Dijkstra-like operations: the inserted and the decreased keys are not smaller than the last minimum,
+// a deleted item is never inserted again. Every search starts with Clear.
+template <typename TQueue>
+void MonotoneQueue_RandomTest(TQueue& queue) {
+	mt19937 generator(RandomSeed);
+	KeyDistribution stepDistribution(0, 1000);
+	IdentityIndexMap index;
+
+	for (auto search : Range(0, 3)) {
+		queue.Clear();
+		vector<KeyType> keys(TestItemsCount);
+		vector<char> state(TestItemsCount, 0);  // 0 - new, 1 - enqueued, 2 - deleted
+		set<pair<KeyType, DataType>> referenceQueue;
+		KeyType lastMin = 0;
+
+		for (auto iterationId : Range(0, 10 * TestItemsCount)) {
+			EXPECT_EQ(referenceQueue.empty(), queue.IsEmpty());
+			if (!queue.IsEmpty() && Probability(generator) < 0.4) {
+				auto minItem = queue.PeekMin();
+				EXPECT_EQ(referenceQueue.begin()->first, minItem.Distance);
+				EXPECT_EQ(1u, referenceQueue.erase(make_pair(minItem.Distance, minItem.Vertex)));
+				state[minItem.Vertex] = 2;
+				lastMin = minItem.Distance;
+				queue.DeleteMin();
+				continue;
+			}
+			DataType itemId = ItemIdDistribution(generator);
+			if (state[itemId] == 0) {
+				keys[itemId] = lastMin + stepDistribution(generator);
+				referenceQueue.insert(make_pair(keys[itemId], itemId));
+				queue.Insert(keys[itemId], itemId, index);
+				state[itemId] = 1;
+			}
+			else if (state[itemId] == 1 && keys[itemId] > lastMin) {
+				KeyType newKey = KeyDistribution(lastMin, keys[itemId] - 1)(generator);
+				referenceQueue.erase(make_pair(keys[itemId], itemId));
+				referenceQueue.insert(make_pair(newKey, itemId));
+				queue.DecreaseKey(newKey, itemId, index);
+				keys[itemId] = newKey;
+			}
+		}
+		while (!queue.IsEmpty()) {
+			EXPECT_EQ(referenceQueue.begin()->first, queue.PeekMin().Distance);
+			referenceQueue.erase(referenceQueue.begin());
+			queue.DeleteMin();
+		}
+		EXPECT_TRUE(referenceQueue.empty());
+	}
+}
+
+TEST(PriorityQueue, Dijkstra_Monotone) {
+	auto queue = DijkstraQueue<KeyType, DataType, IdentityIndexMap>(TestItemsCount);
+	MonotoneQueue_RandomTest(queue);
+}
+
+TEST(PriorityQueue, RadixHeap_Monotone) {
+	auto queue = RadixHeapQueue<KeyType, DataType, IdentityIndexMap>(TestItemsCount);
+	MonotoneQueue_RandomTest(queue);
+}
+
+TEST(PriorityQueue, Bucket_Monotone) {
+	auto queue = BucketQueue<KeyType, DataType, IdentityIndexMap>(TestItemsCount);
+	MonotoneQueue_RandomTest(queue);
+}
+
+TEST(PriorityQueue, Bucket_MaxKeyDelta_Monotone) {
+	auto queue = BucketQueue<KeyType, DataType, IdentityIndexMap>(TestItemsCount);
+	queue.SetMaxKeyDelta(1000);
+	MonotoneQueue_RandomTest(queue);
+}
+
+TEST(PriorityQueue, SimdDHeap_4_Monotone) {
+	auto queue = SimdDHeapQueue<KeyType, DataType, IdentityIndexMap, 4>(TestItemsCount);
+	MonotoneQueue_RandomTest(queue);
+}
+
+TEST(PriorityQueue, SimdDHeap_8_Monotone) {
+	auto queue = SimdDHeapQueue<KeyType, DataType, IdentityIndexMap, 8>(TestItemsCount);
+	MonotoneQueue_RandomTest(queue);
+}
+
+TEST(PriorityQueue, SimdDHeap_8_Wide_Monotone) {
+	auto queue = SimdDHeapQueue<uint64_t, DataType, IdentityIndexMap, 8>(TestItemsCount);
+	MonotoneQueue_RandomTest(queue);
+}
+
+template <typename Policy>
+void QueuePolicy_MonotoneTest() {
+	typename Policy::template QueueType<KeyType, DataType, IdentityIndexMap> queue(TestItemsCount);
+	MonotoneQueue_RandomTest(queue);
+}
+
+TEST(PriorityQueue, HeapPolicy_Monotone) {
+	QueuePolicy_MonotoneTest<HeapQueuePolicy>();
+}
+
+TEST(PriorityQueue, DHeapPolicy_Monotone) {
+	QueuePolicy_MonotoneTest<DHeapQueuePolicy<4>>();
+}
+
+TEST(PriorityQueue, FibonacciPolicy_Monotone) {
+	QueuePolicy_MonotoneTest<FibonacciHeapQueuePolicy>();
+}
+
+TEST(PriorityQueue, SegmentTreePolicy_Monotone) {
+	QueuePolicy_MonotoneTest<SegmentTreeQueuePolicy>();
+}
+
+TEST(PriorityQueue, NarySegmentTreePolicy_Monotone) {
+	QueuePolicy_MonotoneTest<NarySegmentTreeQueuePolicy<4>>();
+}
+
+TEST(PriorityQueue, SetPolicy_Monotone) {
+	QueuePolicy_MonotoneTest<SetQueuePolicy>();
+}
+
 TEST(PriorityQueue, Set_Sequential) {
 	auto queue = SetQueue<KeyType, DataType>();
 	Queue_SequentialTest(queue);
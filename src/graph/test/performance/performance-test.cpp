@@ -8,17 +8,24 @@
 #include <string>
 #include <boost/graph/graph_concepts.hpp>
 #include <graph/static_graph.hpp>
+#include <graph/compressed_static_graph.hpp>
 #include <graph/graph.hpp>
 #include <graph/properties.hpp>
 #include <graph/breadth_first_search.hpp>
 #include <graph/dijkstra.hpp>
 #include <graph/bidirectional_dijkstra.hpp>
+#include <graph/batch_query.hpp>
+#include <graph/delta_stepping.hpp>
+#include <graph/search_counters.hpp>
 #include <graph/io.hpp>
+#include <graph/io/FileReader.hpp>
+#include <graph/io/MappedFileReader.hpp>
 #include <fstream>
 #include <util/statistics.h>
 #include <test.h>
 #include <generator.hpp>
 #include <random>
+#include <iomanip>
 #include <chrono>
 
 using namespace std;
@@ -72,6 +79,30 @@ protected:
         m_statistics.close();
     }
 
+    // Compares the one-to-all distances from src with its .sssp file, distanceOf(v) is the distance
+    // of the vertex v of the file. Call it through ASSERT_NO_FATAL_FAILURE, a missing file fails the test
+    template <typename DistanceOf>
+    void VerifyOneToAll(size_t src, DistanceOf distanceOf) {
+        stringstream ss;
+        ss << m_path << "/" << m_baseName << "/" << m_baseName << "_" << src << ".sssp";
+        ifstream verificationFile(ss.str());
+        if (!verificationFile.is_open()) {
+            cerr << "Verification file " << ss.str() << " for the source " << src << " is not found." << endl;
+            FAIL();
+        };
+        size_t file_src, file_dist;
+        verificationFile >> file_src;
+        if (src != file_src) {
+            cerr << "Source in the file is different from the expected";
+            FAIL();
+        }
+        for (size_t v = 0; v < m_numOfNodes; ++v) {
+            verificationFile >> file_src >> file_dist;
+            EXPECT_EQ(file_src, v);
+            EXPECT_EQ(file_dist, distanceOf(v));
+        };
+    }
+
     using DdsgVecType = std::vector<std::pair<std::pair<size_t,size_t>,Properties<Property<weight_t, uint32_t>>>>;
     DdsgVecType m_ddsgVec;
     back_insert_iterator<DdsgVecType> m_ddsgVecBackInserter;
@@ -98,6 +129,62 @@ struct CorrectnessBFSVisitor
 };
 
 
+// Reads all the tokens of a .ddsg file, returns their sum to compare the readers
+template <typename Reader>
+uint64_t ReadDdsgTokens(const std::string& fileName, size_t& fileSize) {
+    Reader reader;
+    if (!reader.Open(fileName.c_str())) return 0;
+    uint64_t sum = reader.NextChar();
+    while (reader.HasNext()) sum += reader.NextUnsignedInt();
+    reader.Close();
+    ifstream file(fileName, ios::binary | ios::ate);
+    fileSize = file.tellg();
+    return sum;
+}
+
+TEST_P(DdsgGraphAlgorithm, ReaderThroughput) {
+    const std::string fileName = m_path + "/" + GetParam();
+    const int repetitions = 5;
+    size_t fileSize = 0;
+    uint64_t expected = ReadDdsgTokens<graphIO::FileReader>(fileName, fileSize);
+    auto measure = [&](auto read, const char* name) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < repetitions; ++i) EXPECT_EQ(expected, read());
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = chrono::duration<double>(end - start).count();
+        cout << name << ": " << repetitions * fileSize / seconds / (1 << 20) << " MB/s" << endl;
+    };
+    measure([&] { return ReadDdsgTokens<graphIO::FileReader>(fileName, fileSize); }, "FileReader");
+    measure([&] { return ReadDdsgTokens<graphIO::MappedFileReader>(fileName, fileSize); }, "MappedFileReader");
+};
+
+TEST_P(DdsgGraphAlgorithm, DdsgLoadTime) {
+    using Graph = GenerateDijkstraGraph<predecessor_t, distance_t, weight_t,
+        vertex_index_t, color_t, Properties<>, Properties<>>::type;
+    const std::string fileName = m_path + "/" + GetParam();
+    auto start = std::chrono::high_resolution_clock::now();
+    DdsgVecType ddsgVec;
+    size_t numOfNodes, numOfEdges;
+    ASSERT_EQ(0, (read_ddsg<Property<weight_t, uint32_t>>(back_inserter(ddsgVec), numOfNodes, numOfEdges, fileName.c_str())));
+    std::stable_sort(ddsgVec.begin(), ddsgVec.end(),
+        [&](DdsgVecType::value_type left, DdsgVecType::value_type right) {
+        return left.first.first < right.first.first;
+    });
+    Graph expected(ddsgVec.begin(), ddsgVec.end(), numOfNodes, ddsgVec.size());
+    auto end = std::chrono::high_resolution_clock::now();
+    cout << "read_ddsg and constructor: " << chrono::duration_cast<chrono::microseconds>(end - start).count() << " us" << endl;
+
+    for (size_t threadsCount : {size_t(1), graphUtil::DefaultThreadsCount()}) {
+        start = std::chrono::high_resolution_clock::now();
+        auto loaded = load_ddsg<Graph, Property<weight_t, uint32_t>>(fileName.c_str(), threadsCount);
+        end = std::chrono::high_resolution_clock::now();
+        ASSERT_NE(nullptr, loaded);
+        EXPECT_EQ(num_edges(expected), num_edges(*loaded));
+        cout << "load_ddsg on " << threadsCount << " threads: "
+            << chrono::duration_cast<chrono::microseconds>(end - start).count() << " us" << endl;
+    }
+};
+
 TEST_P(DdsgGraphAlgorithm, BFSCorrectness) {
     using  Graph = GenerateBFSGraph<color_t,
         Properties<Property<distance_t, uint32_t>>,
@@ -163,42 +250,288 @@ TEST_P(DdsgGraphAlgorithm, DijkstraOne2All) {
     auto weight = graph::get(weight_t(), graph);
     auto vertex_index = graph::get(vertex_index_t(), graph);
     auto color = graph::get(color_t(), graph);
-    ifstream verificationFile;
-    graph::DefaultDijkstraVisitor<Graph> visitor;
+    graph::CountingDijkstraVisitor<Graph> visitor;
     for (size_t src:m_sources) {
 //        cout << "Testing source " << src << endl;
+        visitor.GetCounters().Reset();
         start = std::chrono::high_resolution_clock::now();
         dijkstra(graph, graph_traits<Graph>::vertex_descriptor(src), predecessor,
             distance, weight, vertex_index, color, visitor);
         end = std::chrono::high_resolution_clock::now();
-        DijkstraOneToAllSPStatistics statistics(
+        SearchSpaceStatistics<DijkstraOneToAllSPStatistics> statistics(
+            DijkstraOneToAllSPStatistics(
+                GeneralStatistics(m_baseName, Algorithm::dijkstra, Phase::query, Metric::time,
+                    m_numOfNodes, m_numOfEdges,
+                    chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0),
+                src),
+            visitor.GetCounters());
+        m_statistics << statistics << endl;
+        ASSERT_NO_FATAL_FAILURE(VerifyOneToAll(src, [&](size_t v) {
+            EnsureVertexInitialization(graph, v, predecessor, distance, vertex_index, color, visitor);
+            return get(distance, v);
+        }));
+    };
+};
+
+TEST_P(DdsgGraphAlgorithm, DijkstraVertexOrderings) {
+    using Graph = GenerateDijkstraGraph<predecessor_t, distance_t, weight_t,
+        vertex_index_t, color_t, Properties<>, Properties< >> ::type;
+    // DDSG files have no coordinates, so the Hilbert curve order is not measured here
+    const std::vector<std::pair<VertexOrder, std::string>> orderings = {
+        {VertexOrder::Input, "input"}, {VertexOrder::BreadthFirst, "bfs"},
+        {VertexOrder::DepthFirst, "dfs"}, {VertexOrder::Degree, "degree"}};
+    std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+    for (const auto& ordering : orderings) {
+        Graph::Builder builder(m_numOfNodes, m_ddsgVec.size());
+        for (const auto& edge : m_ddsgVec)
+            builder.AddEdge(edge.first.first, edge.first.second, edge.second);
+        builder.Reorder(ordering.first);
+        auto graph = builder.Build();
+        const auto& permutation = graph->Permutation();
+        auto predecessor = graph::get(predecessor_t(), *graph);
+        auto distance = graph::get(distance_t(), *graph);
+        auto weight = graph::get(weight_t(), *graph);
+        auto vertex_index = graph::get(vertex_index_t(), *graph);
+        auto color = graph::get(color_t(), *graph);
+        graph::DefaultDijkstraVisitor<Graph> visitor;
+        uint64_t totalTime = 0;
+        for (size_t src : m_sources) {
+            start = std::chrono::high_resolution_clock::now();
+            dijkstra(*graph, permutation.ToInternal(src), predecessor,
+                distance, weight, vertex_index, color, visitor);
+            end = std::chrono::high_resolution_clock::now();
+            totalTime += chrono::duration_cast<chrono::microseconds>(end - start).count();
+            VertexOrderingStatistics statistics(DijkstraOneToAllSPStatistics(
+                GeneralStatistics(m_baseName, Algorithm::dijkstra, Phase::query, Metric::time,
+                    m_numOfNodes, m_numOfEdges, chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0),
+                src), ordering.second);
+            m_statistics << statistics << endl;
+            ASSERT_NO_FATAL_FAILURE(VerifyOneToAll(src, [&](size_t v) {
+                auto internal = permutation.ToInternal(v);
+                EnsureVertexInitialization(*graph, internal, predecessor, distance, vertex_index, color, visitor);
+                return get(distance, internal);
+            }));
+        }
+        cout << ordering.second << " order: " << totalTime << " us for " << m_sources.size() << " sources" << endl;
+    }
+};
+
+TEST_P(DdsgGraphAlgorithm, DijkstraForwardGraph) {
+    using Graph = GenerateDijkstraGraph<predecessor_t, distance_t, weight_t,
+        vertex_index_t, color_t, Properties<>, Properties<>, ColumnLayoutTag, ForwardLinksTag>::type;
+    Graph graph(m_ddsgVec.begin(), m_ddsgVec.end(), m_numOfNodes, m_numOfEdges);
+    auto predecessor = graph::get(predecessor_t(), graph);
+    auto distance = graph::get(distance_t(), graph);
+    auto weight = graph::get(weight_t(), graph);
+    auto vertex_index = graph::get(vertex_index_t(), graph);
+    auto color = graph::get(color_t(), graph);
+    graph::DefaultDijkstraVisitor<Graph> visitor;
+    std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+    uint64_t totalTime = 0;
+    for (size_t src : m_sources) {
+        start = std::chrono::high_resolution_clock::now();
+        dijkstra(graph, graph_traits<Graph>::vertex_descriptor(src), predecessor,
+            distance, weight, vertex_index, color, visitor);
+        end = std::chrono::high_resolution_clock::now();
+        totalTime += chrono::duration_cast<chrono::microseconds>(end - start).count();
+        RepresentationStatistics<DijkstraOneToAllSPStatistics> statistics(DijkstraOneToAllSPStatistics(
             GeneralStatistics(m_baseName, Algorithm::dijkstra, Phase::query, Metric::time,
-                m_numOfNodes, m_numOfEdges,
-                chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0),
-            src);
+                m_numOfNodes, m_numOfEdges, chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0),
+            src), "forward");
         m_statistics << statistics << endl;
-        stringstream ss;
-        ss << m_path << "/" << m_baseName << "/" << m_baseName << "_" << src << ".sssp";
-        verificationFile.open(ss.str());
-        if (!verificationFile.is_open()) {
-            cerr << "Verification file " << ss.str() << " for the source " << src << " is not found." << endl;
-            FAIL();
-        };
-        size_t file_src, file_dist;
-        verificationFile >> file_src;
-        if (src != file_src) {
-            cerr << "Source in the file is different from the expected";
-            FAIL();
+        ASSERT_NO_FATAL_FAILURE(VerifyOneToAll(src, [&](size_t v) {
+            EnsureVertexInitialization(graph, v, predecessor, distance, vertex_index, color, visitor);
+            return get(distance, v);
+        }));
+    }
+    cout << "forward graph: " << totalTime << " us for " << m_sources.size() << " sources" << endl;
+};
+
+TEST_P(DdsgGraphAlgorithm, DijkstraQueues) {
+    using Graph = GenerateDijkstraGraph<predecessor_t, distance_t, weight_t,
+        vertex_index_t, color_t, Properties<>, Properties<>>::type;
+    using Vertex = graph_traits<Graph>::vertex_descriptor;
+    Graph graph(m_ddsgVec.begin(), m_ddsgVec.end(), m_numOfNodes, m_numOfEdges);
+    auto predecessor = graph::get(predecessor_t(), graph);
+    auto distance = graph::get(distance_t(), graph);
+    auto weight = graph::get(weight_t(), graph);
+    auto vertex_index = graph::get(vertex_index_t(), graph);
+    auto color = graph::get(color_t(), graph);
+    const Graph& sharedGraph = graph;
+
+    mt19937 generator(3561237589);
+    uniform_int_distribution<Vertex> vertexDistribution(0, num_vertices(graph) - 1);
+    vector<pair<Vertex, Vertex>> queries;
+    for (auto it : graphUtil::Range(0, 1000)) {
+        queries.push_back(make_pair(vertexDistribution(generator), vertexDistribution(generator)));
+    }
+
+    // the distances of the first queue are the reference for the others
+    vector<vector<uint32_t>> expectedOneToAll;
+    vector<uint32_t> expectedPointToPoint;
+    auto measure = [&](auto policy, const char* name) {
+        using QueuePolicy = decltype(policy);
+        DefaultDijkstraVisitor<Graph, QueuePolicy> visitor;
+        uint64_t oneToAllTime = 0;
+        for (size_t i = 0; i < m_sources.size(); ++i) {
+            auto start = chrono::high_resolution_clock::now();
+            dijkstra(graph, Vertex(m_sources[i]), predecessor, distance, weight, vertex_index, color, visitor);
+            auto end = chrono::high_resolution_clock::now();
+            oneToAllTime += chrono::duration_cast<chrono::microseconds>(end - start).count();
+            QueueStatistics<DijkstraOneToAllSPStatistics> statistics(DijkstraOneToAllSPStatistics(
+                GeneralStatistics(m_baseName, Algorithm::dijkstra, Phase::query, Metric::time,
+                    m_numOfNodes, m_numOfEdges, chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0),
+                m_sources[i]), name);
+            m_statistics << statistics << endl;
+
+            vector<uint32_t> distances(num_vertices(graph));
+            for (auto v : graphUtil::Range(vertices(graph))) {
+                EnsureVertexInitialization(graph, v, predecessor, distance, vertex_index, color, visitor);
+                distances[v] = get(distance, v);
+            }
+            if (expectedOneToAll.size() == i) expectedOneToAll.push_back(distances);
+            EXPECT_EQ(expectedOneToAll[i], distances) << name << " from " << m_sources[i];
         }
-        auto vRange = vertices(graph);
-        for (auto vIt = vRange.first; vIt != vRange.second; ++vIt) {
-			EnsureVertexInitialization(graph, *vIt, predecessor, distance, vertex_index, color, visitor);
-            verificationFile >> file_src >> file_dist;
-            EXPECT_EQ(file_src, *vIt);
-            EXPECT_EQ(file_dist, get(distance, *vIt));
-        };
-        verificationFile.close();
+
+        using Engine = DijkstraQueryEngine<Graph, decltype(weight), decltype(vertex_index), QueuePolicy>;
+        BatchQueryExecutor<Engine> executor(Engine(sharedGraph, weight, vertex_index), 1);
+        auto result = executor.Run(queries);
+        QueueStatistics<BatchQueryStatistics> statistics(BatchQueryStatistics(
+            GeneralStatistics(m_baseName, Algorithm::dijkstraPtoP, Phase::query, Metric::time,
+                m_numOfNodes, m_numOfEdges, result.WallTime / 1000000, 0),
+            1, result.Throughput(), result.Latencies), name);
+        m_statistics << statistics << endl;
+        if (expectedPointToPoint.empty()) expectedPointToPoint = result.Distances;
+        EXPECT_EQ(expectedPointToPoint, result.Distances) << name;
+
+        cout << setw(20) << left << name << setw(12) << right << oneToAllTime
+            << setw(12) << result.WallTime / 1000 << endl;
     };
+
+    cout << setw(20) << left << "queue" << setw(12) << right << "1-to-all us"
+        << setw(12) << "p2p us" << "   (" << m_sources.size() << " sources, "
+        << queries.size() << " queries)" << endl;
+    measure(graph::queue::DijkstraQueuePolicy(), "DijkstraQueue");
+    measure(graph::queue::RadixHeapQueuePolicy(), "RadixHeapQueue");
+    measure(graph::queue::BucketQueuePolicy(), "BucketQueue");
+    measure(graph::queue::HeapQueuePolicy(), "HeapQueue");
+    measure(graph::queue::DHeapQueuePolicy<2>(), "DHeapQueue<2>");
+    measure(graph::queue::DHeapQueuePolicy<4>(), "DHeapQueue<4>");
+    measure(graph::queue::DHeapQueuePolicy<8>(), "DHeapQueue<8>");
+    measure(graph::queue::SimdDHeapQueuePolicy<4>(), "SimdDHeapQueue<4>");
+    measure(graph::queue::SimdDHeapQueuePolicy<8>(), "SimdDHeapQueue<8>");
+    measure(graph::queue::FibonacciHeapQueuePolicy(), "FibonacciHeapQueue");
+    measure(graph::queue::SegmentTreeQueuePolicy(), "SegmentTreeQueue");
+    measure(graph::queue::NarySegmentTreeQueuePolicy<4>(), "NarySegmentTree<4>");
+    measure(graph::queue::SetQueuePolicy(), "SetQueue");
+};
+
+TEST_P(DdsgGraphAlgorithm, DijkstraBucketQueue) {
+    using Graph = GenerateDijkstraGraph<predecessor_t, distance_t, weight_t,
+        vertex_index_t, color_t, Properties<>, Properties<>>::type;
+    Graph graph(m_ddsgVec.begin(), m_ddsgVec.end(), m_numOfNodes, m_numOfEdges);
+    auto predecessor = graph::get(predecessor_t(), graph);
+    auto distance = graph::get(distance_t(), graph);
+    auto weight = graph::get(weight_t(), graph);
+    auto vertex_index = graph::get(vertex_index_t(), graph);
+    auto color = graph::get(color_t(), graph);
+    auto maxWeight = max_edge_weight(graph, weight);
+    BucketDijkstraVisitor<Graph> visitor(maxWeight);
+    std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+    uint64_t totalTime = 0;
+    for (size_t src : m_sources) {
+        start = std::chrono::high_resolution_clock::now();
+        dijkstra(graph, graph_traits<Graph>::vertex_descriptor(src), predecessor, distance, weight, vertex_index, color, visitor);
+        end = std::chrono::high_resolution_clock::now();
+        totalTime += chrono::duration_cast<chrono::microseconds>(end - start).count();
+        QueueStatistics<DijkstraOneToAllSPStatistics> statistics(DijkstraOneToAllSPStatistics(
+            GeneralStatistics(m_baseName, Algorithm::dijkstra, Phase::query, Metric::time,
+                m_numOfNodes, m_numOfEdges, chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0),
+            src), "DialBucketQueue");
+        m_statistics << statistics << endl;
+        ASSERT_NO_FATAL_FAILURE(VerifyOneToAll(src, [&](size_t v) {
+            EnsureVertexInitialization(graph, v, predecessor, distance, vertex_index, color, visitor);
+            return get(distance, v);
+        }));
+    }
+    cout << "bucket queue, max weight " << maxWeight << ": " << totalTime << " us for "
+        << m_sources.size() << " sources" << endl;
+};
+
+TEST_P(DdsgGraphAlgorithm, DijkstraCompressedGraph) {
+    using Graph = GenerateDijkstraGraph<predecessor_t, distance_t, weight_t,
+        vertex_index_t, color_t, Properties<>, Properties< >> ::type;
+    using CompressedGraph = CompressedStaticGraph<Graph::vertex_bundled, Graph::edge_bundled, Graph::layout_category>;
+    // encoded from the builder edges, the StaticGraph is never built
+    CompressedGraph compressed(m_ddsgVec.begin(), m_ddsgVec.end(), m_numOfNodes, m_numOfEdges);
+    auto predecessor = graph::get(predecessor_t(), compressed);
+    auto distance = graph::get(distance_t(), compressed);
+    auto weight = graph::get(weight_t(), compressed);
+    auto vertex_index = graph::get(vertex_index_t(), compressed);
+    auto color = graph::get(color_t(), compressed);
+    graph::DefaultDijkstraVisitor<CompressedGraph> visitor;
+    std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+    uint64_t totalTime = 0;
+    for (size_t src : m_sources) {
+        start = std::chrono::high_resolution_clock::now();
+        dijkstra(compressed, graph_traits<CompressedGraph>::vertex_descriptor(src), predecessor,
+            distance, weight, vertex_index, color, visitor);
+        end = std::chrono::high_resolution_clock::now();
+        totalTime += chrono::duration_cast<chrono::microseconds>(end - start).count();
+        RepresentationStatistics<DijkstraOneToAllSPStatistics> statistics(DijkstraOneToAllSPStatistics(
+            GeneralStatistics(m_baseName, Algorithm::dijkstra, Phase::query, Metric::time,
+                m_numOfNodes, m_numOfEdges, chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0),
+            src), "compressed");
+        m_statistics << statistics << endl;
+        ASSERT_NO_FATAL_FAILURE(VerifyOneToAll(src, [&](size_t v) {
+            EnsureVertexInitialization(compressed, v, predecessor, distance, vertex_index, color, visitor);
+            return get(distance, v);
+        }));
+    }
+    // CSR links are 8 bytes each plus 4 bytes per offset
+    size_t csrBytes = 2 * (8 * num_edges(compressed) + 4 * (num_vertices(compressed) + 1));
+    cout << "compressed adjacencies: " << compressed.AdjacencyBytes() << " bytes (CSR " << csrBytes << "), "
+        << totalTime << " us for " << m_sources.size() << " sources" << endl;
+};
+
+TEST_P(DdsgGraphAlgorithm, DeltaSteppingScaling) {
+    using Graph = GenerateDijkstraGraph<predecessor_t, distance_t, weight_t,
+        vertex_index_t, color_t, Properties<>, Properties<>>::type;
+    using Vertex = graph_traits<Graph>::vertex_descriptor;
+    Graph graph(m_ddsgVec.begin(), m_ddsgVec.end(), m_numOfNodes, m_numOfEdges);
+    auto predecessor = graph::get(predecessor_t(), graph);
+    auto distance = graph::get(distance_t(), graph);
+    auto weight = graph::get(weight_t(), graph);
+    auto vertex_index = graph::get(vertex_index_t(), graph);
+    const Graph& sharedGraph = graph;
+
+    // strong scaling: the same sources on 1, 2, 4, ... threads up to the hardware threads
+    std::vector<size_t> threadCounts;
+    for (size_t threadsCount = 1; threadsCount < graphUtil::DefaultThreadsCount(); threadsCount *= 2)
+        threadCounts.push_back(threadsCount);
+    threadCounts.push_back(graphUtil::DefaultThreadsCount());
+    uint64_t sequentialTime = 0;
+    for (size_t threadsCount : threadCounts) {
+        DeltaStepping<Graph, decltype(weight), decltype(vertex_index)> engine(
+            sharedGraph, weight, vertex_index, 0, threadsCount);
+        uint64_t totalTime = 0;
+        for (size_t src : m_sources) {
+            auto start = chrono::high_resolution_clock::now();
+            engine.Run(Vertex(src), predecessor, distance);
+            auto end = chrono::high_resolution_clock::now();
+            totalTime += chrono::duration_cast<chrono::microseconds>(end - start).count();
+            ParallelOneToAllSPStatistics statistics(DijkstraOneToAllSPStatistics(
+                GeneralStatistics(m_baseName, Algorithm::deltaStepping, Phase::query, Metric::time,
+                    m_numOfNodes, m_numOfEdges, chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0),
+                src), threadsCount);
+            m_statistics << statistics << endl;
+            ASSERT_NO_FATAL_FAILURE(VerifyOneToAll(src, [&](size_t v) { return get(distance, v); }));
+        }
+        if (threadsCount == 1) sequentialTime = totalTime;
+        cout << "delta-stepping, delta " << engine.Delta() << ", " << threadsCount << " threads: "
+            << totalTime << " us for " << m_sources.size() << " sources, speedup "
+            << (totalTime == 0 ? 0 : double(sequentialTime) / totalTime) << endl;
+    }
 };
 
 TEST_P(DdsgGraphAlgorithm, BiDijkstra) {
@@ -224,19 +557,25 @@ TEST_P(DdsgGraphAlgorithm, BiDijkstra) {
         cerr << "Verification file " << ss.str() <<" is not found." << endl;
         FAIL();
     };
-    DefaultDijkstraVisitor<Graph> visitorF;
-    DefaultDijkstraVisitor<Graph> visitorB;    
+    CountingDijkstraVisitor<Graph> visitorF;
+    CountingDijkstraVisitor<Graph> visitorB;
     while (verificationFile>>src>>tgt>>distance) {
 //        cout << "Running BiDijkstra from " << src << " to " << tgt << endl;
+        visitorF.GetCounters().Reset();
+        visitorB.GetCounters().Reset();
         start = std::chrono::high_resolution_clock::now();
         bidirectional_dijkstra(graph, graph_traits<Graph>::vertex_descriptor(src),
         graph_traits<Graph>::vertex_descriptor(tgt),predecessorF, predecessorB,
         distanceF, distanceB, weight, vertex_index, colorF,colorB, visitorF, visitorB);
         end = std::chrono::high_resolution_clock::now();
-        DijkstraSSSPStatistics statistics(
-            GeneralStatistics(m_baseName, Algorithm::biDijkstra, Phase::query, Metric::time,
-                m_numOfNodes, m_numOfEdges, chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0),
-            src,tgt,distance);
+        SearchCounters counters = visitorF.GetCounters();
+        counters += visitorB.GetCounters();
+        SearchSpaceStatistics<DijkstraSSSPStatistics> statistics(
+            DijkstraSSSPStatistics(
+                GeneralStatistics(m_baseName, Algorithm::biDijkstra, Phase::query, Metric::time,
+                    m_numOfNodes, m_numOfEdges, chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0),
+                src,tgt,distance),
+            counters);
         m_statistics << statistics << endl;
         EXPECT_EQ(distance, get(distanceF, tgt));
     }
@@ -280,10 +619,96 @@ TEST_P(DdsgGraphAlgorithm, BiDijkstraRandomQueries) {
 	cout <<  timeElapsed << endl;
 };
 
+TEST_P(DdsgGraphAlgorithm, BatchQueries) {
+    using Graph = GenerateDijkstraGraph<predecessor_t, distance_t, weight_t,
+        vertex_index_t, color_t, Properties<>, Properties<>> ::type;
+    using Vertex = graph_traits<Graph>::vertex_descriptor;
+    Graph graph(m_ddsgVec.begin(), m_ddsgVec.end(), m_numOfNodes, m_numOfEdges);
+    auto weight = graph::get(weight_t(), graph);
+    auto vertex_index = graph::get(vertex_index_t(), graph);
+    const Graph& sharedGraph = graph;
+
+    mt19937 generator(3561237589);
+    uniform_int_distribution<Vertex> vertexDistribution(0, num_vertices(graph) - 1);
+    vector<pair<Vertex, Vertex>> queries;
+    for (auto it : graphUtil::Range(0, 1000)) {
+        queries.push_back(make_pair(vertexDistribution(generator), vertexDistribution(generator)));
+    }
+
+    using DijkstraEngine = DijkstraQueryEngine<Graph, decltype(weight), decltype(vertex_index)>;
+    using BidirectionalEngine = BidirectionalDijkstraQueryEngine<Graph, decltype(weight), decltype(vertex_index)>;
+    vector<uint32_t> expected;
+    auto report = [&](Algorithm algorithm, size_t threadsCount, const BatchQueryResult<Vertex, uint32_t>& result) {
+        BatchQueryStatistics statistics(
+            GeneralStatistics(m_baseName, algorithm, Phase::query, Metric::time,
+                m_numOfNodes, m_numOfEdges, result.WallTime / 1000000, 0),
+            threadsCount, result.Throughput(), result.Latencies);
+        m_statistics << statistics << endl;
+        cout << statistics << endl;
+        if (expected.empty()) expected = result.Distances;
+        EXPECT_EQ(expected, result.Distances);
+    };
+    for (size_t threadsCount : {size_t(1), graphUtil::DefaultThreadsCount()}) {
+        BatchQueryExecutor<DijkstraEngine> dijkstraExecutor(
+            DijkstraEngine(sharedGraph, weight, vertex_index), threadsCount);
+        report(Algorithm::dijkstraPtoP, threadsCount, dijkstraExecutor.Run(queries));
+        BatchQueryExecutor<BidirectionalEngine> bidirectionalExecutor(
+            BidirectionalEngine(sharedGraph, weight, vertex_index), threadsCount);
+        report(Algorithm::biDijkstra, threadsCount, bidirectionalExecutor.Run(queries));
+    }
+};
+
+// The SIMD heaps against DijkstraQueue on the large graphs only, the other tests stay on the small ones
+class LargeDdsgGraphAlgorithm : public DdsgGraphAlgorithm {};
+
+TEST_P(LargeDdsgGraphAlgorithm, DijkstraSimdHeaps) {
+    using Graph = GenerateDijkstraGraph<predecessor_t, distance_t, weight_t,
+        vertex_index_t, color_t, Properties<>, Properties<>>::type;
+    using Vertex = graph_traits<Graph>::vertex_descriptor;
+    Graph graph(m_ddsgVec.begin(), m_ddsgVec.end(), m_numOfNodes, m_numOfEdges);
+    auto predecessor = graph::get(predecessor_t(), graph);
+    auto distance = graph::get(distance_t(), graph);
+    auto weight = graph::get(weight_t(), graph);
+    auto vertex_index = graph::get(vertex_index_t(), graph);
+    auto color = graph::get(color_t(), graph);
+
+    // the distances of DijkstraQueue are the reference for the heaps
+    vector<vector<uint32_t>> expected;
+    auto measure = [&](auto policy, const char* name) {
+        DefaultDijkstraVisitor<Graph, decltype(policy)> visitor;
+        uint64_t totalTime = 0;
+        for (size_t i = 0; i < m_sources.size(); ++i) {
+            auto start = chrono::high_resolution_clock::now();
+            dijkstra(graph, Vertex(m_sources[i]), predecessor, distance, weight, vertex_index, color, visitor);
+            auto end = chrono::high_resolution_clock::now();
+            totalTime += chrono::duration_cast<chrono::microseconds>(end - start).count();
+            QueueStatistics<DijkstraOneToAllSPStatistics> statistics(DijkstraOneToAllSPStatistics(
+                GeneralStatistics(m_baseName, Algorithm::dijkstra, Phase::query, Metric::time,
+                    m_numOfNodes, m_numOfEdges, chrono::duration_cast<chrono::milliseconds>(end - start).count(), 0),
+                m_sources[i]), name);
+            m_statistics << statistics << endl;
+
+            vector<uint32_t> distances(num_vertices(graph));
+            for (auto v : graphUtil::Range(vertices(graph))) {
+                EnsureVertexInitialization(graph, v, predecessor, distance, vertex_index, color, visitor);
+                distances[v] = get(distance, v);
+            }
+            if (expected.size() == i) expected.push_back(distances);
+            EXPECT_EQ(expected[i], distances) << name << " from " << m_sources[i];
+        }
+        cout << name << ": " << totalTime << " us for " << m_sources.size() << " sources" << endl;
+    };
+    measure(graph::queue::DijkstraQueuePolicy(), "DijkstraQueue");
+    measure(graph::queue::SimdDHeapQueuePolicy<4>(), "SimdDHeapQueue<4>");
+    measure(graph::queue::SimdDHeapQueuePolicy<8>(), "SimdDHeapQueue<8>");
+};
 
 INSTANTIATE_TEST_CASE_P(CommandLine, DdsgGraphAlgorithm,
     ::testing::Values("arc.ddsg", "bel.ddsg"));
 
+INSTANTIATE_TEST_CASE_P(CommandLine, LargeDdsgGraphAlgorithm,
+    ::testing::Values("deu.ddsg"));
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     if (argc >= 2) globalPathToFiles = argv[1]; 
@@ -2,16 +2,24 @@
 #include <utility>
 #include <cassert>
 #include <queue>
+#include <random>
+#include <thread>
 #include <gtest/gtest.h>
 #include <boost/graph/graph_concepts.hpp>
 #include <graph/static_graph.hpp>
+#include <graph/compressed_static_graph.hpp>
 #include <graph/graph.hpp>
 #include <graph/properties.hpp>
 #include <graph/breadth_first_search.hpp>
 #include <graph/dijkstra.hpp>
 #include <graph/bidirectional_dijkstra.hpp>
+#include <graph/batch_query.hpp>
+#include <graph/delta_stepping.hpp>
+#include <graph/multi_source_dijkstra.hpp>
+#include <graph/search_counters.hpp>
 #include <graph/io.hpp>
 #include <generator.hpp>
+#include <util/random_graph.h>
 
 using namespace std;
 using namespace graph;
@@ -71,6 +79,80 @@ TEST(PropertyGraph, InternalColorEdgeTypeProperties) {
         graph::property_map<Graph, edge_type_t>::type::key_type>));
 };
 
+TEST(PropertyGraph, ColumnLayoutProperties) {
+    using Graph = StaticGraph<BFSBundledVertexProperties, BFSBundledEdgeProperties, ColumnLayoutTag>;
+
+    BOOST_CONCEPT_ASSERT((boost::ReadWritePropertyMapConcept<
+        graph::property_map<Graph, graph::vertex_bundle_t>::type,
+        graph::property_map<Graph, graph::vertex_bundle_t>::type::key_type>));
+    BOOST_CONCEPT_ASSERT((boost::ReadWritePropertyMapConcept<
+        graph::property_map<Graph, color_t>::type,
+        graph::property_map<Graph, color_t>::type::key_type>));
+    BOOST_CONCEPT_ASSERT((boost::ReadWritePropertyMapConcept<
+        graph::property_map<Graph, distance_t>::type,
+        graph::property_map<Graph, distance_t>::type::key_type>));
+};
+
+TEST(PropertyGraph, ColumnLayoutMatchesRowLayout) {
+    using RowGraph = StaticGraph<BFSBundledVertexProperties, BFSBundledEdgeProperties, RowLayoutTag>;
+    using ColumnGraph = StaticGraph<BFSBundledVertexProperties, BFSBundledEdgeProperties, ColumnLayoutTag>;
+
+    const size_t n = 1 << 4;
+    vector<pair<size_t, size_t>> input;
+    back_insert_iterator<vector<pair<size_t, size_t>>> backInserter(input);
+    generate_list_graph(backInserter, n);
+    RowGraph rowGraph(input.begin(), input.end(), n);
+    ColumnGraph columnGraph(input.begin(), input.end(), n);
+
+    auto rowDistance = graph::get(distance_t(), rowGraph);
+    auto columnDistance = graph::get(distance_t(), columnGraph);
+    auto columnColor = graph::get(color_t(), columnGraph);
+    auto columnBundle = graph::get(vertex_bundle_t(), columnGraph);
+    for (auto v : graphUtil::Range(vertices(columnGraph))) {
+        graph::put(rowDistance, v, 3 * v);
+        graph::put(columnDistance, v, 3 * v);
+        graph::put(columnColor, v, static_cast<char>(v % 3));
+    }
+    for (auto v : graphUtil::Range(vertices(columnGraph))) {
+        EXPECT_EQ(graph::get(rowDistance, v), graph::get(columnDistance, v));
+        auto bundle = graph::get(columnBundle, v);
+        EXPECT_EQ(3 * v, graph::get<distance_t>(bundle));
+        EXPECT_EQ(v % 3, graph::get<color_t>(bundle));
+
+        graph::get<distance_t>(bundle) = v;
+        graph::put(columnBundle, v, bundle);
+        EXPECT_EQ(v, graph::get(columnDistance, v));
+    }
+};
+
+TEST(PropertyGraph, EdgePropertiesSharedByInAndOutLinks) {
+    using Graph = StaticGraph<BFSBundledVertexProperties, BFSBundledEdgeProperties, ColumnLayoutTag>;
+
+    BOOST_CONCEPT_ASSERT((boost::ReadWritePropertyMapConcept<
+        graph::property_map<Graph, edge_type_t>::type,
+        graph::property_map<Graph, edge_type_t>::type::key_type>));
+
+    const size_t n = 1 << 4;
+    vector<pair<size_t, size_t>> input;
+    back_insert_iterator<vector<pair<size_t, size_t>>> backInserter(input);
+    generate_list_graph(backInserter, n);
+    Graph g(input.begin(), input.end(), n);
+
+    auto edgeType = graph::get(edge_type_t(), g);
+    for (auto v : graphUtil::Range(vertices(g))) {
+        for (auto e : graphUtil::Range(out_edges(v, g))) {
+            graph::put(edgeType, e, static_cast<char>(target(e, g) % 7));
+        }
+    }
+    for (auto v : graphUtil::Range(vertices(g))) {
+        for (auto e : graphUtil::Range(in_edges(v, g))) {
+            EXPECT_EQ(v, target(e, g));
+            EXPECT_EQ(v % 7, graph::get(edgeType, e));
+            EXPECT_EQ(e, edge(source(e, g), v, g).first);
+        }
+    }
+};
+
 //TEST(PropertyGraph, VertexIndexProperty) {
 //    using Graph = BFSGraph;
 //    using Vertex = typename graph_traits<Graph>::vertex_descriptor;
@@ -145,6 +227,462 @@ TEST(GraphStructure, ListGraph) {
     EXPECT_EQ(n, num_edges(graph));    
 };
 
+struct predecessor_t {};
+struct predecessorB_t {};
+struct distanceB_t {};
+struct colorB_t {};
+struct weight_t {};
+
+TEST(GraphStructure, CompressedGraphMatchesStaticGraph) {
+    using Graph = GenerateBiDijkstraGraph<predecessor_t, predecessorB_t, distance_t, distanceB_t,
+        weight_t, vertex_index_t, color_t, colorB_t, Properties<>, Properties<>>::type;
+    using CompressedGraph = CompressedStaticGraph<Graph::vertex_bundled, Graph::edge_bundled, Graph::layout_category>;
+    using EdgeProperties = Graph::edge_bundled;
+
+    const size_t n = 2000;
+    const size_t m = 10000;
+    mt19937 generator(5);
+    uniform_int_distribution<size_t> vertexDistribution(0, n - 1);
+    uniform_int_distribution<uint32_t> weightDistribution(1, 1000);
+    Graph::Builder builder(n, m);
+    Graph::Builder compressedBuilder(n, m);
+    for (size_t i = 0; i < m; ++i) {
+        EdgeProperties properties;
+        graph::get<weight_t>(properties) = weightDistribution(generator);
+        // far targets take several varint bytes
+        auto from = vertexDistribution(generator);
+        auto to = i % 2 ? vertexDistribution(generator) : (from + 1) % n;
+        builder.AddEdge(from, to, properties);
+        compressedBuilder.AddEdge(from, to, properties);
+    }
+    builder.Reorder(VertexOrder::BreadthFirst);
+    compressedBuilder.Reorder(VertexOrder::BreadthFirst);
+    auto g = builder.Build();
+    CompressedGraph compressed(*g);
+    // encoded from the builder edges without the StaticGraph
+    CompressedGraph fromBuilder(std::move(compressedBuilder));
+    auto fromBuilderWeight = graph::get(weight_t(), fromBuilder);
+
+    EXPECT_EQ(num_vertices(*g), num_vertices(compressed));
+    EXPECT_EQ(num_edges(*g), num_edges(compressed));
+    auto weight = graph::get(weight_t(), *g);
+    auto compressedWeight = graph::get(weight_t(), compressed);
+    for (auto v : graphUtil::Range(vertices(*g))) {
+        EXPECT_EQ(out_degree(v, *g), out_degree(v, compressed));
+        EXPECT_EQ(in_degree(v, *g), in_degree(v, compressed));
+        auto out = graphUtil::Range(adjacent_vertices(v, *g));
+        auto compressedOut = graphUtil::Range(adjacent_vertices(v, compressed));
+        EXPECT_TRUE(std::equal(out.begin(), out.end(), compressedOut.begin(), compressedOut.end()));
+        auto in = graphUtil::Range(in_adjacent_vertices(v, *g));
+        auto compressedIn = graphUtil::Range(in_adjacent_vertices(v, compressed));
+        EXPECT_TRUE(std::equal(in.begin(), in.end(), compressedIn.begin(), compressedIn.end()));
+
+        vector<uint32_t> weights, compressedWeights;
+        for (auto e : graphUtil::Range(out_edges(v, *g))) weights.push_back(graph::get(weight, e));
+        for (auto e : graphUtil::Range(out_edges(v, compressed))) {
+            EXPECT_EQ(v, source(e, compressed));
+            compressedWeights.push_back(graph::get(compressedWeight, e));
+        }
+        EXPECT_EQ(weights, compressedWeights);
+        // an in link refers to the same edge as the out link
+        for (auto e : graphUtil::Range(in_edges(v, compressed))) {
+            EXPECT_EQ(v, target(e, compressed));
+            EXPECT_TRUE(graphUtil::ValuesRange(out_edges(source(e, compressed), compressed)).contains(e));
+        }
+
+        EXPECT_EQ(g->Permutation().ToExternal(v), fromBuilder.Permutation().ToExternal(v));
+        auto outEdges = graphUtil::Range(out_edges(v, compressed));
+        auto builderOutEdges = graphUtil::Range(out_edges(v, fromBuilder));
+        ASSERT_TRUE(std::equal(outEdges.begin(), outEdges.end(), builderOutEdges.begin(), builderOutEdges.end()));
+        for (auto e : builderOutEdges)
+            EXPECT_EQ(graph::get(compressedWeight, e), graph::get(fromBuilderWeight, e));
+        auto inEdges = graphUtil::Range(in_edges(v, compressed));
+        auto builderInEdges = graphUtil::Range(in_edges(v, fromBuilder));
+        EXPECT_TRUE(std::equal(inEdges.begin(), inEdges.end(), builderInEdges.begin(), builderInEdges.end()));
+        auto builderOut = graphUtil::Range(adjacent_vertices(v, fromBuilder));
+        EXPECT_TRUE(std::equal(out.begin(), out.end(), builderOut.begin(), builderOut.end()));
+        auto builderIn = graphUtil::Range(in_adjacent_vertices(v, fromBuilder));
+        EXPECT_TRUE(std::equal(in.begin(), in.end(), builderIn.begin(), builderIn.end()));
+    }
+    EXPECT_EQ(compressed.AdjacencyBytes(), fromBuilder.AdjacencyBytes());
+    EXPECT_LT(compressed.AdjacencyBytes(), 2 * 8 * num_edges(*g));
+};
+
+TEST(GraphStructure, CompressedGraphShortestPaths) {
+    using Graph = GenerateBiDijkstraGraph<predecessor_t, predecessorB_t, distance_t, distanceB_t,
+        weight_t, vertex_index_t, color_t, colorB_t, Properties<>, Properties<>>::type;
+    using CompressedGraph = CompressedStaticGraph<Graph::vertex_bundled, Graph::edge_bundled, Graph::layout_category>;
+
+    const size_t n = 500;
+    vector<pair<pair<size_t, size_t>, Properties<Property<weight_t, uint32_t>>>> input;
+    mt19937 generator(17);
+    uniform_int_distribution<size_t> vertexDistribution(0, n - 1);
+    for (size_t i = 0; i < 4 * n; ++i) {
+        input.push_back(make_pair(make_pair(vertexDistribution(generator), vertexDistribution(generator)),
+            graph::make_properties(Property<weight_t, uint32_t>(1 + i % 13))));
+    }
+    Graph g(input.begin(), input.end(), n, input.size());
+    CompressedGraph compressed(input.begin(), input.end(), n, input.size());
+
+    auto predecessor = graph::get(predecessor_t(), g);
+    auto distance = graph::get(distance_t(), g);
+    auto weight = graph::get(weight_t(), g);
+    auto index = graph::get(vertex_index_t(), g);
+    auto color = graph::get(color_t(), g);
+    auto predecessorF = graph::get(predecessor_t(), compressed);
+    auto predecessorB = graph::get(predecessorB_t(), compressed);
+    auto distanceF = graph::get(distance_t(), compressed);
+    auto distanceB = graph::get(distanceB_t(), compressed);
+    auto compressedWeight = graph::get(weight_t(), compressed);
+    auto compressedIndex = graph::get(vertex_index_t(), compressed);
+    auto colorF = graph::get(color_t(), compressed);
+    auto colorB = graph::get(colorB_t(), compressed);
+    DefaultDijkstraVisitor<Graph> visitor;
+    DefaultDijkstraVisitor<CompressedGraph> visitorF, visitorB;
+    for (Graph::vertex_descriptor s : {0, 7, 99}) {
+        dijkstra(g, s, predecessor, distance, weight, index, color, visitor);
+        dijkstra(compressed, s, predecessorF, distanceF, compressedWeight, compressedIndex, colorF, visitorF);
+        vector<uint32_t> expected(n);
+        for (auto v : graphUtil::Range(vertices(g))) {
+            EnsureVertexInitialization(g, v, predecessor, distance, index, color, visitor);
+            EnsureVertexInitialization(compressed, v, predecessorF, distanceF, compressedIndex, colorF, visitorF);
+            EXPECT_EQ(graph::get(distance, v), graph::get(distanceF, v));
+            expected[v] = graph::get(distance, v);
+        }
+
+        // the backward search runs on ComplementGraph over the compressed in links
+        for (Graph::vertex_descriptor t : {1, 250, 499}) {
+            if (expected[t] == numeric_limits<uint32_t>::max()) continue;
+            bidirectional_dijkstra(compressed, s, t, predecessorF, predecessorB, distanceF, distanceB,
+                compressedWeight, compressedIndex, colorF, colorB, visitorF, visitorB);
+            EXPECT_EQ(expected[t], graph::get(distanceF, t));
+        }
+    }
+
+    using BFSGraph = CompressedStaticGraph<BFSBundledVertexProperties, BFSBundledEdgeProperties>;
+    vector<pair<size_t, size_t>> listInput;
+    back_insert_iterator<vector<pair<size_t, size_t>>> backInserter(listInput);
+    generate_list_graph(backInserter, n);
+    BFSGraph listGraph(listInput.begin(), listInput.end(), n);
+    auto listColor = graph::get(color_t(), listGraph);
+    for (auto v : graphUtil::Range(vertices(listGraph))) graph::put(listColor, v, 0);
+    breadth_first_search(listGraph, graph_traits<BFSGraph>::vertex_descriptor(0), listColor,
+        DefaultBFSVisitor<BFSGraph, property_map<BFSGraph, color_t>::type>(listColor));
+    EXPECT_EQ(2, graph::get(listColor, 0));
+};
+
+// A random graph of the Dijkstra tests: edgesCount edges between random vertices weighted by weightOf(i, generator),
+// the last unreachableTail vertices have no edges and are not reachable
+template <typename Graph, typename WeightOf>
+std::unique_ptr<Graph> RandomDijkstraGraph(size_t n, size_t edgesCount, uint32_t seed, WeightOf weightOf,
+    size_t unreachableTail = 0) {
+    util::WeightedEdges<weight_t> input;
+    mt19937 generator(seed);
+    util::AddRandomEdges(input, n - unreachableTail, edgesCount, generator, weightOf);
+    return std::make_unique<Graph>(input.begin(), input.end(), n, input.size());
+}
+
+TEST(QueryContext, ConcurrentQueriesOnSharedGraph) {
+    using Graph = GenerateDijkstraGraph<predecessor_t, distance_t, weight_t,
+        vertex_index_t, color_t, Properties<>, Properties<>>::type;
+
+    const size_t n = 1000;
+    auto graph = RandomDijkstraGraph<Graph>(n, 5 * n, 29,
+        [](size_t i, mt19937&) { return 1 + i % 17; });
+    auto& g = *graph;
+    auto predecessor = graph::get(predecessor_t(), g);
+    auto distance = graph::get(distance_t(), g);
+    auto weight = graph::get(weight_t(), g);
+    auto index = graph::get(vertex_index_t(), g);
+    auto color = graph::get(color_t(), g);
+
+    // distances of the searches writing into the graph
+    const size_t queriesCount = 64;
+    vector<vector<uint32_t>> expected(queriesCount, vector<uint32_t>(n));
+    DefaultDijkstraVisitor<Graph> visitor;
+    for (size_t s = 0; s < queriesCount; ++s) {
+        dijkstra(g, s, predecessor, distance, weight, index, color, visitor);
+        for (auto v : graphUtil::Range(vertices(g))) {
+            EnsureVertexInitialization(g, v, predecessor, distance, index, color, visitor);
+            expected[s][v] = graph::get(distance, v);
+        }
+    }
+
+    const Graph& sharedGraph = g;
+    const size_t threadsCount = 4;
+    vector<size_t> mismatches(threadsCount, 0);
+    vector<thread> threads;
+    for (size_t thread = 0; thread < threadsCount; ++thread) {
+        threads.emplace_back([&, thread]() {
+            QueryContext<Graph> context(sharedGraph);
+            QueryContext<Graph> backward(sharedGraph);
+            for (size_t s = thread; s < queriesCount; s += threadsCount) {
+                dijkstra(sharedGraph, s, weight, index, context);
+                for (auto v : graphUtil::Range(vertices(sharedGraph))) {
+                    auto found = context.IsReached(v) ? graph::get(context.Distance(), v) : numeric_limits<uint32_t>::max();
+                    if (found != expected[s][v]) ++mismatches[thread];
+                }
+                for (size_t t = 0; t < n; t += 97) {
+                    if (t == s || expected[s][t] == numeric_limits<uint32_t>::max()) continue;
+                    bidirectional_dijkstra(sharedGraph, s, t, weight, index, context, backward);
+                    if (graph::get(context.Distance(), t) != expected[s][t]) ++mismatches[thread];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    EXPECT_EQ(vector<size_t>(threadsCount, 0), mismatches);
+};
+
+TEST(BatchQueryExecutor, MatchesSequentialQueries) {
+    using Graph = GenerateDijkstraGraph<predecessor_t, distance_t, weight_t,
+        vertex_index_t, color_t, Properties<>, Properties<>>::type;
+    using Vertex = Graph::vertex_descriptor;
+
+    const size_t n = 800;
+    auto graph = RandomDijkstraGraph<Graph>(n, 4 * n, 31,
+        [](size_t i, mt19937&) { return 1 + i % 23; }, 10);
+    auto& g = *graph;
+    auto predecessor = graph::get(predecessor_t(), g);
+    auto distance = graph::get(distance_t(), g);
+    auto weight = graph::get(weight_t(), g);
+    auto index = graph::get(vertex_index_t(), g);
+    auto color = graph::get(color_t(), g);
+
+    mt19937 generator(31);
+    uniform_int_distribution<Vertex> queryDistribution(0, n - 1);
+    vector<pair<Vertex, Vertex>> queries = {make_pair(5, 5), make_pair(3, n - 1)};
+    for (size_t i = 0; i < 200; ++i) {
+        queries.push_back(make_pair(queryDistribution(generator), queryDistribution(generator)));
+    }
+    vector<uint32_t> expected;
+    DefaultDijkstraVisitor<Graph> visitor;
+    for (auto& query : queries) {
+        dijkstra(g, query.first, predecessor, distance, weight, index, color, visitor);
+        EnsureVertexInitialization(g, query.second, predecessor, distance, index, color, visitor);
+        expected.push_back(graph::get(distance, query.second));
+    }
+
+    // a path must lead from s to t over edges of the weights summing up to the distance
+    auto checkPaths = [&](const BatchQueryResult<Vertex, uint32_t>& result) {
+        ASSERT_EQ(queries.size(), result.Paths.size());
+        for (size_t i = 0; i < queries.size(); ++i) {
+            auto& path = result.Paths[i];
+            if (expected[i] == numeric_limits<uint32_t>::max()) {
+                EXPECT_TRUE(path.empty());
+                continue;
+            }
+            ASSERT_FALSE(path.empty());
+            EXPECT_EQ(queries[i].first, path.front());
+            EXPECT_EQ(queries[i].second, path.back());
+            uint32_t length = 0;
+            for (size_t j = 0; j + 1 < path.size(); ++j) {
+                uint32_t edgeWeight = numeric_limits<uint32_t>::max();
+                for (auto e : graphUtil::Range(out_edges(path[j], g))) {
+                    if (target(e, g) == path[j + 1]) edgeWeight = min(edgeWeight, graph::get(weight, e));
+                }
+                ASSERT_NE(numeric_limits<uint32_t>::max(), edgeWeight);
+                length += edgeWeight;
+            }
+            EXPECT_EQ(expected[i], length);
+        }
+    };
+
+    const Graph& sharedGraph = g;
+    using DijkstraEngine = DijkstraQueryEngine<Graph, decltype(weight), decltype(index)>;
+    using BidirectionalEngine = BidirectionalDijkstraQueryEngine<Graph, decltype(weight), decltype(index)>;
+    BatchQueryExecutor<DijkstraEngine> dijkstraExecutor(DijkstraEngine(sharedGraph, weight, index), 3);
+    BatchQueryExecutor<BidirectionalEngine> bidirectionalExecutor(BidirectionalEngine(sharedGraph, weight, index), 3);
+    EXPECT_EQ(3u, dijkstraExecutor.ThreadsCount());
+    // the second batch reuses the workers and their contexts
+    for (bool withPaths : {true, false}) {
+        auto result = dijkstraExecutor.Run(queries, withPaths);
+        EXPECT_EQ(expected, result.Distances);
+        EXPECT_EQ(queries.size(), result.Latencies.size());
+        EXPECT_GT(result.Throughput(), 0);
+        if (withPaths) checkPaths(result);
+
+        result = bidirectionalExecutor.Run(queries, withPaths);
+        EXPECT_EQ(expected, result.Distances);
+        if (withPaths) checkPaths(result);
+    }
+};
+
+TEST(DeltaStepping, MatchesDijkstra) {
+    using Graph = GenerateDijkstraGraph<predecessor_t, distance_t, weight_t,
+        vertex_index_t, color_t, Properties<>, Properties<>>::type;
+    using Vertex = Graph::vertex_descriptor;
+
+    const size_t n = 2000;
+    uniform_int_distribution<uint32_t> weightDistribution(0, 300);
+    auto graph = RandomDijkstraGraph<Graph>(n, 4 * n, 37,
+        [&](size_t, mt19937& generator) { return weightDistribution(generator); }, 10);
+    auto& g = *graph;
+    auto predecessor = graph::get(predecessor_t(), g);
+    auto distance = graph::get(distance_t(), g);
+    auto weight = graph::get(weight_t(), g);
+    auto index = graph::get(vertex_index_t(), g);
+    auto color = graph::get(color_t(), g);
+    const Graph& sharedGraph = g;
+
+    vector<Vertex> parallelPredecessors(n);
+    vector<uint32_t> parallelDistances(n);
+    VertexArrayPropertyMap<Vertex, decltype(index)> parallelPredecessor(parallelPredecessors.data(), index);
+    VertexArrayPropertyMap<uint32_t, decltype(index)> parallelDistance(parallelDistances.data(), index);
+    DefaultDijkstraVisitor<Graph> visitor;
+    // a small delta puts most edges into the heavy arrays, a large one all of them into the light ones
+    for (uint32_t delta : {0u, 1u, 40u, 1000u}) {
+        DeltaStepping<Graph, decltype(weight), decltype(index)> engine(sharedGraph, weight, index, delta, 4);
+        EXPECT_EQ(4u, engine.ThreadsCount());
+        for (Vertex s : {0, 17, 1234}) {
+            dijkstra(g, s, predecessor, distance, weight, index, color, visitor);
+            engine.Run(s, parallelPredecessor, parallelDistance);
+            for (auto v : graphUtil::Range(vertices(g))) {
+                EnsureVertexInitialization(g, v, predecessor, distance, index, color, visitor);
+                ASSERT_EQ(graph::get(distance, v), parallelDistances[v]) << "delta " << delta << " from " << s;
+                // ties may pick another predecessor, but it must lie on a shortest path
+                auto p = parallelPredecessors[v];
+                if (v == s || parallelDistances[v] == numeric_limits<uint32_t>::max()) {
+                    EXPECT_EQ(v, p);
+                    continue;
+                }
+                uint32_t edgeWeight = numeric_limits<uint32_t>::max();
+                for (auto e : graphUtil::Range(out_edges(p, g))) {
+                    if (target(e, g) == v) edgeWeight = min(edgeWeight, graph::get(weight, e));
+                }
+                EXPECT_EQ(parallelDistances[v], parallelDistances[p] + edgeWeight);
+            }
+        }
+    }
+
+    // the function form writes into the property maps of the graph
+    delta_stepping(sharedGraph, Vertex(17), predecessor, distance, weight, index);
+    dijkstra(g, Vertex(17), parallelPredecessor, parallelDistance, weight, index, color, visitor);
+    for (auto v : graphUtil::Range(vertices(g))) {
+        EnsureVertexInitialization(g, v, parallelPredecessor, parallelDistance, index, color, visitor);
+        EXPECT_EQ(parallelDistances[v], graph::get(distance, v));
+    }
+};
+
+TEST(MultiSourceDijkstra, MatchesDijkstraPerSource) {
+    using Graph = GenerateDijkstraGraph<predecessor_t, distance_t, weight_t,
+        vertex_index_t, color_t, Properties<>, Properties<>>::type;
+    using Vertex = Graph::vertex_descriptor;
+
+    const size_t n = 1500;
+    auto graph = RandomDijkstraGraph<Graph>(n, 4 * n, 41,
+        [](size_t i, mt19937&) { return 1 + i % 29; }, 10);
+    auto& g = *graph;
+    auto predecessor = graph::get(predecessor_t(), g);
+    auto distance = graph::get(distance_t(), g);
+    auto weight = graph::get(weight_t(), g);
+    auto index = graph::get(vertex_index_t(), g);
+    auto color = graph::get(color_t(), g);
+    const Graph& sharedGraph = g;
+
+    auto check = [&](auto& search, const vector<Vertex>& sources) {
+        search.Run(sources);
+        DefaultDijkstraVisitor<Graph> visitor;
+        for (size_t lane = 0; lane < sources.size(); ++lane) {
+            dijkstra(g, sources[lane], predecessor, distance, weight, index, color, visitor);
+            for (auto v : graphUtil::Range(vertices(g))) {
+                EnsureVertexInitialization(g, v, predecessor, distance, index, color, visitor);
+                ASSERT_EQ(graph::get(distance, v), search.GetDistance(v, lane)) << "lane " << lane;
+            }
+        }
+        // every reached vertex but the source has exactly one tree edge in its lane
+        vector<vector<size_t>> treeEdges(sources.size(), vector<size_t>(n, 0));
+        search.ForEachTreeEdge([&](const Graph::edge_descriptor& edge, uint32_t mask) {
+            for (size_t lane = 0; lane < sources.size(); ++lane) {
+                if (!(mask & (1u << lane))) continue;
+                auto to = target(edge, g);
+                ++treeEdges[lane][to];
+                EXPECT_EQ(source(edge, g), search.GetPredecessor(to, lane));
+                EXPECT_EQ(search.GetDistance(to, lane), search.GetDistance(source(edge, g), lane) + graph::get(weight, edge));
+            }
+        });
+        for (size_t lane = 0; lane < sources.size(); ++lane) {
+            for (auto v : graphUtil::Range(vertices(g))) {
+                bool inTree = v != sources[lane] && search.GetDistance(v, lane) != numeric_limits<uint32_t>::max();
+                EXPECT_EQ(inTree ? 1u : 0u, treeEdges[lane][v]);
+            }
+        }
+    };
+
+    MultiSourceDijkstra<Graph, decltype(weight), decltype(index), 8> search8(sharedGraph, weight, index);
+    check(search8, {0, 1, 2, 3, 500, 1000, 1499, 700});
+    // fewer sources than lanes and a source repeated
+    check(search8, {17, 17, 42});
+    MultiSourceDijkstra<Graph, decltype(weight), decltype(index), 16> search16(sharedGraph, weight, index);
+    vector<Vertex> sources;
+    for (Vertex s = 0; s < 16; ++s) sources.push_back(s * 91);
+    check(search16, sources);
+};
+
+// Leaves out the edges into the odd vertices
+template <typename Graph>
+struct EvenTargetsDijkstraVisitor : public DefaultDijkstraVisitor<Graph> {
+    bool should_relax(const typename graph_traits<Graph>::edge_descriptor& e, const Graph& g) {
+        return target(e, g) % 2 == 0;
+    }
+};
+
+TEST(SearchCounters, CountTheSearchSpace) {
+    using Graph = GenerateDijkstraGraph<predecessor_t, distance_t, weight_t,
+        vertex_index_t, color_t, Properties<>, Properties<>>::type;
+    using Vertex = Graph::vertex_descriptor;
+
+    const size_t n = 1000;
+    uniform_int_distribution<uint32_t> weightDistribution(1, 100);
+    auto graph = RandomDijkstraGraph<Graph>(n, 5 * n, 41,
+        [&](size_t, mt19937& generator) { return weightDistribution(generator); });
+    auto& g = *graph;
+    auto predecessor = graph::get(predecessor_t(), g);
+    auto distance = graph::get(distance_t(), g);
+    auto weight = graph::get(weight_t(), g);
+    auto index = graph::get(vertex_index_t(), g);
+    auto color = graph::get(color_t(), g);
+
+    CountingDijkstraVisitor<Graph, EvenTargetsDijkstraVisitor<Graph>> visitor;
+    CountingDijkstraVisitor<Graph, EvenTargetsDijkstraVisitor<Graph>, NoSearchCounters> silentVisitor;
+    for (Vertex s : {0, 2, 500}) {
+        visitor.GetCounters().Reset();
+        dijkstra(g, s, predecessor, distance, weight, index, color, visitor);
+        SearchCounters expected;
+        vector<uint32_t> distances(n, numeric_limits<uint32_t>::max());
+        for (auto v : graphUtil::Range(vertices(g))) {
+            EnsureVertexInitialization(g, v, predecessor, distance, index, color, visitor);
+            distances[v] = graph::get(distance, v);
+            if (distances[v] == numeric_limits<uint32_t>::max())
+                continue;
+            ++expected.SettledVertices;
+            ++expected.QueueInserts;
+            for (auto e : graphUtil::Range(out_edges(v, g))) {
+                if (target(e, g) % 2 == 0)
+                    ++expected.RelaxedEdges;
+                else
+                    ++expected.PrunedEdges;
+            }
+        }
+        const auto& counters = visitor.GetCounters();
+        EXPECT_EQ(expected.SettledVertices, counters.SettledVertices);
+        EXPECT_EQ(expected.QueueInserts, counters.QueueInserts);
+        EXPECT_EQ(expected.RelaxedEdges, counters.RelaxedEdges);
+        EXPECT_EQ(expected.PrunedEdges, counters.PrunedEdges);
+        EXPECT_LE(counters.DecreaseKeys + counters.QueueInserts, counters.RelaxedEdges + 1);
+
+        // the disabled counters change nothing in the search
+        dijkstra(g, s, predecessor, distance, weight, index, color, silentVisitor);
+        for (auto v : graphUtil::Range(vertices(g))) {
+            EnsureVertexInitialization(g, v, predecessor, distance, index, color, silentVisitor);
+            EXPECT_EQ(distances[v], graph::get(distance, v));
+        }
+    }
+    static_assert(sizeof(silentVisitor) == sizeof(EvenTargetsDijkstraVisitor<Graph>),
+        "disabled counters must not grow the visitor");
+    static_assert(decltype(silentVisitor.GetCounters())::SettledVertices == 0, "disabled counters count nothing");
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+#include <graph/properties.hpp>
+
+namespace util {
+
+// Weighted edges of the tests in the input format of the StaticGraph constructors
+template <typename WeightTag>
+using WeightedEdges = std::vector<std::pair<std::pair<size_t, size_t>,
+    graph::Properties<graph::Property<WeightTag, uint32_t>>>>;
+
+// Appends edgesCount edges between uniform random vertices of [0, verticesCount),
+// weightOf(i, generator) is the weight of the i-th of them
+template <typename WeightTag, typename WeightOf>
+void AddRandomEdges(WeightedEdges<WeightTag>& edges, size_t verticesCount, size_t edgesCount,
+    std::mt19937& generator, WeightOf weightOf) {
+    std::uniform_int_distribution<size_t> vertexDistribution(0, verticesCount - 1);
+    for (size_t i = 0; i < edgesCount; ++i) {
+        auto from = vertexDistribution(generator);
+        auto to = vertexDistribution(generator);
+        edges.push_back(std::make_pair(std::make_pair(from, to),
+            graph::make_properties(graph::Property<WeightTag, uint32_t>(weightOf(i, generator)))));
+    }
+}
+
+// Appends a ring over [0, verticesCount) in both directions, it keeps these vertices strongly connected
+template <typename WeightTag, typename WeightOf>
+void AddRing(WeightedEdges<WeightTag>& edges, size_t verticesCount, std::mt19937& generator, WeightOf weightOf) {
+    for (size_t v = 0; v < verticesCount; ++v) {
+        auto next = (v + 1) % verticesCount;
+        edges.push_back(std::make_pair(std::make_pair(v, next),
+            graph::make_properties(graph::Property<WeightTag, uint32_t>(weightOf(2 * v, generator)))));
+        edges.push_back(std::make_pair(std::make_pair(next, v),
+            graph::make_properties(graph::Property<WeightTag, uint32_t>(weightOf(2 * v + 1, generator)))));
+    }
+}
+
+}; //util
@@ -1,6 +1,9 @@
 #pragma once
 #include <string>
 #include <ostream>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
 
 namespace util{
 namespace statistics {
@@ -56,7 +59,9 @@ enum class Algorithm: char {
     dijkstraPtoP,
     biDijkstra,
     arcFlags,
-    CH
+    CH,
+    deltaStepping,
+    ALT
 };
 
 
@@ -80,6 +85,12 @@ std::ostream& operator<<(std::ostream& osm, const Algorithm& arg) {
     case Algorithm::CH:
         osm << "CH";
         break;
+    case Algorithm::deltaStepping:
+        osm << "deltaStepping";
+        break;
+    case Algorithm::ALT:
+        osm << "ALT";
+        break;
 
     default:
         osm << "Unknown algorithm";
@@ -172,5 +183,142 @@ std::ostream& operator<<(std::ostream& osm, const GeneralStatistics& arg) {
 return osm;
 };
 
+enum class BatchKeys : char {
+    threads,
+    queries,
+    throughput,
+    latency_mean,
+    latency_p50,
+    latency_p99,
+    latency_max
+};
+
+inline std::ostream& operator<<(std::ostream& osm, const BatchKeys& arg) {
+    switch (arg) {
+    case BatchKeys::threads:
+        osm << "threads";
+        break;
+    case BatchKeys::queries:
+        osm << "queries";
+        break;
+    case BatchKeys::throughput:
+        osm << "queries_per_s";
+        break;
+    case BatchKeys::latency_mean:
+        osm << "latency_mean_ns";
+        break;
+    case BatchKeys::latency_p50:
+        osm << "latency_p50_ns";
+        break;
+    case BatchKeys::latency_p99:
+        osm << "latency_p99_ns";
+        break;
+    case BatchKeys::latency_max:
+        osm << "latency_max_ns";
+        break;
+    default:
+        osm << "Unknown column";
+        break;
+    };
+    return osm;
+};
+
+// A batch of queries run on several threads: the aggregate throughput and the distribution
+// of the latencies of the single queries, nanoseconds
+struct BatchQueryStatistics : GeneralStatistics {
+    BatchQueryStatistics(const GeneralStatistics& base, size_t threads, double throughput,
+        std::vector<uint64_t> latencies)
+        :GeneralStatistics(base), threads(BatchKeys::threads, threads),
+        queries(BatchKeys::queries, latencies.size()),
+        throughput(BatchKeys::throughput, throughput),
+        latencyMean(BatchKeys::latency_mean, 0), latencyP50(BatchKeys::latency_p50, 0),
+        latencyP99(BatchKeys::latency_p99, 0), latencyMax(BatchKeys::latency_max, 0) {
+        if (latencies.empty())
+            return;
+        std::sort(latencies.begin(), latencies.end());
+        uint64_t sum = 0;
+        for (auto latency : latencies)
+            sum += latency;
+        latencyMean.value = sum / latencies.size();
+        latencyP50.value = latencies[(latencies.size() - 1) / 2];
+        latencyP99.value = latencies[(latencies.size() - 1) * 99 / 100];
+        latencyMax.value = latencies.back();
+    };
+    StatisticsField<BatchKeys, size_t> threads;
+    StatisticsField<BatchKeys, size_t> queries;
+    StatisticsField<BatchKeys, double> throughput;
+    StatisticsField<BatchKeys, uint64_t> latencyMean;
+    StatisticsField<BatchKeys, uint64_t> latencyP50;
+    StatisticsField<BatchKeys, uint64_t> latencyP99;
+    StatisticsField<BatchKeys, uint64_t> latencyMax;
+};
+
+inline std::ostream& operator<<(std::ostream& osm, const BatchQueryStatistics& arg) {
+    osm << static_cast<GeneralStatistics>(arg) << '\t' << arg.threads << '\t' << arg.queries << '\t' <<
+        arg.throughput << '\t' << arg.latencyMean << '\t' << arg.latencyP50 << '\t' <<
+        arg.latencyP99 << '\t' << arg.latencyMax;
+    return osm;
+};
+
+enum class SearchSpaceKeys : char {
+    settled,
+    relaxed,
+    inserts,
+    decrease_keys,
+    pruned
+};
+
+inline std::ostream& operator<<(std::ostream& osm, const SearchSpaceKeys& arg) {
+    switch (arg) {
+    case SearchSpaceKeys::settled:
+        osm << "settled";
+        break;
+    case SearchSpaceKeys::relaxed:
+        osm << "relaxed";
+        break;
+    case SearchSpaceKeys::inserts:
+        osm << "inserts";
+        break;
+    case SearchSpaceKeys::decrease_keys:
+        osm << "decrease_keys";
+        break;
+    case SearchSpaceKeys::pruned:
+        osm << "pruned";
+        break;
+    default:
+        osm << "Unknown column";
+        break;
+    };
+    return osm;
+};
+
+// The search space of a query next to its time: any statistics row followed by the counters
+// of the search, e.g. of graph::CountingDijkstraVisitor. The space column of the row is set to
+// the settled vertices, it stays 0 in the rows without counters
+template <typename Base = GeneralStatistics>
+struct SearchSpaceStatistics : Base {
+    template <typename Counters>
+    SearchSpaceStatistics(const Base& base, const Counters& counters)
+        :Base(base), settled(SearchSpaceKeys::settled, counters.SettledVertices),
+        relaxed(SearchSpaceKeys::relaxed, counters.RelaxedEdges),
+        inserts(SearchSpaceKeys::inserts, counters.QueueInserts),
+        decreaseKeys(SearchSpaceKeys::decrease_keys, counters.DecreaseKeys),
+        pruned(SearchSpaceKeys::pruned, counters.PrunedEdges) {
+        this->space.value = counters.SettledVertices;
+    };
+    StatisticsField<SearchSpaceKeys, uint64_t> settled;
+    StatisticsField<SearchSpaceKeys, uint64_t> relaxed;
+    StatisticsField<SearchSpaceKeys, uint64_t> inserts;
+    StatisticsField<SearchSpaceKeys, uint64_t> decreaseKeys;
+    StatisticsField<SearchSpaceKeys, uint64_t> pruned;
+};
+
+template <typename Base>
+std::ostream& operator<<(std::ostream& osm, const SearchSpaceStatistics<Base>& arg) {
+    osm << static_cast<const Base&>(arg) << '\t' << arg.settled << '\t' << arg.relaxed << '\t' <<
+        arg.inserts << '\t' << arg.decreaseKeys << '\t' << arg.pruned;
+    return osm;
+};
+
 }; //statistics
 }; //util
\ No newline at end of file